@@ -248,6 +248,8 @@ DENG_HEADERS += \
     include/render/lumobj.h \
     include/render/materialcontext.h \
     include/render/r_draw.h \
+    include/render/r_framearena.h \
+    include/render/r_lightkernels.h \
     include/render/r_main.h \
     include/render/r_shadow.h \
     include/render/r_things.h \
@@ -278,6 +280,7 @@ DENG_HEADERS += \
     include/resource/colorpalette.h \
     include/resource/colorpalettes.h \
     include/resource/compositetexture.h \
+    include/resource/decompressedlumpcache.h \
     include/resource/font.h \
     include/resource/fonts.h \
     include/resource/hq2x.h \
@@ -358,6 +361,7 @@ DENG_HEADERS += \
     include/updater.h \
     include/uri.hh \
     include/world/blockmap.h \
+    include/world/bsp/bspcache.h \
     include/world/bsp/bsptreenode.h \
     include/world/bsp/convexsubspace.h \
     include/world/bsp/edgetip.h \
@@ -543,6 +547,8 @@ SOURCES += \
     src/render/lumobj.cpp \
     src/render/r_draw.cpp \
     src/render/r_fakeradio.cpp \
+    src/render/r_framearena.cpp \
+    src/render/r_lightkernels.cpp \
     src/render/r_main.cpp \
     src/render/r_shadow.cpp \
     src/render/r_things.cpp \
@@ -575,6 +581,7 @@ SOURCES += \
     src/resource/colorpalette.cpp \
     src/resource/colorpalettes.cpp \
     src/resource/compositetexture.cpp \
+    src/resource/decompressedlumpcache.cpp \
     src/resource/fonts.cpp \
     src/resource/hq2x.cpp \
     src/resource/image.cpp \
@@ -658,6 +665,7 @@ SOURCES += \
     src/world/api_map.cpp \
     src/world/api_mapedit.cpp \
     src/world/blockmap.cpp \
+    src/world/bsp/bspcache.cpp \
     src/world/bsp/convexsubspace.cpp \
     src/world/bsp/hplane.cpp \
     src/world/bsp/linesegment.cpp \
@@ -33,6 +33,19 @@
 extern "C" {
 #endif
 
+/**
+ * Sample cache statistics (see Sfx_GetCacheInfo()).
+ */
+typedef struct sfxcacheinfo_s {
+    uint bytes;         ///< Size of the cached sample data.
+    uint samples;       ///< Number of cached samples.
+    uint hits;          ///< Sfx_Cache() requests found in the cache.
+    uint misses;        ///< Sfx_Cache() requests that had to load the sample.
+    uint precached;     ///< Samples cached by Sfx_PrecacheSounds().
+    uint converted;     ///< Samples converted to the output format.
+    float resampleTime; ///< Total time spent converting samples (ms).
+} sfxcacheinfo_t;
+
 void Sfx_InitCache(void);
 
 void Sfx_ShutdownCache(void);
@@ -46,15 +59,26 @@ sfxsample_t *Sfx_Cache(int id);
 
 void Sfx_CacheHit(int id);
 
+/**
+ * Loads and converts the samples of the given sounds, unless already cached.
+ * The samples are converted in parallel. Use when loading a map, so that
+ * the first plays of the sounds don't need to be resampled.
+ *
+ * @param soundIds  Sound id numbers. Duplicates and zeros are ignored.
+ * @param count     Number of ids in @a soundIds.
+ */
+void Sfx_PrecacheSounds(int const *soundIds, int count);
+
 /**
  * @return  The length of the sound (in milliseconds).
  */
 uint Sfx_GetSoundLength(int id);
 
 /**
- * @return  Number of bytes and samples cached.
+ * Returns the size of the cache and its hit, miss and resampling statistics
+ * since Sfx_InitCache().
  */
-void Sfx_GetCacheInfo(uint *cacheBytes, uint *sampleCount);
+void Sfx_GetCacheInfo(sfxcacheinfo_t *info);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -47,6 +47,7 @@ extern int soundMinDist, soundMaxDist;
 extern int sfxVolume, musVolume;
 extern int sfxBits, sfxRate;
 extern byte sfxOneSoundPerEmitter;
+extern byte sfxPrecache;
 
 void S_Register(void);
 
@@ -37,17 +37,17 @@
 extern "C" {
 #endif
 
-// Begin and end macros for Critical Operations. They are operations
-// that can't be done while a refresh is being made. No refreshing
-// will be done between BEGIN_COP and END_COP.
-#define BEGIN_COP       Sfx_AllowRefresh(false)
-#define END_COP         Sfx_AllowRefresh(true)
-
 // Channel flags.
 #define SFXCF_NO_ORIGIN         (0x1) // Sound is coming from a mystical emitter.
 #define SFXCF_NO_ATTENUATION    (0x2) // Sound is very, very loud.
 #define SFXCF_NO_UPDATE         (0x4) // Channel update is skipped.
 
+/**
+ * The buffer of a channel is only accessed by the thread that applies the
+ * channel commands (the refresh thread, if running). The other threads use
+ * the buf* members, which describe the buffer as it will be once all the
+ * posted commands have been applied.
+ */
 typedef struct sfxchannel_s {
     int             flags;
     sfxbuffer_t*    buffer;
@@ -56,8 +56,23 @@ typedef struct sfxchannel_s {
     float           volume; // Sound volume: 1.0 is max.
     float           frequency; // Frequency adjustment: 1.0 is normal.
     int             startTime; // When was the channel last started?
+    int             bufFlags; // SFXBF_3D, SFXBF_PLAYING, SFXBF_REPEAT, SFXBF_DONT_STOP.
+    int             bufBytes; // Bytes per sample, zero if there is no buffer.
+    int             bufRate; // Samples per second.
+    sfxsample_t*    bufSample; // Loaded sample, or NULL.
+    uint            bufEndTime; // When a non-repeating sound ends (real milliseconds).
 } sfxchannel_t;
 
+/**
+ * Channel command statistics of the previous frame.
+ */
+typedef struct sfxcommandstats_s {
+    int             posted; // Number of commands posted.
+    int             applied; // Number of commands applied.
+    float           maxLatency; // Longest delay before a command was applied (ms).
+    float           avgLatency; // Average delay before a command was applied (ms).
+} sfxcommandstats_t;
+
 extern boolean sfxAvail;
 extern float sfxReverbStrength;
 extern int sfxMaxCacheKB, sfxMaxCacheTics;
@@ -66,7 +81,6 @@ extern int sfx3D, sfx16Bit, sfxSampleRate;
 boolean Sfx_Init(void);
 void Sfx_Shutdown(void);
 void Sfx_Reset(void);
-void Sfx_AllowRefresh(boolean allow);
 void Sfx_MapChange(void);
 void Sfx_SetListener(struct mobj_s *mobj);
 void Sfx_StartFrame(void);
@@ -105,6 +119,11 @@ int             Sfx_CountPlaying(int id);
 void            Sfx_UnloadSoundID(int id);
 void            Sfx_UpdateReverb(void);
 
+/**
+ * Returns the channel command statistics of the previous frame.
+ */
+void            Sfx_GetCommandStats(sfxcommandstats_t *stats);
+
 void            Sfx_DebugInfo(void);
 
 #ifdef __cplusplus
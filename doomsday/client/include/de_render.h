@@ -28,6 +28,8 @@
 #ifdef __CLIENT__
 #include "render/rend_main.h"
 #include "render/r_draw.h"
+#include "render/r_framearena.h"
+#include "render/r_lightkernels.h"
 #include "render/lightgrid.h"
 #include "render/lumobj.h"
 #include "render/r_shadow.h"
@@ -81,6 +81,20 @@ public:
      */
     size_t read(uint8_t* buffer, size_t count);
 
+    /**
+     * Provides direct read-only access to the contents of the file without
+     * copying them. A native file is memory-mapped in full the first time
+     * this is called; the data of a buffered lump is returned as-is. Safe to
+     * call from multiple threads.
+     *
+     * @param length  If not @c NULL, the number of accessible bytes (starting
+     *                at the returned address) is written here.
+     *
+     * @return  Address of the file data at the base offset. @c NULL if the file
+     * cannot be accessed directly. Remains valid until the handle is closed.
+     */
+    uint8_t const* mapData(size_t* length = 0);
+
     /**
      * Read a character from the stream, advancing the read position in the process.
      */
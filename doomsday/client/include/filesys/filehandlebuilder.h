@@ -50,6 +50,15 @@ public:
      */
     static FileHandle* fromLump(File1& lump, bool dontBuffer);
 
+    /**
+     * Create a new handle on a copy of the contents of @a file in memory.
+     *
+     * @param file  The file whose contents are in @a data.
+     * @param data  Data allocated with M_Malloc(). The handle gets ownership.
+     * @param size  Size of @a data in bytes.
+     */
+    static FileHandle* fromData(File1& file, uint8_t* data, size_t size);
+
     /**
      * Create a new handle on the specified native file.
      *
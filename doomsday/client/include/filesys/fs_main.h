@@ -277,6 +277,9 @@ public:
     /// List of file search results.
     typedef QList<FileHandle *> FileList;
 
+    /// List of files to be indexed.
+    typedef QList<File1 *> Files;
+
 public:
     /**
      * Constructs a new file system.
@@ -388,6 +391,23 @@ public:
      */
     void index(File1 &file);
 
+    /**
+     * Reads the lump directories of several files concurrently, ahead of
+     * indexing them. Errors are raised later, when each file is indexed.
+     *
+     * @param files  Files that are about to be indexed.
+     */
+    void readLumpDirectories(Files const &files);
+
+    /**
+     * Indexes several files in the order given, exactly as if index() was
+     * called for each of them. The lump directories of the files are first
+     * read concurrently (see readLumpDirectories()).
+     *
+     * @param files  Files to index. Assumed to have not yet been indexed!
+     */
+    void index(Files const &files);
+
     /**
      * Removes a file from any indexes.
      *
@@ -113,6 +113,7 @@ typedef struct gl_state_s {
         uint texCompression : 1;
         uint texFilterAniso : 1;
         uint texNonPowTwo : 1;
+        uint vertexBufferObjects : 1;
         uint vsync : 1;
     } features;
 
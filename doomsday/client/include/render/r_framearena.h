@@ -0,0 +1,76 @@
+/** @file r_framearena.h Per-frame memory arena for the renderer.
+ *
+ * @ingroup render
+ *
+ * Data that only lives for the duration of a single frame (lumobj and objlink
+ * contact nodes, clip nodes and oranges, light projections) is allocated by
+ * bumping a pointer in the frame arena. Nothing in the arena is freed
+ * individually; instead the whole arena is rewound in constant time when a
+ * new world frame begins (R_BeginWorldFrame).
+ *
+ * @authors Copyright © 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef DENG_RENDER_FRAMEARENA_H
+#define DENG_RENDER_FRAMEARENA_H
+
+#include <de/libdeng1.h>
+
+DENG_EXTERN_C byte rendInfoFrameArena;
+
+/**
+ * Register the console variables of the frame arena.
+ */
+void R_FrameArenaRegister();
+
+/**
+ * Release all memory owned by the frame arena.
+ */
+void R_ShutdownFrameArena();
+
+/**
+ * Begin a new frame: everything allocated from the arena during the previous
+ * frame is released at once. The memory itself is kept for reuse.
+ */
+void R_ResetFrameArena();
+
+/**
+ * Allocate @a size bytes of uninitialized memory from the frame arena. The
+ * memory remains valid until the next call to R_ResetFrameArena().
+ */
+void *R_FrameAlloc(size_t size);
+
+/**
+ * Allocate an object of type @a Type from the frame arena. The object is not
+ * constructed; only POD types should be allocated this way.
+ */
+template <typename Type>
+inline Type *R_FrameAllocObject() {
+    return reinterpret_cast<Type *>(R_FrameAlloc(sizeof(Type)));
+}
+
+/**
+ * Returns the number of bytes allocated from the arena during the current
+ * frame so far.
+ */
+size_t R_FrameArenaUsed();
+
+/**
+ * Returns the largest number of bytes allocated during any single frame.
+ */
+size_t R_FrameArenaPeak();
+
+#endif // DENG_RENDER_FRAMEARENA_H
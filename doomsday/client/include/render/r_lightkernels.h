@@ -0,0 +1,104 @@
+/** @file r_lightkernels.h Vertex lighting kernels.
+ *
+ * @ingroup render
+ *
+ * Batch lighting operations for the vertices of world polygons. Each kernel
+ * has a scalar implementation and vectorized SSE2 and AVX2 implementations;
+ * the best one supported by the CPU is chosen at runtime. The vectorized
+ * kernels perform exactly the same floating point operations as the scalar
+ * ones, so all implementations produce bit-identical results.
+ *
+ * @authors Copyright © 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef DENG_RENDER_LIGHTKERNELS_H
+#define DENG_RENDER_LIGHTKERNELS_H
+
+#include <de/libdeng1.h>
+
+#include "color.h"
+#include "render/rendpoly.h"
+
+/**
+ * Viewer configuration for calculating vertex distances (see Rend_PointDist2D).
+ */
+typedef struct lightkernelview_s {
+    double origin[2];   ///< Map space X and Y of the viewer.
+    double side[2];     ///< viewsidex, viewsidey
+} lightkernelview_t;
+
+/**
+ * Sector light parameters for R_LightVertices().
+ */
+typedef struct lightkernellight_s {
+    float level;        ///< Light level of the surface.
+    float ambient[3];   ///< Ambient light color.
+    float attenuation;  ///< Distance attenuation factor (rend-light-attenuation).
+    float extra;        ///< Extra light delta.
+    float const *adaptation; ///< Light adaptation ramp (lightModRange).
+} lightkernellight_t;
+
+/**
+ * Torch (fixed colormap) light parameters for R_TorchLightVertices().
+ */
+typedef struct lightkerneltorch_s {
+    float strength;     ///< Strength of the torch before attenuation.
+    float color[3];
+    bool additive;
+    bool attenuate;     ///< Attenuate with distance (up to 1024 units).
+} lightkerneltorch_t;
+
+/// Register the console variables of the lighting kernels.
+void R_LightKernelsRegister(void);
+
+/// @return  Name of the kernel implementation in use (e.g., "SSE2").
+char const *R_LightKernelName(void);
+
+/**
+ * Calculate the distances of @a verts to the viewer in the view plane.
+ */
+void R_VertexDistances(float *dists, rvertex_t const *verts, uint num,
+                       lightkernelview_t const *view);
+
+/**
+ * Light @a verts with sector light, distance attenuation, extra light and
+ * light adaptation. The RGB of @a colors is replaced; alpha is not changed.
+ *
+ * @param dists  Distances of the vertices to the viewer (R_VertexDistances).
+ */
+void R_LightVertices(ColorRawf *colors, float const *dists, uint num,
+                     lightkernellight_t const *light);
+
+/**
+ * Apply torch light to @a colors.
+ *
+ * @param dists  Distances of the vertices to the viewer (R_VertexDistances).
+ */
+void R_TorchLightVertices(ColorRawf *colors, float const *dists, uint num,
+                          lightkerneltorch_t const *torch);
+
+/// Set the RGB of all @a colors to @a value.
+void R_SetVertexColorRGB(ColorRawf *colors, uint num, float value);
+
+/// Set the alpha of all @a colors to @a alpha.
+void R_SetVertexColorAlpha(ColorRawf *colors, uint num, float alpha);
+
+/**
+ * Add @a light to the RGB of @a colors, clamping the result to at most one.
+ */
+void R_AddVertexLight(ColorRawf *colors, ColorRawf const *light, uint num);
+
+#endif // DENG_RENDER_LIGHTKERNELS_H
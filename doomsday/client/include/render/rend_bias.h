@@ -75,17 +75,28 @@ typedef struct biastracker_s {
     uint changes[MAX_BIAS_TRACKED];
 } biastracker_t;
 
+// Bias surface flags.
+#define BSF_AFFECTED_DIRTY   0x1 ///< The affecting sources must be determined again.
+
 /**
  * Stores the data pertaining to vertex lighting for a worldmap, surface.
  */
 struct BiasSurface
 {
-    uint updated;
+    int flags;
     uint size;
     vertexillum_t *illum; // [size]
     biastracker_t tracker;
     biasaffection_t affected[MAX_BIAS_AFFECTED];
 
+    /// A source must be at least this strong at the surface to get on the
+    /// affected list (the weakest affecting source when the list is full).
+    float affectThreshold;
+
+    AABoxd bounds; ///< Map space XY bounds of the surface.
+    int cell; ///< Index of the source/surface grid cell (-1= not indexed).
+    BiasSurface *nextInCell;
+
     BiasSurface *next;
 };
 
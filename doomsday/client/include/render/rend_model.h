@@ -75,6 +75,7 @@ DENG_EXTERN_C int modelLight;
 DENG_EXTERN_C int frameInter;
 DENG_EXTERN_C int mirrorHudModels;
 DENG_EXTERN_C int modelShinyMultitex;
+DENG_EXTERN_C int modelShaders;
 DENG_EXTERN_C float rendModelLOD;
 
 /**
@@ -113,6 +114,13 @@ boolean Rend_ModelExpandVertexBuffers(uint numVertices);
 
 void Rend_ModelSetFrame(modeldef_t *modef, int frame);
 
+/**
+ * Release the GL buffers used for drawing @a mdl with shaders. Must be called
+ * before the model is destroyed. The GL context may not be available, so the
+ * buffers are deleted when models are next drawn (or on shutdown).
+ */
+void Rend_ModelReleaseBuffers(model_t const &mdl);
+
 /**
  * Lookup the texture specification for diffuse model skins.
  *
@@ -0,0 +1,96 @@
+/** @file decompressedlumpcache.h Shared cache of decompressed lumps.
+ *
+ * @authors Copyright &copy; 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef LIBDENG_RESOURCE_DECOMPRESSEDLUMPCACHE_H
+#define LIBDENG_RESOURCE_DECOMPRESSEDLUMPCACHE_H
+
+#include <de/types.h>
+
+namespace de {
+
+class File1;
+
+/**
+ * Size-bounded cache of decompressed lump data, shared by all containers.
+ * Uncompressed lumps are accessed directly in the memory-mapped containers;
+ * only the lumps that have to be inflated are kept here.
+ *
+ * Entries are locked while in use (between File1::cache() and File1::unlock()).
+ * Locks are counted, so every lock() and insert() must be balanced by an
+ * unlock(). When the total size of the cached data exceeds the limit, the
+ * least recently used entries with no locks are freed. All methods are thread-safe.
+ *
+ * @ingroup fs
+ */
+class DecompressedLumpCache
+{
+public:
+    /**
+     * Looks up the cached data of a lump and locks it.
+     *
+     * @param container  Container of the lump.
+     * @param lumpIdx    Index of the lump in the container.
+     *
+     * @return  The decompressed data, or @c NULL if not cached.
+     */
+    static uint8_t const* lock(File1 const& container, int lumpIdx);
+
+    /**
+     * Adds the decompressed data of a lump to the cache, locked. If the lump is
+     * already cached, @a data is freed and the existing copy is returned.
+     *
+     * @param container  Container of the lump.
+     * @param lumpIdx    Index of the lump in the container.
+     * @param data       Data allocated with M_Malloc(). Cache gets ownership.
+     * @param size       Size of @a data in bytes.
+     *
+     * @return  The cached data.
+     */
+    static uint8_t const* insert(File1 const& container, int lumpIdx, uint8_t* data, size_t size);
+
+    /**
+     * Copies a range of the cached data of a lump, if available.
+     *
+     * @return  @c true if the lump was cached and the range was copied.
+     */
+    static bool read(File1 const& container, int lumpIdx, uint8_t* buffer,
+                     size_t startOffset, size_t length);
+
+    /**
+     * Releases one lock on the cached data of a lump. Once all locks have
+     * been released, the data may be freed when space is needed.
+     */
+    static void unlock(File1 const& container, int lumpIdx);
+
+    /**
+     * Frees the cached data of a lump.
+     *
+     * @return  @c true if the lump was cached.
+     */
+    static bool remove(File1 const& container, int lumpIdx);
+
+    /**
+     * Frees the cached data of all lumps of @a container.
+     */
+    static void removeAll(File1 const& container);
+};
+
+} // namespace de
+
+#endif /* LIBDENG_RESOURCE_DECOMPRESSEDLUMPCACHE_H */
@@ -148,6 +148,9 @@ struct ModelDef
 
     float visualRadius;
 
+    /// @c true= The skins have been prepared for drawing (see Models_Cache()).
+    bool skinsReady;
+
     ded_model_t* def;
 
     /// Points to next inter-frame, or NULL.
@@ -169,6 +172,7 @@ struct ModelDef
           interMark(0),
           resize(0),
           visualRadius(0),
+          skinsReady(false),
           def(0),
           interNext(0),
           selectNext(0)
@@ -283,6 +287,19 @@ modeldef_t* Models_Definition(char const* id);
 
 void Models_Cache(modeldef_t* modef);
 
+/**
+ * Determines whether the skins of the model have been prepared for drawing. If
+ * not, the model is queued for Models_PrepareQueuedSkins() and it should be
+ * drawn as a sprite in the meantime.
+ */
+bool Models_IsReady(modeldef_t* modef);
+
+/**
+ * Prepares the skins of queued models, a few at a time so that the frame rate
+ * is not disrupted. Called once per frame.
+ */
+void Models_PrepareQueuedSkins(void);
+
 /**
  * @note The skins are also bound here once so they should be ready for use
  *       the next time they are needed.
@@ -23,6 +23,7 @@
 
 #include "filesys/file.h"
 #include "filesys/fileinfo.h"
+#include "filesys/fs_main.h"
 #include <de/PathTree>
 
 namespace de {
@@ -46,6 +47,24 @@ public:
     /// The requested entry does not exist in the zip. @ingroup errors
     DENG2_ERROR(NotFoundError);
 
+    /**
+     * Locations of the current game that paths inside archives may be mapped
+     * to. Resolved on the main thread, so that lump directories can be read
+     * in worker threads (see readLumpDirectory()).
+     */
+    struct PathMappings
+    {
+        bool enabled;       ///< @c false= No game is loaded; paths are not mapped.
+        String dataPath;    ///< Game's Data directory, or empty if not resolved.
+        String defsPath;    ///< Game's Defs directory, or empty if not resolved.
+        FS1::Schemes schemes;
+
+        PathMappings() : enabled(false) {}
+
+        /// Resolves the mappings of the currently loaded game.
+        static PathMappings current();
+    };
+
 public:
     Zip(FileHandle &hndl, String path, FileInfo const &info,
         File1 *container = 0);
@@ -63,6 +82,17 @@ public:
     /// @return @c true= There are no lumps in this file's directory.
     bool empty();
 
+    /**
+     * Reads the lump directory and builds the lump lookup table ahead of first
+     * use. Nothing outside the archive is accessed, so this may be called in a
+     * worker thread. Warnings are logged on the next access of the directory.
+     *
+     * @param mappings  Game path mappings, resolved in the main thread.
+     *
+     * @throws FormatError  If the directory cannot be read.
+     */
+    void readLumpDirectory(PathMappings const &mappings);
+
     /**
      * Retrieve the directory node for a lump contained by this file.
      *
@@ -0,0 +1,148 @@
+/** @file bspcache.h World map BSP cache.
+ *
+ * @authors Copyright © 2013 Daniel Swanson <danij@dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#ifndef DENG_WORLD_BSP_BSPCACHE_H
+#define DENG_WORLD_BSP_BSPCACHE_H
+
+#include <QList>
+#include <QSet>
+
+#include <de/Block>
+#include <de/Error>
+#include <de/String>
+#include <de/Vector>
+
+class BspLeaf;
+class BspNode;
+class Line;
+class Sector;
+
+namespace de {
+
+class MapElement;
+class Mesh;
+
+namespace bsp {
+
+/**
+ * On-disk cache of built BSP trees.
+ *
+ * Building the BSP is by far the most expensive part of loading a map, yet the
+ * result depends only on the map geometry and the split cost factor. Once built,
+ * the tree is written to the runtime "mapcache" folder in a compact binary form,
+ * keyed by a hash of all the inputs of the partitioner. When the same geometry
+ * is loaded again the BSP elements are reconstructed from the cache instead.
+ *
+ * The cached data is fully validated before any map elements are created, so
+ * a corrupt or stale file simply results in a cache miss.
+ *
+ * @ingroup bsp
+ */
+class BspCache
+{
+public:
+    /// The cached data is invalid or does not match the map. @ingroup errors
+    DENG2_ERROR(ReadError);
+
+    typedef QList<Line *>    Lines;
+    typedef QList<Sector *>  Sectors;
+    typedef QList<BspNode *> BspNodes;
+    typedef QList<BspLeaf *> BspLeafs;
+    typedef QSet<Line *>     LineSet;
+
+    /// A sector the partitioner found to be unclosed.
+    struct UnclosedSector
+    {
+        Sector *sector;
+        Vector2d nearPoint;
+
+        UnclosedSector(Sector *sector = 0, Vector2d const &nearPoint = Vector2d())
+            : sector(sector), nearPoint(nearPoint) {}
+    };
+    typedef QList<UnclosedSector> UnclosedSectors;
+
+    /**
+     * BSP elements in map index order (as collated by the map).
+     */
+    struct Elements
+    {
+        MapElement *root;
+        BspNodes nodes;
+        BspLeafs leafs;
+        UnclosedSectors unclosedSectors; ///< In the order they were found.
+
+        Elements() : root(0) {}
+    };
+
+public:
+    /**
+     * @param mesh             Map mesh. New vertexes will be added when reading.
+     * @param lines            All map lines, in map index order.
+     * @param sectors          All map sectors, in map index order.
+     * @param linesToBuildFor  Lines for which the BSP is built.
+     * @param splitCostFactor  Split cost factor used when partitioning.
+     *
+     * @pre Vertexes, lines and sectors have been indexed, and "one-way window"
+     * lines have been found.
+     */
+    BspCache(Mesh &mesh, Lines const &lines, Sectors const &sectors,
+             LineSet const &linesToBuildFor, int splitCostFactor);
+
+    /**
+     * Returns the hash of the partitioner's inputs that identifies the BSP.
+     */
+    Block const &key() const;
+
+    /**
+     * Returns the native path of the cache file for the BSP.
+     */
+    String path() const;
+
+    /**
+     * Attempt to reconstruct the BSP from the cache. New vertexes are added to
+     * the mesh, and the left/right segments of the map line sides are updated.
+     * Ownership of the returned elements is given to the caller.
+     *
+     * @param elements  Reconstructed elements are written here.
+     *
+     * @return  @c true if the BSP was found in the cache.
+     *
+     * @throws ReadError if the cached data exists but is invalid. In this case
+     * no map elements have been created.
+     */
+    bool read(Elements &elements);
+
+    /**
+     * Write a newly built BSP to the cache.
+     *
+     * @param firstNewVertex  Index of the first vertex produced by the build.
+     * @param elements        Built elements, in map index order.
+     *
+     * @return  @c true if the file was written successfully.
+     */
+    bool write(int firstNewVertex, Elements const &elements) const;
+
+private:
+    DENG2_PRIVATE(d)
+};
+
+} // namespace bsp
+} // namespace de
+
+#endif // DENG_WORLD_BSP_BSPCACHE_H
@@ -454,7 +454,10 @@ public:
          * To be called to update precalculated vectors, distances, etc...
          * following a dependent vertex origin change notification.
          *
-         * @todo Optimize: defer until next accessed. -ds
+         * The values are updated here rather than deferred until next accessed,
+         * so the const accessors never write. The Partitioner relies on this
+         * when it evaluates partition candidates concurrently.
+         *
          * @todo Make private. -ds
          */
         void updateCache();
@@ -17,7 +17,12 @@
  * http://www.gnu.org/licenses</small>
  */
 
+#include <cmath>
 #include <cstring>
+#include <vector>
+#include <QElapsedTimer>
+#include <QSet>
+#include <de/TaskPool>
 
 #include "de_base.h"
 #include "de_console.h"
@@ -28,9 +33,9 @@
 
 using namespace de;
 
-#ifdef __SERVER__
-#  define BEGIN_COP
-#  define END_COP
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define RESAMPLE_SSE2
+#  include <emmintrin.h>
 #endif
 
 // The cached samples are stored in a hash. When a sample is purged, its
@@ -64,12 +69,21 @@ int sfxMaxCacheTics = TICSPERSEC * 60 * 4; // 4 minutes.
 
 static CacheHash scHash[CACHE_HASH_SIZE];
 
+static struct {
+    uint hits;
+    uint misses;
+    uint precached;
+    uint converted;
+    qint64 resampleTime; // Nanoseconds.
+} cacheStats;
+
 static void Sfx_Uncache(SfxCache *node);
 
 void Sfx_InitCache()
 {
     // The cache is empty in the beginning.
     std::memset(scHash, 0, sizeof(scHash));
+    std::memset(&cacheStats, 0, sizeof(cacheStats));
 }
 
 void Sfx_ShutdownCache()
@@ -102,161 +116,273 @@ static SfxCache *Sfx_GetCached(int id)
     return 0;
 }
 
-/**
- * Simple linear resampling with possible conversion to 16 bits.
- * The destination sample must be initialized and it must have a large
- * enough buffer. We won't reduce rate or bits here.
+/*
+ * Resampling kernels --------------------------------------------------------
  *
- * @note This is not a clean way to resample a sound. If you read about
- * DSP a bit, you'll find out that interpolation adds a lot of extra
- * frequencies in the sample. It should be low-pass filtered after the
- * interpolation.
+ * Samples are converted through a signed 16-bit intermediate: 8-bit data is
+ * widened first, the rate is multiplied with a four-tap interpolating filter
+ * (Catmull-Rom), and the result is narrowed back to 8 bits if necessary.
+ * The vectorized kernels produce exactly the same results as the scalar ones.
  */
-static void resample(void *dst, int dstBytesPer, int dstRate,
-                     void const *src, int srcBytesPer, int srcRate,
-                     int srcNumSamples, uint srcSize)
+
+/// Fractional bits of the interpolation filter weights.
+#define FILTER_BITS         7
+#define FILTER_ROUND        (1 << (FILTER_BITS - 1))
+
+/// Weights of an interpolated output sample between s[0] and s[1]; applied to
+/// the source samples s[-1], s[0], s[1] and s[2].
+struct FilterPhase
 {
-    DENG_ASSERT(src);
-    DENG_ASSERT(dst);
+    short taps[4];
+};
 
-    // Let's first check for the easy cases.
-    if(dstRate == srcRate)
+static FilterPhase filterPhase(int phase, int factor)
+{
+    double const t  = double(phase) / factor;
+    double const t2 = t * t, t3 = t2 * t;
+    double const weights[4] = { (-t3 + 2 * t2 - t) / 2,
+                                 (3 * t3 - 5 * t2 + 2) / 2,
+                                 (-3 * t3 + 4 * t2 + t) / 2,
+                                 (t3 - t2) / 2 };
+    FilterPhase fp;
+    int sum = 0;
+    for(int i = 0; i < 4; ++i)
     {
-        if(srcBytesPer == dstBytesPer)
+        fp.taps[i] = short(std::floor(weights[i] * (1 << FILTER_BITS) + .5));
+        sum += fp.taps[i];
+    }
+    fp.taps[1] += (1 << FILTER_BITS) - sum; // Unity gain.
+    return fp;
+}
+
+static inline short filterTap(short const *s, FilterPhase const &fp)
+{
+    int const sum = fp.taps[0] * s[-1] + fp.taps[1] * s[0] +
+                    fp.taps[2] * s[1]  + fp.taps[3] * s[2];
+    return short(de::clamp(-32768, (sum + FILTER_ROUND) >> FILTER_BITS, 32767));
+}
+
+static void widenScalar(short *dst, byte const *src, int first, int num)
+{
+    for(int i = first; i < num; ++i)
+    {
+        dst[i] = U8_S16(src[i]);
+    }
+}
+
+static void narrowScalar(byte *dst, short const *src, int first, int num)
+{
+    for(int i = first; i < num; ++i)
+    {
+        dst[i] = byte((src[i] >> 8) + 0x80);
+    }
+}
+
+static void upsampleScalar(short *dst, short const *s, int first, int num, int factor,
+                           FilterPhase const *phases)
+{
+    for(int i = first; i < num; ++i)
+    {
+        short *dp = dst + i * factor;
+        dp[0] = s[i];
+        for(int k = 1; k < factor; ++k)
         {
-            // A simple copy will suffice.
-            std::memcpy(dst, src, srcSize);
+            dp[k] = filterTap(s + i, phases[k]);
         }
-        else if(srcBytesPer == 1 && dstBytesPer == 2)
-        {
-            // Just changing the bytes won't do much good...
-            unsigned char const *sp = (unsigned char const *) src;
-            short *dp = (short *) dst;
+    }
+}
 
-            for(int i = 0; i < srcNumSamples; ++i)
-            {
-                *dp++ = (*sp++ - 0x80) << 8;
-            }
-        }
+#ifdef RESAMPLE_SSE2
 
-        return;
+static int widenSSE2(short *dst, byte const *src, int num)
+{
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const bias = _mm_set1_epi8(char(0x80));
+    int i = 0;
+    for(; i + 16 <= num; i += 16)
+    {
+        // Unsigned to signed, then into the high byte of each 16-bit sample.
+        __m128i const x = _mm_xor_si128(_mm_loadu_si128((__m128i const *) (src + i)), bias);
+        _mm_storeu_si128((__m128i *) (dst + i),     _mm_unpacklo_epi8(zero, x));
+        _mm_storeu_si128((__m128i *) (dst + i + 8), _mm_unpackhi_epi8(zero, x));
     }
+    return i;
+}
 
-    // 2x resampling.
-    if(dstRate == 2 * srcRate)
+static int narrowSSE2(byte *dst, short const *src, int num)
+{
+    __m128i const bias = _mm_set1_epi8(char(0x80));
+    int i = 0;
+    for(; i + 16 <= num; i += 16)
     {
-        if(dstBytesPer == 1)
-        {   // The source has a byte per sample as well.
-            unsigned char const *sp = (unsigned char const *) src;
-            unsigned char *dp = (unsigned char *) dst;
+        __m128i const lo = _mm_srai_epi16(_mm_loadu_si128((__m128i const *) (src + i)), 8);
+        __m128i const hi = _mm_srai_epi16(_mm_loadu_si128((__m128i const *) (src + i + 8)), 8);
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_xor_si128(_mm_packs_epi16(lo, hi), bias));
+    }
+    return i;
+}
 
-            for(int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
-            }
+/// Filters eight consecutive output samples of one phase (see filterTap()).
+static inline __m128i filterTap8(__m128i a, __m128i b, __m128i c, __m128i d,
+                                 FilterPhase const &fp)
+{
+    __m128i const w01 = _mm_setr_epi16(fp.taps[0], fp.taps[1], fp.taps[0], fp.taps[1],
+                                       fp.taps[0], fp.taps[1], fp.taps[0], fp.taps[1]);
+    __m128i const w23 = _mm_setr_epi16(fp.taps[2], fp.taps[3], fp.taps[2], fp.taps[3],
+                                       fp.taps[2], fp.taps[3], fp.taps[2], fp.taps[3]);
+    __m128i const round = _mm_set1_epi32(FILTER_ROUND);
+
+    __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(a, b), w01),
+                               _mm_madd_epi16(_mm_unpacklo_epi16(c, d), w23));
+    __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(a, b), w01),
+                               _mm_madd_epi16(_mm_unpackhi_epi16(c, d), w23));
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, round), FILTER_BITS);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, round), FILTER_BITS);
+    return _mm_packs_epi32(lo, hi); // Saturates like the scalar clamp.
+}
 
-            // Fill in the last two as well.
-            dp[0] = dp[1] = *sp;
-        }
-        else if(srcBytesPer == 1)
-        {
-            // Destination is signed 16bit. Source is 8bit.
-            unsigned char const *sp = (unsigned char const *) src;
-            short *dp = (short *) dst;
-            short first;
+/// Only the common factors 2 (11 => 22 KHz, 22 => 44 KHz) and 4 are vectorized.
+static int upsampleSSE2(short *dst, short const *s, int num, int factor,
+                        FilterPhase const *phases)
+{
+    if(factor != 2 && factor != 4) return 0;
 
-            for(int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                *dp++ = first = U8_S16(*sp);
-                *dp++ = (first + U8_S16(sp[1])) >> 1;
-            }
+    int i = 0;
+    for(; i + 8 <= num; i += 8)
+    {
+        __m128i const a = _mm_loadu_si128((__m128i const *) (s + i - 1));
+        __m128i const b = _mm_loadu_si128((__m128i const *) (s + i));
+        __m128i const c = _mm_loadu_si128((__m128i const *) (s + i + 1));
+        __m128i const d = _mm_loadu_si128((__m128i const *) (s + i + 2));
+        __m128i *dp = (__m128i *) (dst + i * factor);
 
-            // Fill in the last two as well.
-            dp[0] = dp[1] = U8_S16(*sp);
+        if(factor == 2)
+        {
+            __m128i const mid = filterTap8(a, b, c, d, phases[1]);
+            _mm_storeu_si128(dp,     _mm_unpacklo_epi16(b, mid));
+            _mm_storeu_si128(dp + 1, _mm_unpackhi_epi16(b, mid));
         }
-        else if(srcBytesPer == 2)
+        else
         {
-            // Destination is signed 16bit. Source is 16bit.
-            short const *sp = (short const *) src;
-            short *dp = (short *) dst;
+            __m128i const p1 = filterTap8(a, b, c, d, phases[1]);
+            __m128i const p2 = filterTap8(a, b, c, d, phases[2]);
+            __m128i const p3 = filterTap8(a, b, c, d, phases[3]);
+            __m128i const lo01 = _mm_unpacklo_epi16(b, p1);
+            __m128i const hi01 = _mm_unpackhi_epi16(b, p1);
+            __m128i const lo23 = _mm_unpacklo_epi16(p2, p3);
+            __m128i const hi23 = _mm_unpackhi_epi16(p2, p3);
+            _mm_storeu_si128(dp,     _mm_unpacklo_epi32(lo01, lo23));
+            _mm_storeu_si128(dp + 1, _mm_unpackhi_epi32(lo01, lo23));
+            _mm_storeu_si128(dp + 2, _mm_unpacklo_epi32(hi01, hi23));
+            _mm_storeu_si128(dp + 3, _mm_unpackhi_epi32(hi01, hi23));
+        }
+    }
+    return i;
+}
 
-            for(int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                *dp++ = *sp;
-                *dp++ = (*sp + sp[1]) >> 1;
-            }
+#endif // RESAMPLE_SSE2
 
-            dp[0] = dp[1] = *sp;
-        }
+static void widen(short *dst, byte const *src, int num)
+{
+    int done = 0;
+#ifdef RESAMPLE_SSE2
+    done = widenSSE2(dst, src, num);
+#endif
+    widenScalar(dst, src, done, num);
+}
 
-        return;
-    }
+static void narrow(byte *dst, short const *src, int num)
+{
+    int done = 0;
+#ifdef RESAMPLE_SSE2
+    done = narrowSSE2(dst, src, num);
+#endif
+    narrowScalar(dst, src, done, num);
+}
 
-    // 4x resampling (11Khz => 44KHz only).
-    if(dstRate == 4 * srcRate)
+/**
+ * @param s  Source samples. s[-1] and s[num..num+1] must be readable.
+ */
+static void upsample(short *dst, short const *s, int num, int factor)
+{
+    std::vector<FilterPhase> phases(factor);
+    for(int k = 1; k < factor; ++k)
     {
-        if(dstBytesPer == 1)
-        {
-            // The source has a byte per sample as well.
-            unsigned char const *sp = (unsigned char const *) src;
-            unsigned char *dp = (unsigned char *) dst;
-            unsigned char mid;
+        phases[k] = filterPhase(k, factor);
+    }
 
-            for(int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                mid = (*sp + sp[1]) >> 1;
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
+    int done = 0;
+#ifdef RESAMPLE_SSE2
+    done = upsampleSSE2(dst, s, num, factor, &phases[0]);
+#endif
+    upsampleScalar(dst, s, done, num, factor, &phases[0]);
+}
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
-        }
-        else if(srcBytesPer == 1)
-        {
-            // Destination is signed 16bit. Source is 8bit.
-            unsigned char const *sp = (unsigned char const *) src;
-            short *dp = (short *) dst;
-            short first, mid, last;
+/**
+ * Resampling with possible conversion to 16 bits. The destination rate must
+ * be a multiple of the source rate; the new samples are interpolated with a
+ * Catmull-Rom spline. The destination sample must be initialized
+ * and it must have a large enough buffer. We won't reduce rate or bits here.
+ *
+ * Thread-safe: samples can be converted concurrently.
+ */
+static void resample(void *dst, int dstBytesPer, int dstRate,
+                     void const *src, int srcBytesPer, int srcRate,
+                     int srcNumSamples, uint srcSize)
+{
+    DENG_ASSERT(src);
+    DENG_ASSERT(dst);
 
-            for(int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                first = U8_S16(*sp);
-                last = U8_S16(sp[1]);
-                mid = (first + last) >> 1;
-                *dp++ = first;
-                *dp++ = (first + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + last) >> 1;
-            }
+    int const num = srcNumSamples;
+    if(num <= 0) return;
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = U8_S16(*sp);
+    // Let's first check for the easy cases.
+    if(dstRate == srcRate)
+    {
+        if(srcBytesPer == dstBytesPer)
+        {
+            // A simple copy will suffice.
+            std::memcpy(dst, src, srcSize);
         }
-        else if(srcBytesPer == 2)
+        else if(srcBytesPer == 1 && dstBytesPer == 2)
         {
-            // Destination is signed 16bit. Source is 16bit.
-            short const *sp = (short const *) src;
-            short *dp = (short *) dst;
-            short mid;
+            // Just changing the bytes won't do much good...
+            widen((short *) dst, (byte const *) src, num);
+        }
+        return;
+    }
 
-            for(int i = 0; i < srcNumSamples - 1; ++i, sp++)
-            {
-                mid = (*sp + sp[1]) >> 1;
+    int const factor = dstRate / srcRate;
 
-                *dp++ = *sp;
-                *dp++ = (*sp + mid) >> 1;
-                *dp++ = mid;
-                *dp++ = (mid + sp[1]) >> 1;
-            }
+    // Signed 16-bit copy of the source, with the edge samples repeated so
+    // that the filter needs no special cases.
+    short *padded = (short *) M_Malloc(sizeof(short) * (num + 3));
+    short *s = padded + 1;
+    if(srcBytesPer == 1)
+    {
+        widen(s, (byte const *) src, num);
+    }
+    else
+    {
+        std::memcpy(s, src, sizeof(short) * num);
+    }
+    s[-1] = s[0];
+    s[num] = s[num + 1] = s[num - 1];
 
-            // Fill in the last four as well.
-            dp[0] = dp[1] = dp[2] = dp[3] = *sp;
-        }
+    if(dstBytesPer == 2)
+    {
+        upsample((short *) dst, s, num, factor);
     }
+    else
+    {
+        // The source has a byte per sample as well.
+        short *wide = (short *) M_Malloc(sizeof(short) * num * factor);
+        upsample(wide, s, num, factor);
+        narrow((byte *) dst, wide, num * factor);
+        M_Free(wide);
+    }
+
+    M_Free(padded);
 }
 
 #ifdef __CLIENT__
@@ -279,34 +405,51 @@ static bool sfxMustUpsampleToSfxRate()
 #endif
 
 /**
- * Caches a copy of the given sample. If it's already in the cache and has
- * the same format, nothing is done.
- *
- * @param id            Id number of the sound sample.
- * @param data          Actual sample data.
- * @param size          Size in bytes.
- * @param numSamples    Number of samples.
- * @param bytesPer      Bytes per sample (1 or 2).
- * @param rate          Samples per second.
- * @param group         Exclusion group (0, if none).
+ * Sample data loaded from a resource, in its original format.
+ */
+struct SampleSource
+{
+    void const *data;
+    int numSamples;
+    int bytesPer;           ///< Bytes per sample (1 or 2).
+    int rate;               ///< Samples per second.
+    void *loaded;           ///< Data allocated by the loader (Z_Free()), if any.
+    struct file1_s *file;   ///< Lump whose cached data is in use, if any.
+    int lumpIdx;
+};
+
+static void releaseSampleSource(SampleSource &src)
+{
+    if(src.loaded)
+    {
+        Z_Free(src.loaded);
+    }
+    if(src.file)
+    {
+        F_UnlockLump(src.file, src.lumpIdx);
+    }
+    std::memset(&src, 0, sizeof(src));
+}
+
+/**
+ * Determines the format of the cached copy of a sample. It is converted to
+ * the minimum resolution and bits set by sfxRate and sfxBits. The data is
+ * not converted yet.
  *
- * @returns             Ptr to the cached sample. Always valid.
+ * @param cached  Cached sample to initialize.
+ * @param id      Id number of the sound sample.
+ * @param group   Exclusion group (0, if none).
+ * @param src     The loaded sample.
  */
-static SfxCache *Sfx_CacheInsert(int id, void const *data, uint size, int numSamples,
-    int bytesPer, int rate, int group)
+static void chooseCachedFormat(sfxsample_t &cached, int id, int group, SampleSource const &src)
 {
     int rsfactor = 1;
 
-    /**
-     * First convert the sample to the minimum resolution and bits, set
-     * by sfxRate and sfxBits.
-     */
-
 #ifdef __CLIENT__
     // The (up)resampling factor.
     if(sfxMustUpsampleToSfxRate())
     {
-        rsfactor = de::max(1, sfxRate / rate);
+        rsfactor = de::max(1, sfxRate / src.rate);
     }
 #endif
 
@@ -317,31 +460,64 @@ static SfxCache *Sfx_CacheInsert(int id, void const *data, uint size, int numSam
      * not lower resolution ones.)
      */
 
-    sfxsample_t cached;
-    cached.size = numSamples * bytesPer * rsfactor;
+    std::memset(&cached, 0, sizeof(cached));
+    cached.size = src.numSamples * src.bytesPer * rsfactor;
 
-    if(sfxBits == 16 && bytesPer == 1)
+    if(sfxBits == 16 && src.bytesPer == 1)
     {
         cached.bytesPer = 2;
         cached.size *= 2; // Will be resampled to 16bit.
     }
     else
     {
-        cached.bytesPer = bytesPer;
+        cached.bytesPer = src.bytesPer;
     }
 
-    cached.rate = rsfactor * rate;
-    cached.numSamples = numSamples * rsfactor;
+    cached.rate = rsfactor * src.rate;
+    cached.numSamples = src.numSamples * rsfactor;
     cached.id = id;
     cached.group = group;
+}
+
+/**
+ * Converts the sample data into the format chosen by chooseCachedFormat().
+ * Thread-safe.
+ *
+ * @return  Time spent converting, in nanoseconds.
+ */
+static qint64 convertSample(sfxsample_t &cached, SampleSource const &src)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    cached.data = M_Malloc(cached.size);
+    // Do the resampling, if necessary.
+    resample(cached.data, cached.bytesPer, cached.rate, src.data, src.bytesPer, src.rate,
+             src.numSamples, src.numSamples * src.bytesPer);
+
+    return timer.nsecsElapsed();
+}
 
+/**
+ * Caches a converted sample. If it's already in the cache and has the same
+ * format, nothing is done.
+ *
+ * @param cached  The converted sample. The cache gets ownership of the data.
+ *
+ * @returns  Ptr to the cached sample. Always valid.
+ */
+static SfxCache *Sfx_CacheInsert(sfxsample_t const &cached)
+{
     // Check if this kind of a sample already exists.
-    SfxCache *node = Sfx_GetCached(id);
+    SfxCache *node = Sfx_GetCached(cached.id);
     if(node)
     {
         // The sound is already in the cache. Is it in the right format?
         if(cached.bytesPer * 8 == sfxBits && cached.rate == sfxRate)
+        {
+            M_Free(cached.data);
             return node; // This will do.
+        }
 
 #ifdef __CLIENT__
         // Stop all sounds using this sample (we are going to destroy the
@@ -357,7 +533,7 @@ static SfxCache *Sfx_CacheInsert(int id, void const *data, uint size, int numSam
         // Get a new node and link it in.
         node = reinterpret_cast<SfxCache *>(M_Calloc(sizeof(SfxCache)));
 
-        CacheHash *hash = Sfx_CacheHash(id);
+        CacheHash *hash = Sfx_CacheHash(cached.id);
         if(hash->last)
         {
             hash->last->next = node;
@@ -369,15 +545,11 @@ static SfxCache *Sfx_CacheInsert(int id, void const *data, uint size, int numSam
             hash->first = node;
     }
 
-    void *buf = M_Malloc(cached.size);
-    // Do the resampling, if necessary.
-    resample(buf, cached.bytesPer, cached.rate, data, bytesPer, rate,
-             numSamples, size);
-    cached.data = buf;
-
     // Hits keep count of how many times the cached sound has been played.
     // The purger will remove samples with the lowest hitcount first.
     node->hits = 0;
+    // Precached samples must not time out before they are played.
+    node->lastUsed = Timer_Ticks();
     std::memcpy(&node->sample, &cached, sizeof(cached));
     return node;
 }
@@ -386,10 +558,9 @@ static void Sfx_Uncache(SfxCache *node)
 {
     DENG2_ASSERT(node);
 
-    BEGIN_COP;
-
 #ifdef __CLIENT__
-    // Reset all channels loaded with this sample.
+    // Reset all channels loaded with this sample. Returns when the channels
+    // no longer use the sample data.
     Sfx_UnloadSoundID(node->sample.id);
 #endif
 
@@ -406,8 +577,6 @@ static void Sfx_Uncache(SfxCache *node)
     if(node->prev)
         node->prev->next = node->next;
 
-    END_COP;
-
     // Free all memory allocated for the node.
     M_Free(node->sample.data);
     M_Free(node);
@@ -486,8 +655,10 @@ void Sfx_PurgeCache()
     }
 }
 
-void Sfx_GetCacheInfo(uint *cacheBytes, uint *sampleCount)
+void Sfx_GetCacheInfo(sfxcacheinfo_t *info)
 {
+    DENG_ASSERT(info);
+
     uint size = 0, count = 0;
 
     for(int i = 0; i < CACHE_HASH_SIZE; ++i)
@@ -498,8 +669,13 @@ void Sfx_GetCacheInfo(uint *cacheBytes, uint *sampleCount)
         }
     }
 
-    if(cacheBytes)  *cacheBytes  = size;
-    if(sampleCount) *sampleCount = count;
+    info->bytes        = size;
+    info->samples      = count;
+    info->hits         = cacheStats.hits;
+    info->misses       = cacheStats.misses;
+    info->precached    = cacheStats.precached;
+    info->converted    = cacheStats.converted;
+    info->resampleTime = float(cacheStats.resampleTime / 1000000.0);
 }
 
 void Sfx_CacheHit(int id)
@@ -512,11 +688,18 @@ void Sfx_CacheHit(int id)
     }
 }
 
-static sfxsample_t *cacheSample(int id, sfxinfo_t const *info)
+/**
+ * Loads the sample data of a sound in its original format. Not thread-safe.
+ *
+ * @param src  Loaded sample. Must be released with releaseSampleSource().
+ *
+ * @return  @c true if the sample was loaded.
+ */
+static bool loadSample(int id, sfxinfo_t const *info, SampleSource &src)
 {
-    LOG_AS("Sfx_Cache");
     LOG_VERBOSE("Caching sample '%s' (#%i)...") << info->id << id;
 
+    std::memset(&src, 0, sizeof(src));
     int bytesPer = 0, rate = 0, numSamples = 0;
 
     /**
@@ -579,11 +762,11 @@ static sfxsample_t *cacheSample(int id, sfxinfo_t const *info)
         {
             LOG_WARNING("Failed to locate lump resource '%s' for sound '%s'.")
                 << info->lumpName << info->id;
-            return 0;
+            return false;
         }
 
         size_t lumpLength = F_LumpLength(info->lumpNum);
-        if(lumpLength <= 8) return 0;
+        if(lumpLength <= 8) return false;
 
         int lumpIdx;
         struct file1_s *file = F_FindFileForLumpNum2(info->lumpNum, &lumpIdx);
@@ -604,7 +787,7 @@ static sfxsample_t *cacheSample(int id, sfxinfo_t const *info)
             {
                 // Abort...
                 LOG_WARNING("Unknown WAV format in lump '%s', aborting.") << info->lumpName;
-                return 0;
+                return false;
             }
 
             bytesPer /= 8;
@@ -613,11 +796,11 @@ static sfxsample_t *cacheSample(int id, sfxinfo_t const *info)
 
     if(data) // Loaded!
     {
-        // Insert a copy of this into the cache.
-        SfxCache *node = Sfx_CacheInsert(id, data, bytesPer * numSamples, numSamples,
-                                           bytesPer, rate, info->group);
-        Z_Free(data);
-        return &node->sample;
+        src.data       = src.loaded = data;
+        src.numSamples = numSamples;
+        src.bytesPer   = bytesPer;
+        src.rate       = rate;
+        return true;
     }
 
     // Probably an old-fashioned DOOM sample.
@@ -638,20 +821,33 @@ static sfxsample_t *cacheSample(int id, sfxinfo_t const *info)
         if(head == 3 && numSamples > 0 && (unsigned) numSamples <= lumpLength - 8)
         {
             // The sample data can be used as-is - load directly from the lump cache.
-            uint8_t const *data = F_CacheLump(file, lumpIdx) + 8; // Skip the header.
-
-            // Insert a copy of this into the cache.
-            SfxCache *node = Sfx_CacheInsert(id, data, bytesPer * numSamples, numSamples,
-                                               bytesPer, rate, info->group);
-
-            F_UnlockLump(file, lumpIdx);
-
-            return &node->sample;
+            src.data       = F_CacheLump(file, lumpIdx) + 8; // Skip the header.
+            src.file       = file;
+            src.lumpIdx    = lumpIdx;
+            src.numSamples = numSamples;
+            src.bytesPer   = bytesPer;
+            src.rate       = rate;
+            return true;
         }
     }
 
     LOG_WARNING("Unknown lump '%s' sound format, aborting.") << info->lumpName;
-    return 0;
+    return false;
+}
+
+static sfxsample_t *cacheSample(int id, sfxinfo_t const *info)
+{
+    SampleSource src;
+    if(!loadSample(id, info, src)) return 0;
+
+    // Insert a converted copy of this into the cache.
+    sfxsample_t cached;
+    chooseCachedFormat(cached, id, info->group, src);
+    cacheStats.resampleTime += convertSample(cached, src);
+    cacheStats.converted++;
+    releaseSampleSource(src);
+
+    return &Sfx_CacheInsert(cached)->sample;
 }
 
 sfxsample_t *Sfx_Cache(int id)
@@ -665,9 +861,12 @@ sfxsample_t *Sfx_Cache(int id)
     // Are we so lucky that the sound is already cached?
     if(SfxCache *node = Sfx_GetCached(id))
     {
+        cacheStats.hits++;
         return &node->sample;
     }
 
+    cacheStats.misses++;
+
     // Get the sound decription.
     if(sfxinfo_t *info = S_GetSoundInfo(id, 0, 0))
     {
@@ -678,6 +877,77 @@ sfxsample_t *Sfx_Cache(int id)
     return 0;
 }
 
+namespace {
+
+/// A sample being precached.
+struct Precached
+{
+    SampleSource src;
+    sfxsample_t cached;
+    qint64 time;
+};
+
+typedef std::vector<Precached> PrecachedSamples;
+
+struct SampleConverter
+{
+    PrecachedSamples *samples;
+
+    SampleConverter(PrecachedSamples &samples) : samples(&samples) {}
+
+    void operator () (int index) const
+    {
+        Precached &p = (*samples)[index];
+        p.time = convertSample(p.cached, p.src);
+    }
+};
+
+} // namespace
+
+void Sfx_PrecacheSounds(int const *soundIds, int count)
+{
+    LOG_AS("Sfx_PrecacheSounds");
+
+#ifdef __CLIENT__
+    if(!sfxAvail) return;
+#endif
+
+    // The samples are loaded and inserted here; only the conversion is
+    // done by the worker threads.
+    PrecachedSamples samples;
+    QSet<int> seen;
+    for(int i = 0; i < count; ++i)
+    {
+        int const id = soundIds[i];
+        if(!id || seen.contains(id) || Sfx_GetCached(id)) continue;
+        seen.insert(id);
+
+        sfxinfo_t *info = S_GetSoundInfo(id, 0, 0);
+        if(!info) continue;
+
+        Precached p;
+        if(!loadSample(id, info, p.src)) continue;
+
+        chooseCachedFormat(p.cached, id, info->group, p.src);
+        p.time = 0;
+        samples.push_back(p);
+    }
+    if(samples.empty()) return;
+
+    TaskPool::parallelFor(0, int(samples.size()), SampleConverter(samples));
+
+    DENG2_FOR_EACH(PrecachedSamples, i, samples)
+    {
+        Sfx_CacheInsert(i->cached);
+        releaseSampleSource(i->src);
+        cacheStats.resampleTime += i->time;
+    }
+    cacheStats.precached += uint(samples.size());
+    cacheStats.converted += uint(samples.size());
+
+    LOG_VERBOSE("Precached %i samples.") << int(samples.size());
+}
+
 uint Sfx_GetSoundLength(int id)
 {
     sfxsample_t *sample = Sfx_Cache(id & ~DDSF_FLAG_MASK);
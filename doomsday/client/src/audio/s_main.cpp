@@ -40,8 +40,11 @@
 
 #include "audio/sys_audio.h"
 #include "world/p_players.h"
+#include "world/thinkers.h"
 #include "BspLeaf"
 
+#include <QVector>
+
 // MACROS ------------------------------------------------------------------
 
 BEGIN_PROF_TIMERS()
@@ -78,6 +81,8 @@ int sfxRate = 11025;
 
 byte sfxOneSoundPerEmitter = false; // Traditional Doomsday behavior: allows sounds to overlap.
 
+byte sfxPrecache = true; // Convert the samples of the map's sounds when it is loaded.
+
 // PRIVATE DATA DEFINITIONS ------------------------------------------------
 
 static boolean noRndPitch;
@@ -102,6 +107,7 @@ void S_Register(void)
     C_VAR_INT("sound-rate", &sfxSampleRate, 0, 11025, 44100);
     C_VAR_INT("sound-16bit", &sfx16Bit, 0, 0, 1);
     C_VAR_INT("sound-3d", &sfx3D, 0, 0, 1);
+    C_VAR_BYTE("sound-precache", &sfxPrecache, 0, 0, 1);
     C_VAR_FLOAT2("sound-reverb-volume", &sfxReverbStrength, 0, 0, 10, S_ReverbVolumeChanged);
 
     // Ccmds
@@ -168,11 +174,66 @@ void S_MapChange(void)
 #endif
 }
 
+#ifdef __CLIENT__
+static int markMobjType(thinker_t *th, void *context)
+{
+    mobj_t *mo = (mobj_t *) th;
+    QVector<bool> &used = *static_cast<QVector<bool> *>(context);
+
+    if(mo->type >= 0 && mo->type < used.size())
+    {
+        used[mo->type] = true;
+    }
+    return false; // Continue iteration.
+}
+
+/**
+ * Precaches the sounds of the mobj types present in the map: the sounds of
+ * the types themselves and those of the particle generators of their states.
+ */
+static void cacheSoundsForMap()
+{
+    QVector<bool> used(defs.count.mobjs.num, false);
+    App_World().map().thinkers().iterate(reinterpret_cast<thinkfunc_t>(gx.MobjThinker),
+                                         0x1/* All mobjs are public*/, markMobjType, &used);
+
+    QVector<int> ids;
+    for(int i = 0; i < used.size(); ++i)
+    {
+        if(!used[i]) continue;
+
+        mobjinfo_t const *info = &mobjInfo[i];
+        ids << info->seeSound << info->attackSound << info->painSound
+            << info->deathSound << info->activeSound;
+    }
+
+    for(int i = 0; i < defs.count.states.num; ++i)
+    {
+        if(!stateOwners[i] || !used[stateOwners[i] - mobjInfo]) continue;
+
+        for(ded_ptcgen_t const *gen = statePtcGens[i]; gen; gen = gen->stateNext)
+        {
+            for(int k = 0; k < gen->stageCount.num; ++k)
+            {
+                ids << gen->stages[k].sound.id << gen->stages[k].hitSound.id;
+            }
+        }
+    }
+
+    Sfx_PrecacheSounds(ids.constData(), ids.size());
+}
+#endif
+
 void S_SetupForChangedMap(void)
 {
 #ifdef __CLIENT__
     // Update who is listening now.
     Sfx_SetListener(S_GetListenerMobj());
+
+    if(sfxAvail && sfxPrecache)
+    {
+        cacheSoundsForMap();
+    }
 #endif
 }
 
@@ -37,6 +37,10 @@
 #include "audio/sys_audio.h"
 #include "api_fontrender.h"
 
+#include <cstring>
+#include <QAtomicInt>
+#include <QSemaphore>
+
 // MACROS ------------------------------------------------------------------
 
 #define SFX_MAX_CHANNELS        (256)
@@ -76,10 +80,140 @@ static mobj_t* listener;
 static Sector* listenerSector = NULL;
 
 static thread_t refreshHandle;
-static volatile boolean allowRefresh, refreshing;
 
 static byte refMonitor = 0;
 
+/// Milliseconds between refreshes of the playing channels.
+#define SFX_REFRESH_INTERVAL    (200)
+
+/**
+ * Commands from the game to the channels. The commands are applied in the
+ * refresh thread (or immediately, if the driver doesn't need refreshing), so
+ * only one thread calls the driver for the channel buffers.
+ */
+typedef enum sfxcommandtype_e {
+    SFXCMD_CREATE,      // Replace the buffer with a new one.
+    SFXCMD_DESTROY,
+    SFXCMD_START,       // Load the sample (if needed), set properties and play.
+    SFXCMD_STOP,
+    SFXCMD_RESET,       // Stop and unload the sample.
+    SFXCMD_UPDATE,      // Set properties.
+    SFXCMD_LISTENER,
+    SFXCMD_SYNC         // Signal the thread waiting in flushCommands().
+} sfxcommandtype_t;
+
+/// Buffer properties calculated by channelProperties().
+struct SfxBufferProperties
+{
+    float frequency;
+    float volume;
+    float pan;          ///< 2D buffers only.
+    int relative;       ///< 3D buffers only: position is relative to the listener.
+    float position[3];  ///< 3D buffers only.
+    float velocity[3];  ///< 3D buffers only.
+};
+
+struct SfxCommand
+{
+    sfxcommandtype_t type;
+    int channel;
+    double postTime;
+
+    int bufFlags;               ///< SFXCMD_CREATE, SFXCMD_START.
+    int bits, rate;             ///< SFXCMD_CREATE.
+    sfxsample_t *sample;        ///< SFXCMD_START.
+    float minDistance;          ///< SFXCMD_START (3D).
+    float maxDistance;          ///< SFXCMD_START (3D).
+    SfxBufferProperties props;  ///< SFXCMD_START, SFXCMD_UPDATE.
+    int property;               ///< SFXCMD_LISTENER.
+    boolean isVector;           ///< SFXCMD_LISTENER.
+    float values[4];            ///< SFXCMD_LISTENER.
+};
+
+/**
+ * Bounded lock-free queue of commands. Any thread may put commands; only one
+ * thread at a time may take them. Each cell has a sequence number that tells
+ * whether the cell is free for the put at a position, or holds the command
+ * for the take at a position.
+ */
+class SfxCommandQueue
+{
+public:
+    enum { Size = 1024 }; // Power of two.
+
+    SfxCommandQueue() : _putPos(0), _takePos(0)
+    {
+        for(int i = 0; i < Size; ++i)
+        {
+            _cells[i].sequence.fetchAndStoreRelaxed(i);
+        }
+    }
+
+    /// @return  @c false if the queue is full.
+    bool put(SfxCommand const &cmd)
+    {
+        int pos = _putPos.fetchAndAddRelaxed(0);
+        for(;;)
+        {
+            Cell &cell = _cells[pos & (Size - 1)];
+            int const diff = int(uint(cell.sequence.fetchAndAddAcquire(0)) - uint(pos));
+            if(diff == 0)
+            {
+                // The cell is free; try to claim it.
+                if(_putPos.testAndSetRelaxed(pos, int(uint(pos) + 1)))
+                {
+                    cell.cmd = cmd;
+                    cell.sequence.fetchAndStoreRelease(int(uint(pos) + 1));
+                    return true;
+                }
+                pos = _putPos.fetchAndAddRelaxed(0);
+            }
+            else if(diff < 0)
+            {
+                return false; // Full.
+            }
+            else
+            {
+                // Another thread claimed the cell.
+                pos = _putPos.fetchAndAddRelaxed(0);
+            }
+        }
+    }
+
+    /// @return  @c false if the queue is empty.
+    bool take(SfxCommand &cmd)
+    {
+        Cell &cell = _cells[_takePos & (Size - 1)];
+        if(uint(cell.sequence.fetchAndAddAcquire(0)) != _takePos + 1)
+        {
+            return false; // Empty, or the command is still being written.
+        }
+        cmd = cell.cmd;
+        cell.sequence.fetchAndStoreRelease(int(_takePos + Size));
+        _takePos++;
+        return true;
+    }
+
+private:
+    struct Cell {
+        QAtomicInt sequence;
+        SfxCommand cmd;
+    };
+    Cell _cells[Size];
+    QAtomicInt _putPos;
+    uint _takePos;
+};
+
+static SfxCommandQueue commands;
+static QSemaphore commandsPosted; // Wakes up the refresh thread.
+static QSemaphore commandsSynced; // Released when SFXCMD_SYNC is applied.
+static QSemaphore roomAvailable;  // Released when commands have been taken.
+static QAtomicInt waitingForRoom;
+
+// Statistics of the current frame (latencies in microseconds).
+static QAtomicInt postedCount, appliedCount, totalLatency, maxLatency;
+static sfxcommandstats_t lastFrameStats;
+
 // CODE --------------------------------------------------------------------
 
 /**
@@ -90,84 +224,300 @@ void Sfx_UpdateReverb(void)
     listenerSector = NULL;
 }
 
+static void setProperties(sfxbuffer_t *buf, SfxBufferProperties const &props)
+{
+    // Frequency is common to both 2D and 3D sounds.
+    AudioDriver_SFX()->Set(buf, SFXBP_FREQUENCY, props.frequency);
+    AudioDriver_SFX()->Set(buf, SFXBP_VOLUME, props.volume);
+
+    if(buf->flags & SFXBF_3D)
+    {
+        AudioDriver_SFX()->Set(buf, SFXBP_RELATIVE_MODE, props.relative);
+        AudioDriver_SFX()->Setv(buf, SFXBP_POSITION, const_cast<float *>(props.position));
+        AudioDriver_SFX()->Setv(buf, SFXBP_VELOCITY, const_cast<float *>(props.velocity));
+    }
+    else
+    {
+        AudioDriver_SFX()->Set(buf, SFXBP_PAN, props.pan);
+    }
+}
+
+static void applyCommand(SfxCommand const &cmd)
+{
+    if(cmd.type == SFXCMD_SYNC)
+    {
+        commandsSynced.release();
+        return;
+    }
+
+    if(cmd.type == SFXCMD_LISTENER)
+    {
+        if(cmd.isVector)
+            AudioDriver_SFX()->Listenerv(cmd.property, const_cast<float *>(cmd.values));
+        else
+            AudioDriver_SFX()->Listener(cmd.property, cmd.values[0]);
+        return;
+    }
+
+    sfxchannel_t *ch = channels + cmd.channel;
+    sfxbuffer_t *buf = ch->buffer;
+
+    if(cmd.type == SFXCMD_CREATE)
+    {
+        if(buf) AudioDriver_SFX()->Destroy(buf);
+        ch->buffer = AudioDriver_SFX()->Create(cmd.bufFlags, cmd.bits, cmd.rate);
+        if(!ch->buffer)
+        {
+            LOG_WARNING("Failed to create buffer for channel #%i.") << cmd.channel;
+        }
+        return;
+    }
+
+    if(!buf) return;
+
+    switch(cmd.type)
+    {
+    case SFXCMD_DESTROY:
+        AudioDriver_SFX()->Stop(buf);
+        AudioDriver_SFX()->Destroy(buf);
+        ch->buffer = NULL;
+        break;
+
+    case SFXCMD_START:
+        // The previous sound may have ended without being noticed yet.
+        if(buf->flags & SFXBF_PLAYING)
+        {
+            AudioDriver_SFX()->Stop(buf);
+        }
+
+        buf->flags &= ~(SFXBF_REPEAT | SFXBF_DONT_STOP);
+        buf->flags |= cmd.bufFlags & (SFXBF_REPEAT | SFXBF_DONT_STOP);
+
+        /**
+         * Load in the sample. Must load prior to setting properties, because
+         * the audioDriver might actually create the real buffer only upon loading.
+         *
+         * @note The sample is not reloaded if a sample with the same ID is already
+         * loaded on the channel.
+         */
+        if(!buf->sample || buf->sample->id != cmd.sample->id)
+        {
+            AudioDriver_SFX()->Load(buf, cmd.sample);
+        }
+
+        setProperties(buf, cmd.props);
+
+        // 3D sounds need a few extra properties set up.
+        if(buf->flags & SFXBF_3D)
+        {
+            // Init the buffer's min/max distances.
+            // This is only done once, when the sound is started (i.e., here).
+            AudioDriver_SFX()->Set(buf, SFXBP_MIN_DISTANCE, cmd.minDistance);
+            AudioDriver_SFX()->Set(buf, SFXBP_MAX_DISTANCE, cmd.maxDistance);
+        }
+
+        // This'll commit all the deferred properties.
+        AudioDriver_SFX()->Listener(SFXLP_UPDATE, 0);
+
+        // Start playing.
+        AudioDriver_SFX()->Play(buf);
+        break;
+
+    case SFXCMD_STOP:
+        AudioDriver_SFX()->Stop(buf);
+        break;
+
+    case SFXCMD_RESET:
+        AudioDriver_SFX()->Reset(buf);
+        break;
+
+    case SFXCMD_UPDATE:
+        setProperties(buf, cmd.props);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * Applies all the posted commands. Called by only one thread at a time.
+ */
+static void applyCommands(void)
+{
+    SfxCommand cmd;
+    while(commands.take(cmd))
+    {
+        int const latency = int((Timer_RealSeconds() - cmd.postTime) * 1000000);
+        appliedCount.ref();
+        totalLatency.fetchAndAddRelaxed(latency);
+        for(;;)
+        {
+            int const oldMax = maxLatency.fetchAndAddRelaxed(0);
+            if(latency <= oldMax || maxLatency.testAndSetRelaxed(oldMax, latency)) break;
+        }
+
+        applyCommand(cmd);
+    }
+
+    // A thread may be waiting to post more.
+    if(waitingForRoom.fetchAndStoreOrdered(0))
+    {
+        roomAvailable.release();
+    }
+}
+
+/**
+ * Wakes up the refresh thread to apply the posted commands.
+ */
+static void submitCommands(void)
+{
+    if(refreshHandle && !commandsPosted.available())
+    {
+        commandsPosted.release();
+    }
+}
+
+static void postCommand(SfxCommand &cmd)
+{
+    cmd.postTime = Timer_RealSeconds();
+    while(!commands.put(cmd))
+    {
+        if(!refreshHandle)
+        {
+            applyCommands();
+            continue;
+        }
+
+        // The queue is full; wait until the refresh thread has taken commands.
+        waitingForRoom.fetchAndStoreOrdered(1);
+        submitCommands();
+        roomAvailable.acquire();
+    }
+    postedCount.ref();
+
+    if(!refreshHandle)
+    {
+        // There is no separate thread for the channels.
+        applyCommands();
+    }
+}
+
+static void postChannelCommand(sfxchannel_t *ch, sfxcommandtype_t type)
+{
+    SfxCommand cmd = SfxCommand();
+    cmd.type = type;
+    cmd.channel = ch - channels;
+    postCommand(cmd);
+}
+
+static void postListener(int property, float value)
+{
+    SfxCommand cmd = SfxCommand();
+    cmd.type = SFXCMD_LISTENER;
+    cmd.property = property;
+    cmd.isVector = false;
+    cmd.values[0] = value;
+    postCommand(cmd);
+}
+
+static void postListenerv(int property, float const *values, int count)
+{
+    SfxCommand cmd = SfxCommand();
+    cmd.type = SFXCMD_LISTENER;
+    cmd.property = property;
+    cmd.isVector = true;
+    std::memcpy(cmd.values, values, sizeof(float) * count);
+    postCommand(cmd);
+}
+
+/**
+ * Returns when all the commands posted so far have been applied.
+ */
+static void flushCommands(void)
+{
+    if(!refreshHandle) return; // Already applied.
+
+    SfxCommand cmd = SfxCommand();
+    cmd.type = SFXCMD_SYNC;
+    postCommand(cmd);
+    submitCommands();
+    commandsSynced.acquire();
+}
+
+/**
+ * Determines whether a sound is playing on the channel, as far as the game
+ * is concerned. Non-repeating sounds are considered stopped when their
+ * playing time has elapsed.
+ */
+static boolean channelIsPlaying(sfxchannel_t const *ch)
+{
+    if(!ch->bufBytes || !(ch->bufFlags & SFXBF_PLAYING))
+        return false;
+
+    return (ch->bufFlags & SFXBF_REPEAT) || Timer_RealMilliseconds() < ch->bufEndTime;
+}
+
 #ifdef __CLIENT__
 
 /**
- * This is a high-priority thread that periodically checks if the channels
- * need to be updated with more data. The thread terminates when it notices
- * that the channels have been destroyed. The Sfx audioDriver maintains a 250ms
- * buffer for each channel, which means the refresh must be done often
- * enough to keep them filled.
+ * This is a high-priority thread that applies the channel commands and
+ * periodically checks if the channels need to be updated with more data.
+ * The thread terminates when it notices that the channels have been
+ * destroyed. The Sfx audioDriver maintains a 250ms buffer for each channel,
+ * which means the refresh must be done often enough to keep them filled.
  *
- * @todo Use a real mutex, will you?
+ * The thread owns the channel buffers while it runs: the other threads only
+ * post commands (see postCommand()).
  */
 int C_DECL Sfx_ChannelRefreshThread(void* parm)
 {
     int                 i;
     sfxchannel_t*       ch;
+    uint                lastRefresh = Timer_RealMilliseconds();
 
     DENG_UNUSED(parm);
 
     // We'll continue looping until the Sfx module is shut down.
     while(sfxAvail && channels)
     {
+        // Sleep until commands are posted or it's time to refresh.
+        uint const sinceRefresh = Timer_RealMilliseconds() - lastRefresh;
+        if(sinceRefresh < SFX_REFRESH_INTERVAL)
+        {
+            commandsPosted.tryAcquire(1, SFX_REFRESH_INTERVAL - sinceRefresh);
+        }
+
+        applyCommands();
+
+        if(Timer_RealMilliseconds() - lastRefresh < SFX_REFRESH_INTERVAL)
+            continue;
+
         // The bit is swapped on each refresh (debug info).
         refMonitor ^= 1;
 
-        if(allowRefresh)
+        // Do the refresh.
+        for(i = 0, ch = channels; i < numChannels; ++i, ch++)
         {
-            // Do the refresh.
-            refreshing = true;
-            for(i = 0, ch = channels; i < numChannels; ++i, ch++)
-            {
-                if(!ch->buffer || !(ch->buffer->flags & SFXBF_PLAYING))
-                    continue;
-
-                AudioDriver_SFX()->Refresh(ch->buffer);
-            }
+            if(!ch->buffer || !(ch->buffer->flags & SFXBF_PLAYING))
+                continue;
 
-            refreshing = false;
-            // Let's take a nap.
-            Sys_Sleep(200);
-        }
-        else
-        {
-            // Refreshing is not allowed, so take a shorter nap while
-            // waiting for allowRefresh.
-            Sys_Sleep(150);
+            AudioDriver_SFX()->Refresh(ch->buffer);
         }
+        lastRefresh = Timer_RealMilliseconds();
     }
 
     // Time to end this thread.
+    applyCommands();
     return 0;
 }
 
 #endif // __CLIENT__
 
-/**
- * Enabling refresh is simple: the refresh thread is resumed. When
- * disabling refresh, first make sure a new refresh doesn't begin (using
- * allowRefresh). We still have to see if a refresh is being made and wait
- * for it to stop. Then we can suspend the refresh thread.
- */
-void Sfx_AllowRefresh(boolean allow)
+void Sfx_GetCommandStats(sfxcommandstats_t *stats)
 {
-    if(!sfxAvail)
-        return;
-    if(allowRefresh == allow)
-        return; // No change.
-
-    allowRefresh = allow;
-
-    // If we're denying refresh, let's make sure that if it's currently
-    // running, we don't continue until it has stopped.
-    if(!allow)
-    {
-        while(refreshing)
-            Sys_Sleep(0);
-    }
-
-    // Sys_SuspendThread(refreshHandle, !allow);
+    if(!stats) return;
+    *stats = lastFrameStats;
 }
 
 /**
@@ -184,14 +534,15 @@ void Sfx_StopSoundGroup(int group, mobj_t* emitter)
 
     for(i = 0, ch = channels; i < numChannels; ++i, ch++)
     {
-        if(!ch->buffer || !(ch->buffer->flags & SFXBF_PLAYING) ||
-           ch->buffer->sample->group != group || (emitter &&
-                                                  ch->emitter != emitter))
+        if(!channelIsPlaying(ch) ||
+           ch->bufSample->group != group || (emitter &&
+                                             ch->emitter != emitter))
             continue;
 
         // This channel must stop.
-        AudioDriver_SFX()->Stop(ch->buffer);
+        Sfx_ChannelStop(ch);
     }
+    submitCommands();
 }
 
 int Sfx_StopSound(int id, mobj_t* emitter)
@@ -222,12 +573,12 @@ int Sfx_StopSoundWithLowerPriority(int id, mobj_t* emitter, int defPriority)
 
     for(i = 0, ch = channels; i < numChannels; ++i, ch++)
     {
-        if(!ch->buffer || !(ch->buffer->flags & SFXBF_PLAYING) ||
-           (id && ch->buffer->sample->id != id) || (emitter && ch->emitter != emitter))
+        if(!channelIsPlaying(ch) ||
+           (id && ch->bufSample->id != id) || (emitter && ch->emitter != emitter))
             continue;
 
         // Can it be stopped?
-        if(ch->buffer->flags & SFXBF_DONT_STOP)
+        if(ch->bufFlags & SFXBF_DONT_STOP)
         {
             // The emitter might get destroyed...
             ch->emitter = NULL;
@@ -238,16 +589,20 @@ int Sfx_StopSoundWithLowerPriority(int id, mobj_t* emitter, int defPriority)
         // Check the priority.
         if(defPriority >= 0)
         {
-            int oldPrio = defs.sounds[ch->buffer->sample->id].priority;
+            int oldPrio = defs.sounds[ch->bufSample->id].priority;
             if(oldPrio < defPriority) // Old is more important.
+            {
+                submitCommands();
                 return -1;
+            }
         }
 
         // This channel must be stopped!
-        AudioDriver_SFX()->Stop(ch->buffer);
+        Sfx_ChannelStop(ch);
         ++stopCount;
     }
 
+    submitCommands();
     return stopCount;
 }
 
@@ -286,25 +641,29 @@ int Sfx_IsPlaying(int id, mobj_t* emitter)
  */
 void Sfx_UnloadSoundID(int id)
 {
-    int                 i;
+    int                 i, count = 0;
     sfxchannel_t*       ch;
 
     if(!sfxAvail)
         return;
 
-    BEGIN_COP;
-
     for(i = 0, ch = channels; i < numChannels; ++i, ch++)
     {
-        if(!ch->buffer || !ch->buffer->sample ||
-           ch->buffer->sample->id != id)
+        if(!ch->bufSample || ch->bufSample->id != id)
             continue;
 
         // Stop and unload.
-        AudioDriver_SFX()->Reset(ch->buffer);
+        postChannelCommand(ch, SFXCMD_RESET);
+        ch->bufFlags &= ~SFXBF_PLAYING;
+        ch->bufSample = NULL;
+        count++;
     }
 
-    END_COP;
+    // The sample data is freed after this.
+    if(count)
+    {
+        flushCommands();
+    }
 }
 
 /**
@@ -320,9 +679,8 @@ int Sfx_CountPlaying(int id)
 
     for(; i < numChannels; i++, ch++)
     {
-        if(!ch->buffer || !ch->buffer->sample ||
-           ch->buffer->sample->id != id ||
-           !(ch->buffer->flags & SFXBF_PLAYING))
+        if(!ch->bufSample || ch->bufSample->id != id ||
+           !channelIsPlaying(ch))
             continue;
 
         count++;
@@ -367,7 +725,7 @@ float Sfx_Priority(mobj_t* emitter, coord_t* point, float volume, int startTic)
  */
 float Sfx_ChannelPriority(sfxchannel_t* ch)
 {
-    if(!ch->buffer || !(ch->buffer->flags & SFXBF_PLAYING))
+    if(!channelIsPlaying(ch))
         return SFX_LOWEST_PRIORITY;
 
     if(ch->flags & SFXCF_NO_ORIGIN)
@@ -391,17 +749,13 @@ void Sfx_GetListenerXYZ(float* origin)
 }
 
 /**
- * Updates the channel buffer's properties based on 2D/3D position
+ * Calculates the channel buffer's properties based on 2D/3D position
  * calculations. Listener might be NULL. Sounds emitted from the listener
  * object are considered to be inside the listener's head.
  */
-void Sfx_ChannelUpdate(sfxchannel_t* ch)
+static void channelProperties(sfxchannel_t* ch, SfxBufferProperties& props)
 {
-    sfxbuffer_t* buf = ch->buffer;
-    float normdist, dist, pan, angle, vec[3];
-
-    if(!buf || (ch->flags & SFXCF_NO_UPDATE))
-        return;
+    float normdist, dist, pan, angle;
 
     // Copy the emitter's position (if any), to the pos coord array.
     if(ch->emitter)
@@ -418,44 +772,34 @@ void Sfx_ChannelUpdate(sfxchannel_t* ch)
         }
     }
 
+    std::memset(&props, 0, sizeof(props));
+
     // Frequency is common to both 2D and 3D sounds.
-    AudioDriver_SFX()->Set(buf, SFXBP_FREQUENCY, ch->frequency);
+    props.frequency = ch->frequency;
 
-    if(buf->flags & SFXBF_3D)
+    if(ch->bufFlags & SFXBF_3D)
     {
         // Volume is affected only by maxvol.
-        AudioDriver_SFX()->Set(buf, SFXBP_VOLUME, ch->volume * sfxVolume / 255.0f);
+        props.volume = ch->volume * sfxVolume / 255.0f;
         if(ch->emitter && ch->emitter == listener)
         {
             // Emitted by the listener object. Go to relative position mode
             // and set the position to (0,0,0).
-            vec[VX] = vec[VY] = vec[VZ] = 0;
-            AudioDriver_SFX()->Set(buf, SFXBP_RELATIVE_MODE, true);
-            AudioDriver_SFX()->Setv(buf, SFXBP_POSITION, vec);
+            props.relative = true;
         }
         else
         {
             // Use the channel's map space origin.
-            float origin[3];
-            V3f_Copyd(origin, ch->origin);
-            AudioDriver_SFX()->Set(buf, SFXBP_RELATIVE_MODE, false);
-            AudioDriver_SFX()->Setv(buf, SFXBP_POSITION, origin);
+            V3f_Copyd(props.position, ch->origin);
         }
 
         // If the sound is emitted by the listener, speed is zero.
         if(ch->emitter && ch->emitter != listener &&
            Thinker_IsMobjFunc(ch->emitter->thinker.function))
         {
-            vec[VX] = ch->emitter->mom[MX] * TICSPERSEC;
-            vec[VY] = ch->emitter->mom[MY] * TICSPERSEC;
-            vec[VZ] = ch->emitter->mom[MZ] * TICSPERSEC;
-            AudioDriver_SFX()->Setv(buf, SFXBP_VELOCITY, vec);
-        }
-        else
-        {
-            // Not moving.
-            vec[VX] = vec[VY] = vec[VZ] = 0;
-            AudioDriver_SFX()->Setv(buf, SFXBP_VELOCITY, vec);
+            props.velocity[VX] = ch->emitter->mom[MX] * TICSPERSEC;
+            props.velocity[VY] = ch->emitter->mom[MY] * TICSPERSEC;
+            props.velocity[VZ] = ch->emitter->mom[MZ] * TICSPERSEC;
         }
     }
     else
@@ -518,11 +862,26 @@ void Sfx_ChannelUpdate(sfxchannel_t* ch)
             }
         }
 
-        AudioDriver_SFX()->Set(buf, SFXBP_VOLUME, ch->volume * dist * sfxVolume / 255.0f);
-        AudioDriver_SFX()->Set(buf, SFXBP_PAN, pan);
+        props.volume = ch->volume * dist * sfxVolume / 255.0f;
+        props.pan = pan;
     }
 }
 
+/**
+ * Updates the channel buffer's properties.
+ */
+void Sfx_ChannelUpdate(sfxchannel_t* ch)
+{
+    if(!ch->bufBytes || (ch->flags & SFXCF_NO_UPDATE))
+        return;
+
+    SfxCommand cmd = SfxCommand();
+    cmd.type = SFXCMD_UPDATE;
+    cmd.channel = ch - channels;
+    channelProperties(ch, cmd.props);
+    postCommand(cmd);
+}
+
 void Sfx_SetListener(mobj_t *mobj)
 {
     listener = mobj;
@@ -541,19 +900,19 @@ void Sfx_ListenerUpdate()
     {
         // Position. At eye-level.
         float vec[4]; Sfx_GetListenerXYZ(vec);
-        AudioDriver_SFX()->Listenerv(SFXLP_POSITION, vec);
+        postListenerv(SFXLP_POSITION, vec, 3);
 
         // Orientation. (0,0) will produce front=(1,0,0) and up=(0,0,1).
         vec[VX] = listener->angle / (float) ANGLE_MAX *360;
 
         vec[VY] = (listener->dPlayer? LOOKDIR2DEG(listener->dPlayer->lookDir) : 0);
-        AudioDriver_SFX()->Listenerv(SFXLP_ORIENTATION, vec);
+        postListenerv(SFXLP_ORIENTATION, vec, 2);
 
         // Velocity. The unit is world distance units per second.
         vec[VX] = listener->mom[MX] * TICSPERSEC;
         vec[VY] = listener->mom[MY] * TICSPERSEC;
         vec[VZ] = listener->mom[MZ] * TICSPERSEC;
-        AudioDriver_SFX()->Listenerv(SFXLP_VELOCITY, vec);
+        postListenerv(SFXLP_VELOCITY, vec, 3);
 
         // Reverb effects. Has the current sector changed?
         if(listenerSector != listener->bspLeaf->sectorPtr())
@@ -574,12 +933,12 @@ void Sfx_ListenerUpdate()
                 }
             }
 
-            AudioDriver_SFX()->Listenerv(SFXLP_REVERB, vec);
+            postListenerv(SFXLP_REVERB, vec, NUM_REVERB_DATA);
         }
     }
 
     // Update all listener properties.
-    AudioDriver_SFX()->Listener(SFXLP_UPDATE, 0);
+    postListener(SFXLP_UPDATE, 0);
 }
 
 void Sfx_ListenerNoReverb(void)
@@ -590,8 +949,9 @@ void Sfx_ListenerNoReverb(void)
         return;
 
     listenerSector = NULL;
-    AudioDriver_SFX()->Listenerv(SFXLP_REVERB, rev);
-    AudioDriver_SFX()->Listener(SFXLP_UPDATE, 0);
+    postListenerv(SFXLP_REVERB, rev, 4);
+    postListener(SFXLP_UPDATE, 0);
+    submitCommands();
 }
 
 /**
@@ -600,10 +960,11 @@ void Sfx_ListenerNoReverb(void)
  */
 void Sfx_ChannelStop(sfxchannel_t* ch)
 {
-    if(!ch->buffer)
+    if(!ch->bufBytes)
         return;
 
-    AudioDriver_SFX()->Stop(ch->buffer);
+    postChannelCommand(ch, SFXCMD_STOP);
+    ch->bufFlags &= ~SFXBF_PLAYING;
 }
 
 void Sfx_GetChannelPriorities(float* prios)
@@ -622,21 +983,21 @@ sfxchannel_t* Sfx_ChannelFindVacant(boolean use3D, int bytes, int rate,
 
     for(i = 0, ch = channels; i < numChannels; ++i, ch++)
     {
-        if(!ch->buffer || (ch->buffer->flags & SFXBF_PLAYING) ||
-           use3D != ((ch->buffer->flags & SFXBF_3D) != 0) ||
-           ch->buffer->bytes != bytes || ch->buffer->rate != rate)
+        if(!ch->bufBytes || channelIsPlaying(ch) ||
+           use3D != ((ch->bufFlags & SFXBF_3D) != 0) ||
+           ch->bufBytes != bytes || ch->bufRate != rate)
             continue;
 
         // What about the sample?
         if(sampleID > 0)
         {
-            if(!ch->buffer->sample || ch->buffer->sample->id != sampleID)
+            if(!ch->bufSample || ch->bufSample->id != sampleID)
                 continue;
         }
         else if(sampleID == 0)
         {
             // We're trying to find a channel with no sample already loaded.
-            if(ch->buffer->sample)
+            if(ch->bufSample)
                 continue;
         }
 
@@ -696,7 +1057,7 @@ int Sfx_StartSound(sfxsample_t* sample, float volume, float freq,
             for(selCh = NULL, i = 0, ch = channels; i < numChannels;
                 ++i, ch++)
             {
-                if(ch->buffer && (ch->buffer->flags & SFXBF_PLAYING) && ch->buffer->sample->id == sample->id)
+                if(channelIsPlaying(ch) && ch->bufSample->id == sample->id)
                 {
                     if(myPrio >= channelPrios[i] && (!selCh || channelPrios[i] <= lowPrio))
                     {
@@ -734,8 +1095,6 @@ int Sfx_StartSound(sfxsample_t* sample, float volume, float freq,
      * and mode.
      */
 
-    BEGIN_COP;
-
     // First look through the stopped channels. At this stage we're very
     // picky: only the perfect choice will be good enough.
     selCh = Sfx_ChannelFindVacant(play3D, sample->bytesPer, sample->rate,
@@ -771,10 +1130,10 @@ int Sfx_StartSound(sfxsample_t* sample, float volume, float freq,
         // stopped.
         for(prioCh = NULL, i = 0, ch = channels; i < numChannels; ++i, ch++)
         {
-            if(!ch->buffer || play3D != ((ch->buffer->flags & SFXBF_3D) != 0))
+            if(!ch->bufBytes || play3D != ((ch->bufFlags & SFXBF_3D) != 0))
                 continue; // No buffer or in the wrong mode.
 
-            if(!(ch->buffer->flags & SFXBF_PLAYING))
+            if(!channelIsPlaying(ch))
             {   // This channel is not playing, just take it!
                 selCh = ch;
                 break;
@@ -800,7 +1159,7 @@ int Sfx_StartSound(sfxsample_t* sample, float volume, float freq,
 
     if(!selCh)
     {   // A suitable channel was not found.
-        END_COP;
+        submitCommands();
 #ifdef _DEBUG
         Con_Message("Sfx_StartSound: Failed to find suitable channel for sample %i.", sample->id);
 #endif
@@ -808,22 +1167,30 @@ int Sfx_StartSound(sfxsample_t* sample, float volume, float freq,
     }
 
     // Does our channel need to be reformatted?
-    if(selCh->buffer->rate != sample->rate ||
-       selCh->buffer->bytes != sample->bytesPer)
+    if(selCh->bufRate != sample->rate ||
+       selCh->bufBytes != sample->bytesPer)
     {
-        AudioDriver_SFX()->Destroy(selCh->buffer);
         // Create a new buffer with the correct format.
-        selCh->buffer = AudioDriver_SFX()->Create(play3D ? SFXBF_3D : 0, sample->bytesPer * 8, sample->rate);
+        SfxCommand create = SfxCommand();
+        create.type = SFXCMD_CREATE;
+        create.channel = selCh - channels;
+        create.bufFlags = play3D ? SFXBF_3D : 0;
+        create.bits = sample->bytesPer * 8;
+        create.rate = sample->rate;
+        postCommand(create);
+
+        selCh->bufFlags = create.bufFlags;
+        selCh->bufBytes = sample->bytesPer;
+        selCh->bufRate = sample->rate;
+        selCh->bufSample = NULL;
     }
 
-    // Clear flags.
-    selCh->buffer->flags &= ~(SFXBF_REPEAT | SFXBF_DONT_STOP);
-
     // Set buffer flags.
+    selCh->bufFlags &= ~(SFXBF_REPEAT | SFXBF_DONT_STOP);
     if(flags & SF_REPEAT)
-        selCh->buffer->flags |= SFXBF_REPEAT;
+        selCh->bufFlags |= SFXBF_REPEAT;
     if(flags & SF_DONT_STOP)
-        selCh->buffer->flags |= SFXBF_DONT_STOP;
+        selCh->bufFlags |= SFXBF_DONT_STOP;
 
     // Init the channel information.
     selCh->flags &= ~(SFXCF_NO_ORIGIN | SFXCF_NO_ATTENUATION | SFXCF_NO_UPDATE);
@@ -846,42 +1213,23 @@ int Sfx_StartSound(sfxsample_t* sample, float volume, float freq,
         selCh->flags |= SFXCF_NO_ATTENUATION;
     }
 
-    /**
-     * Load in the sample. Must load prior to setting properties, because
-     * the audioDriver might actually create the real buffer only upon loading.
-     *
-     * @note The sample is not reloaded if a sample with the same ID is already
-     * loaded on the channel.
-     */
-    if(!selCh->buffer->sample || selCh->buffer->sample->id != sample->id)
-    {
-        AudioDriver_SFX()->Load(selCh->buffer, sample);
-    }
-
-    // Update channel properties.
-    Sfx_ChannelUpdate(selCh);
-
-    // 3D sounds need a few extra properties set up.
-    if(play3D)
-    {
-        // Init the buffer's min/max distances.
-        // This is only done once, when the sound is started (i.e., here).
-        AudioDriver_SFX()->Set(selCh->buffer, SFXBP_MIN_DISTANCE,
-                  (selCh->flags & SFXCF_NO_ATTENUATION)? 10000 :
-                  soundMinDist);
-
-        AudioDriver_SFX()->Set(selCh->buffer, SFXBP_MAX_DISTANCE,
-                  (selCh->flags & SFXCF_NO_ATTENUATION)? 20000 :
-                  soundMaxDist);
-    }
-
-    // This'll commit all the deferred properties.
-    AudioDriver_SFX()->Listener(SFXLP_UPDATE, 0);
-
-    // Start playing.
-    AudioDriver_SFX()->Play(selCh->buffer);
-
-    END_COP;
+    // The sample is loaded, the channel properties set and the sound started
+    // when the command is applied.
+    SfxCommand start = SfxCommand();
+    start.type = SFXCMD_START;
+    start.channel = selCh - channels;
+    start.bufFlags = selCh->bufFlags;
+    start.sample = sample;
+    start.minDistance = (selCh->flags & SFXCF_NO_ATTENUATION)? 10000 : soundMinDist;
+    start.maxDistance = (selCh->flags & SFXCF_NO_ATTENUATION)? 20000 : soundMaxDist;
+    channelProperties(selCh, start.props);
+    postCommand(start);
+    submitCommands();
+
+    selCh->bufSample = sample;
+    selCh->bufFlags |= SFXBF_PLAYING;
+    selCh->bufEndTime = Timer_RealMilliseconds() +
+        uint(1000.0 * sample->numSamples / (sample->rate * (freq > 0? freq : 1)));
 
     // Take note of the start time.
     selCh->startTime = nowTime;
@@ -904,7 +1252,7 @@ void Sfx_Update(void)
     // Update channels.
     for(i = 0, ch = channels; i < numChannels; ++i, ch++)
     {
-        if(!ch->buffer || !(ch->buffer->flags & SFXBF_PLAYING))
+        if(!channelIsPlaying(ch))
             continue; // Not playing sounds on this...
 
         Sfx_ChannelUpdate(ch);
@@ -925,6 +1273,13 @@ void Sfx_StartFrame(void)
     if(!sfxAvail)
         return;
 
+    // Statistics of the previous frame.
+    lastFrameStats.posted = postedCount.fetchAndStoreRelaxed(0);
+    lastFrameStats.applied = appliedCount.fetchAndStoreRelaxed(0);
+    lastFrameStats.maxLatency = maxLatency.fetchAndStoreRelaxed(0) / 1000.0f;
+    int const latencySum = totalLatency.fetchAndStoreRelaxed(0);
+    lastFrameStats.avgLatency = lastFrameStats.applied? latencySum / 1000.0f / lastFrameStats.applied : 0;
+
     // Tell the audioDriver that the sound frame begins.
     AudioDriver_Interface(AudioDriver_SFX())->Event(SFXEV_BEGIN);
 
@@ -959,6 +1314,7 @@ void Sfx_EndFrame(void)
     {
         Sfx_Update();
     }
+    submitCommands();
 
     // The sound frame ends.
     AudioDriver_Interface(AudioDriver_SFX())->Event(SFXEV_END);
@@ -980,18 +1336,25 @@ static void createChannels(int num2D, int bits, int rate)
     // Change the primary buffer's format to match the channel format.
     parm[0] = bits;
     parm[1] = rate;
-    AudioDriver_SFX()->Listenerv(SFXLP_PRIMARY_FORMAT, parm);
+    postListenerv(SFXLP_PRIMARY_FORMAT, parm, 2);
 
     // Try to create a buffer for each channel.
     for(i = 0, ch = channels; i < numChannels; ++i, ch++)
     {
-        ch->buffer = AudioDriver_SFX()->Create(num2D-- > 0 ? 0 : SFXBF_3D, bits, rate);
-        if(!ch->buffer)
-        {
-            Con_Message("Sfx_CreateChannels: Failed to create buffer for #%i.", i);
-            continue;
-        }
+        SfxCommand cmd = SfxCommand();
+        cmd.type = SFXCMD_CREATE;
+        cmd.channel = i;
+        cmd.bufFlags = num2D-- > 0 ? 0 : SFXBF_3D;
+        cmd.bits = bits;
+        cmd.rate = rate;
+        postCommand(cmd);
+
+        ch->bufFlags = cmd.bufFlags;
+        ch->bufBytes = bits / 8;
+        ch->bufRate = rate;
+        ch->bufSample = NULL;
     }
+    submitCommands();
 }
 
 /**
@@ -1001,16 +1364,16 @@ void Sfx_DestroyChannels(void)
 {
     int                 i;
 
-    BEGIN_COP;
     for(i = 0; i < numChannels; ++i)
     {
-        Sfx_ChannelStop(channels + i);
+        if(!channels[i].bufBytes) continue;
 
-        if(channels[i].buffer)
-            AudioDriver_SFX()->Destroy(channels[i].buffer);
-        channels[i].buffer = NULL;
+        postChannelCommand(channels + i, SFXCMD_DESTROY);
+        channels[i].bufFlags = 0;
+        channels[i].bufBytes = 0;
+        channels[i].bufSample = NULL;
     }
-    END_COP;
+    submitCommands();
 }
 
 void Sfx_InitChannels(void)
@@ -1057,9 +1420,6 @@ void Sfx_StartRefresh(void)
 {
     int disableRefresh = false;
 
-    refreshing = false;
-    allowRefresh = true;
-
     if(!AudioDriver_SFX()) goto noRefresh; // Nothing to refresh.
 
     if(AudioDriver_SFX()->Getv) AudioDriver_SFX()->Getv(SFXIP_DISABLE_CHANNEL_REFRESH, &disableRefresh);
@@ -1132,12 +1492,13 @@ void Sfx_Shutdown(void)
     if(!sfxAvail)
         return; // Not initialized.
 
-    // These will stop further refreshing.
+    // This will stop further refreshing.
     sfxAvail = false;
-    allowRefresh = false;
 
     if(refreshHandle)
     {
+        commandsPosted.release();
+
         // Wait for the sfx refresh thread to stop.
         Sys_WaitThread(refreshHandle, 2000, NULL);
         refreshHandle = 0;
@@ -1165,6 +1526,7 @@ void Sfx_Reset(void)
     // Stop all channels.
     for(i = 0; i < numChannels; ++i)
         Sfx_ChannelStop(&channels[i]);
+    submitCommands();
 
     // Free all samples.
     Sfx_ShutdownCache();
@@ -1239,6 +1601,7 @@ void Sfx_MapChange(void)
             Sfx_ChannelStop(ch);
         }
     }
+    submitCommands();
 
     // Sectors, too, for that matter.
     listenerSector = NULL;
@@ -1250,7 +1613,6 @@ void Sfx_DebugInfo(void)
     int i, lh;
     sfxchannel_t* ch;
     char buf[200];
-    uint cachesize, ccnt;
 
     DENG_ASSERT_IN_MAIN_THREAD();
     DENG_ASSERT_GL_CONTEXT_ACTIVE();
@@ -1273,15 +1635,25 @@ void Sfx_DebugInfo(void)
         FR_DrawTextXY("!", 0, 0);
 
     // Sample cache information.
-    Sfx_GetCacheInfo(&cachesize, &ccnt);
-    sprintf(buf, "Cached:%i (%i)", cachesize, ccnt);
+    sfxcacheinfo_t cache;
+    Sfx_GetCacheInfo(&cache);
+    sprintf(buf, "Cached:%u (%u) hits=%u misses=%u precached=%u resample=%.2fms/%u",
+            cache.bytes, cache.samples, cache.hits, cache.misses, cache.precached,
+            cache.resampleTime, cache.converted);
     FR_SetColor(1, 1, 1);
     FR_DrawTextXY(buf, 10, 0);
 
+    // Channel commands of the previous frame.
+    sfxcommandstats_t stats;
+    Sfx_GetCommandStats(&stats);
+    sprintf(buf, "Commands:%i/%i latency avg=%.2fms max=%.2fms", stats.applied,
+            stats.posted, stats.avgLatency, stats.maxLatency);
+    FR_DrawTextXY(buf, 10, lh);
+
     // Print a line of info about each channel.
     for(i = 0, ch = channels; i < numChannels; ++i, ch++)
     {
-        if(ch->buffer && (ch->buffer->flags & SFXBF_PLAYING))
+        if(channelIsPlaying(ch))
         {
             FR_SetColor(1, 1, 1);
         }
@@ -1294,24 +1666,23 @@ void Sfx_DebugInfo(void)
                 !(ch->flags & SFXCF_NO_ORIGIN) ? 'O' : '.',
                 !(ch->flags & SFXCF_NO_ATTENUATION) ? 'A' : '.',
                 ch->emitter ? 'E' : '.', ch->volume, ch->frequency,
-                ch->startTime, ch->buffer ? ch->buffer->endTime : 0,
+                ch->startTime, ch->bufEndTime,
                 ch->emitter? ch->emitter->thinker.id : 0);
-        FR_DrawTextXY(buf, 5, lh * (1 + i * 2));
+        FR_DrawTextXY(buf, 5, lh * (2 + i * 2));
 
-        if(!ch->buffer) continue;
+        if(!ch->bufBytes) continue;
 
+        // The buffer itself belongs to the refresh thread.
         sprintf(buf,
-                "    %c%c%c%c id=%03i/%-8s ln=%05i b=%i rt=%2i bs=%05i "
-                "(C%05i/W%05i)", (ch->buffer->flags & SFXBF_3D) ? '3' : '.',
-                (ch->buffer->flags & SFXBF_PLAYING) ? 'P' : '.',
-                (ch->buffer->flags & SFXBF_REPEAT) ? 'R' : '.',
-                (ch->buffer->flags & SFXBF_RELOAD) ? 'L' : '.',
-                ch->buffer->sample ? ch->buffer->sample->id : 0,
-                ch->buffer->sample ? defs.sounds[ch->buffer->sample->id].
-                id : "", ch->buffer->sample ? ch->buffer->sample->size : 0,
-                ch->buffer->bytes, ch->buffer->rate / 1000, ch->buffer->length,
-                ch->buffer->cursor, ch->buffer->written);
-        FR_DrawTextXY(buf, 5, lh * (2 + i * 2));
+                "    %c%c%c id=%03i/%-8s ln=%05u b=%i rt=%2i",
+                (ch->bufFlags & SFXBF_3D) ? '3' : '.',
+                (ch->bufFlags & SFXBF_PLAYING) ? 'P' : '.',
+                (ch->bufFlags & SFXBF_REPEAT) ? 'R' : '.',
+                ch->bufSample ? ch->bufSample->id : 0,
+                ch->bufSample ? defs.sounds[ch->bufSample->id].id : "",
+                ch->bufSample ? ch->bufSample->size : 0,
+                ch->bufBytes, ch->bufRate / 1000);
+        FR_DrawTextXY(buf, 5, lh * (3 + i * 2));
     }
 
     glDisable(GL_TEXTURE_2D);
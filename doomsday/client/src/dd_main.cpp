@@ -146,6 +146,23 @@ static void initPathMappings();
  */
 static de::File1* tryLoadFile(de::Uri const& path, size_t baseOffset = 0);
 
+/// Called by tryLoadFiles() when @a done of the @a total paths have been processed.
+typedef void (*loadprogressfunc_t)(int done, int total);
+
+/**
+ * Loads several files in the order given. The lump directories of the files
+ * are read concurrently.
+ *
+ * @param paths     Paths to the files to be loaded.
+ * @param loaded    If not @c NULL, the loaded file (or @c NULL) for each path
+ *                  is appended here.
+ * @param progress  If not @c NULL, called as the paths are processed.
+ *
+ * @return  Number of files loaded.
+ */
+static int tryLoadFiles(QList<de::Uri> const& paths, FS1::Files* loaded = 0,
+                        loadprogressfunc_t progress = 0);
+
 static bool tryUnloadFile(de::Uri const& path);
 
 filename_t ddBasePath = ""; // Doomsday root directory is at...?
@@ -726,14 +743,17 @@ static void parseStartupFilePathsAndAddFiles(const char* pathString)
     if(!buffer) Con_Error("parseStartupFilePathsAndAddFiles: Failed on allocation of %lu bytes for parse buffer.", (unsigned long) (len+1));
 
     strcpy(buffer, pathString);
+    QList<de::Uri> paths;
     token = strtok(buffer, ATWSEPS);
     while(token)
     {
-        tryLoadFile(de::Uri(token, RC_NULL));
+        paths.append(de::Uri(token, RC_NULL));
         token = strtok(NULL, ATWSEPS);
     }
     free(buffer);
 
+    tryLoadFiles(paths);
+
 #undef ATWSEPS
 }
 
@@ -818,18 +838,15 @@ static int loadFilesFromDataGameAuto()
     FS1::PathList found;
     findAllGameDataPaths(found);
 
-    int numLoaded = 0;
+    QList<de::Uri> paths;
     DENG2_FOR_EACH_CONST(FS1::PathList, i, found)
     {
         // Ignore directories.
         if(i->attrib & A_SUBDIR) continue;
 
-        if(tryLoadFile(de::Uri(i->path, RC_NULL)))
-        {
-            numLoaded += 1;
-        }
+        paths.append(de::Uri(i->path, RC_NULL));
     }
-    return numLoaded;
+    return tryLoadFiles(paths);
 }
 
 /**
@@ -879,15 +896,28 @@ boolean DD_ExchangeGamePluginEntryPoints(pluginid_t pluginId)
     return true;
 }
 
-static void loadResource(ResourceManifest &manifest)
+static void loadResources(QList<ResourceManifest *> const &manifests,
+                          loadprogressfunc_t progress = 0)
 {
-    DENG_ASSERT(manifest.resourceClass() == RC_PACKAGE);
+    QList<de::Uri> paths;
+    DENG2_FOR_EACH_CONST(QList<ResourceManifest *>, i, manifests)
+    {
+        DENG_ASSERT((*i)->resourceClass() == RC_PACKAGE);
 
-    de::Uri path(manifest.resolvedPath(false/*do not locate resource*/), RC_NULL);
-    if(path.isEmpty()) return;
+        de::Uri path((*i)->resolvedPath(false/*do not locate resource*/), RC_NULL);
+        if(path.isEmpty()) continue;
+
+        paths.append(path);
+    }
 
-    if(de::File1* file = tryLoadFile(path, 0/*base offset*/))
+    FS1::Files loaded;
+    tryLoadFiles(paths, &loaded, progress);
+
+    DENG2_FOR_EACH_CONST(FS1::Files, i, loaded)
     {
+        de::File1 *file = *i;
+        if(!file) continue;
+
         // Mark this as an original game resource.
         file->setCustom(false);
 
@@ -923,6 +953,11 @@ static int DD_BeginGameChangeWorker(void* parameters)
     return 0;
 }
 
+static void updateStartupResourcesProgress(int done, int total)
+{
+    Con_SetProgress(done * (200 - 50) / total - 1);
+}
+
 static int DD_LoadGameStartupResourcesWorker(void* parameters)
 {
     ddgamechange_paramaters_t* p = (ddgamechange_paramaters_t*)parameters;
@@ -955,19 +990,8 @@ static int DD_LoadGameStartupResourcesWorker(void* parameters)
     Con_Message("Loading game resources%s", verbose >= 1? ":" : "...");
 
     Game::Manifests const& gameManifests = App_CurrentGame().manifests();
-    int const numPackages = gameManifests.count(RC_PACKAGE);
-    int packageIdx = 0;
-    for(Game::Manifests::const_iterator i = gameManifests.find(RC_PACKAGE);
-        i != gameManifests.end() && i.key() == RC_PACKAGE; ++i, ++packageIdx)
-    {
-        loadResource(**i);
-
-        // Update our progress.
-        if(p->initiatedBusyMode)
-        {
-            Con_SetProgress((packageIdx + 1) * (200 - 50) / numPackages - 1);
-        }
-    }
+    loadResources(gameManifests.values(RC_PACKAGE),
+                  p->initiatedBusyMode? updateStartupResourcesProgress : 0);
 
     if(p->initiatedBusyMode)
     {
@@ -980,17 +1004,14 @@ static int DD_LoadGameStartupResourcesWorker(void* parameters)
 static int addListFiles(ddstring_t*** list, size_t* listSize, FileType const& ftype)
 {
     size_t i;
-    int count = 0;
     if(!list || !listSize) return 0;
+    QList<de::Uri> paths;
     for(i = 0; i < *listSize; ++i)
     {
         if(&ftype != &DD_GuessFileTypeFromFileName(Str_Text((*list)[i]))) continue;
-        if(tryLoadFile(de::Uri(Str_Text((*list)[i]), RC_NULL)))
-        {
-            count += 1;
-        }
+        paths.append(de::Uri(Str_Text((*list)[i]), RC_NULL));
     }
-    return count;
+    return tryLoadFiles(paths);
 }
 
 /**
@@ -2844,7 +2865,12 @@ D_CMD(Load)
     return didLoadGame || didLoadResource;
 }
 
-static de::File1* tryLoadFile(de::Uri const& search, size_t baseOffset)
+/**
+ * Opens a file for loading without indexing it.
+ *
+ * @return  The opened file, or @c NULL if not found or already loaded.
+ */
+static de::File1* tryOpenFile(de::Uri const& search, size_t baseOffset, bool reportLoaded = true)
 {
     try
     {
@@ -2853,13 +2879,11 @@ static de::File1* tryLoadFile(de::Uri const& search, size_t baseOffset)
         de::Uri foundFileUri = hndl.file().composeUri();
         VERBOSE( Con_Message("Loading \"%s\"...", NativePath(foundFileUri.asText()).pretty().toUtf8().constData()) )
 
-        App_FileSystem().index(hndl.file());
-
         return &hndl.file();
     }
     catch(FS1::NotFoundError const&)
     {
-        if(App_FileSystem().accessFile(search))
+        if(reportLoaded && App_FileSystem().accessFile(search))
         {
             // Must already be loaded.
             LOG_DEBUG("\"%s\" already loaded.") << NativePath(search.asText()).pretty();
@@ -2868,6 +2892,67 @@ static de::File1* tryLoadFile(de::Uri const& search, size_t baseOffset)
     return 0;
 }
 
+static de::File1* tryLoadFile(de::Uri const& search, size_t baseOffset)
+{
+    de::File1* file = tryOpenFile(search, baseOffset);
+    if(file)
+    {
+        App_FileSystem().index(*file);
+    }
+    return file;
+}
+
+/**
+ * Indexes the opened files in load order and reports the progress of each.
+ * The lump directories are read concurrently first. @a files is cleared.
+ */
+static void indexFiles(FS1::Files& files, int& done, int total, loadprogressfunc_t progress)
+{
+    App_FileSystem().readLumpDirectories(files);
+
+    DENG2_FOR_EACH_CONST(FS1::Files, i, files)
+    {
+        App_FileSystem().index(**i);
+        if(progress) progress(++done, total);
+    }
+    files.clear();
+}
+
+static int tryLoadFiles(QList<de::Uri> const& paths, FS1::Files* loaded,
+                        loadprogressfunc_t progress)
+{
+    FS1::Files pending;
+    int const total = paths.size();
+    int count = 0, done = 0;
+
+    DENG2_FOR_EACH_CONST(QList<de::Uri>, i, paths)
+    {
+        de::File1* file = tryOpenFile(*i, 0, pending.isEmpty());
+        if(!file && !pending.isEmpty())
+        {
+            // The path may refer to a lump inside one of the files still
+            // waiting to be indexed.
+            indexFiles(pending, done, total, progress);
+
+            file = tryOpenFile(*i, 0);
+        }
+
+        if(file)
+        {
+            pending.append(file);
+            count++;
+        }
+        else if(progress)
+        {
+            progress(++done, total);
+        }
+        if(loaded) loaded->append(file);
+    }
+
+    indexFiles(pending, done, total, progress);
+    return count;
+}
+
 static bool tryUnloadFile(de::Uri const& search)
 {
     try
@@ -22,6 +22,7 @@
  */
 
 #include <de/NativePath>
+#include <QAtomicInt>
 
 #include "de_base.h"
 #include "de_filesys.h"
@@ -37,8 +38,10 @@ File1::File1(FileHandle& hndl, String _path, FileInfo const& _info, File1* _cont
     // Used to favor newer files when duplicates are pruned.
     /// @todo Does not belong at this level. Load order should be determined
     ///       at file system level. -ds
-    static uint fileCounter = 0;
-    order = fileCounter++;
+    /// Lump records are created concurrently when lump directories are read
+    /// on worker threads (see FS1::index()).
+    static QAtomicInt fileCounter(0);
+    order = uint(fileCounter.fetchAndAddOrdered(1));
 }
 
 File1::~File1()
@@ -33,13 +33,17 @@
 
 #include "filehandle.h"
 
+#include <de/Guard>
+#include <de/Lockable>
 #include <de/memory.h>
 #include <de/memoryblockset.h>
 #include <de/NativePath>
 
+#include <QFile>
+
 namespace de {
 
-struct FileHandle::Instance
+struct FileHandle::Instance : public Lockable
 {
     /// The referenced file (if any).
     File1* file;
@@ -61,12 +65,51 @@ struct FileHandle::Instance
     uint8_t* data;
     uint8_t* pos;
 
-    Instance() : file(0), list(0), baseOffset(0), hndl(0), size(0), data(0), pos(0)
+    /// Memory mapping of the native file (if any). Created on first use while
+    /// the instance is locked, as the handle may be shared between threads.
+    QFile* mapFile;
+    uchar* mapped;
+    size_t mappedSize;
+    bool mapFailed; ///< Mapping has been attempted but is not possible.
+
+    Instance() : file(0), list(0), baseOffset(0), hndl(0), size(0), data(0), pos(0),
+        mapFile(0), mapped(0), mappedSize(0), mapFailed(false)
     {
         flags.eof  = false;
         flags.open = false;
         flags.reference = false;
     }
+
+    void mapNativeFile()
+    {
+        DENG2_ASSERT(hndl && !mapped);
+
+        mapFile = new QFile;
+        if(mapFile->open(hndl, QIODevice::ReadOnly))
+        {
+            qint64 const fileSize = mapFile->size();
+            if(fileSize > qint64(baseOffset))
+            {
+                mapped = mapFile->map(0, fileSize);
+                mappedSize = size_t(fileSize);
+            }
+        }
+        if(!mapped)
+        {
+            unmapNativeFile();
+            mapFailed = true;
+        }
+    }
+
+    void unmapNativeFile()
+    {
+        if(!mapFile) return;
+        if(mapped) mapFile->unmap(mapped);
+        // The FILE is not closed by QFile.
+        delete mapFile; mapFile = 0;
+        mapped = 0;
+        mappedSize = 0;
+    }
 };
 
 #if 0
@@ -144,6 +187,16 @@ FileHandle* FileHandleBuilder::fromLump(File1& lump, bool dontBuffer)
     return hndl;
 }
 
+FileHandle* FileHandleBuilder::fromData(File1& file, uint8_t* data, size_t size)
+{
+    de::FileHandle* hndl = new de::FileHandle();
+    hndl->d->file = &file;
+    hndl->d->flags.open = true;
+    hndl->d->size = size;
+    hndl->d->pos = hndl->d->data = data;
+    return hndl;
+}
+
 FileHandle* FileHandleBuilder::fromFile(File1& file)
 {
     de::FileHandle* hndl = new de::FileHandle();
@@ -220,6 +273,10 @@ FileHandle::~FileHandle()
 FileHandle& FileHandle::close()
 {
     if(!d->flags.open) return *this;
+    {
+        DENG2_GUARD(d);
+        d->unmapNativeFile();
+    }
     if(d->hndl)
     {
         fclose(d->hndl); d->hndl = 0;
@@ -329,6 +386,39 @@ size_t FileHandle::read(uint8_t* buffer, size_t count)
     }
 }
 
+uint8_t const* FileHandle::mapData(size_t* length)
+{
+    errorIfNotValid(*this, "FileHandle::mapData");
+    if(d->flags.reference)
+    {
+        return d->file->handle().mapData(length);
+    }
+
+    if(length) *length = 0;
+    if(!d->flags.open) return 0;
+
+    if(d->hndl)
+    {
+        DENG2_GUARD(d);
+        if(!d->mapped && !d->mapFailed)
+        {
+            d->mapNativeFile();
+        }
+        if(!d->mapped) return 0;
+
+        if(length) *length = d->mappedSize - d->baseOffset;
+        return d->mapped + d->baseOffset;
+    }
+
+    // Buffered lumps are already in memory.
+    if(d->data)
+    {
+        if(length) *length = d->size;
+        return d->data;
+    }
+    return 0;
+}
+
 bool FileHandle::atEnd()
 {
     errorIfNotValid(*this, "FileHandle::atEnd");
@@ -30,6 +30,7 @@
 #include <de/App>
 #include <de/Log>
 #include <de/NativePath>
+#include <de/TaskPool>
 #include <de/memory.h>
 
 #define DENG_NO_API_MACROS_FILESYS
@@ -519,6 +520,58 @@ void FS1::index(de::File1& file)
     d->loadedFilesCRC = 0;
 }
 
+/**
+ * Reads the lump directories of files ahead of indexing (see FS1::index()).
+ * The directories of WADs and ZIPs are read and parsed on first access.
+ */
+struct LumpDirectoryReader
+{
+    FS1::Files const* files;
+    Zip::PathMappings const* mappings;
+
+    LumpDirectoryReader(FS1::Files const& files, Zip::PathMappings const& mappings)
+        : files(&files), mappings(&mappings) {}
+
+    void operator () (int index) const
+    {
+        try
+        {
+            de::File1& file = *(*files)[index];
+            if(Zip* zip = dynamic_cast<Zip*>(&file))
+            {
+                zip->readLumpDirectory(*mappings);
+            }
+            else if(Wad* wad = dynamic_cast<Wad*>(&file))
+            {
+                if(!wad->empty()) wad->lump(0);
+            }
+        }
+        catch(de::Error const&)
+        {} // Will be thrown again when the file is indexed.
+    }
+};
+
+void FS1::readLumpDirectories(Files const& files)
+{
+    // Resolving the mapped paths evaluates script expressions, so it is done
+    // here in the main thread rather than in the workers.
+    Zip::PathMappings const mappings = Zip::PathMappings::current();
+
+    // Each file has a handle of its own, so the directories are independent.
+    TaskPool::parallelFor(0, files.size(), LumpDirectoryReader(files, mappings));
+}
+
+void FS1::index(Files const& files)
+{
+    readLumpDirectories(files);
+
+    // The lumps are published in load order so that overrides work as usual.
+    DENG2_FOR_EACH_CONST(Files, i, files)
+    {
+        index(**i);
+    }
+}
+
 void FS1::deindex(de::File1& file)
 {
     FileList::iterator found = findListFile(d->loadedFiles, file);
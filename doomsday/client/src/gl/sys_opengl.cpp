@@ -101,6 +101,9 @@ static void initialize(void)
     if(CommandLine_Exists("-vtxar") && !CommandLine_Exists("-novtxar"))
         GL_state.features.elementArrays = true;
 
+    if(CommandLine_Exists("-novbo"))
+        GL_state.features.vertexBufferObjects = false;
+
     if(0 != (GL_state.extensions.texFilterAniso = query("GL_EXT_texture_filter_anisotropic")))
     {
         glGetIntegerv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, (GLint*) &GL_state.maxTexFilterAniso);
@@ -436,6 +439,7 @@ boolean Sys_GLPreInit(void)
     GL_state.features.texCompression = true;
     GL_state.features.texFilterAniso = true;
     GL_state.features.texNonPowTwo = true;
+    GL_state.features.vertexBufferObjects = true;
     GL_state.features.vsync = true;
     GL_state.features.elementArrays = false;
 
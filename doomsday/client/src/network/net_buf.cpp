@@ -232,8 +232,8 @@ void N_ClearMessages(void)
  * Send the data in the netbuffer. The message is sent using an
  * unreliable, nonsequential (i.e. fast) method.
  *
- * Handles broadcasts using recursion.
- * Clients can only send stuff to the server.
+ * A broadcast is encoded once and the same encoded message is sent to all
+ * connected clients. Clients can only send stuff to the server.
  */
 void N_SendPacket(int flags)
 {
@@ -261,11 +261,46 @@ void N_SendPacket(int flags)
         }
         else
         {
-            // Broadcast to all non-local players, using recursive calls.
-            for(int i = 0; i < DDMAXPLAYERS; ++i)
+            // Broadcast to all non-local players. The message is compressed
+            // only once; each player's socket is sent the same encoded bytes.
+            int i;
+            for(i = 0; i < DDMAXPLAYERS; ++i)
             {
-                netBuffer.player = i;
-                N_SendPacket(flags);
+                if(clients[i].connected) break;
+            }
+            if(i == DDMAXPLAYERS)
+            {
+                // Nobody to send to.
+                netBuffer.player = NSP_BROADCAST;
+                return;
+            }
+
+            de::EncodedMessage message;
+            try
+            {
+                message = de::EncodedMessage(de::ByteRefArray(&netBuffer.msg, netBuffer.headerLength + netBuffer.length));
+            }
+            catch(de::Error const &er)
+            {
+                LOG_WARNING("N_SendPacket failed: ") << er.asText();
+                return;
+            }
+
+            for(; i < DDMAXPLAYERS; ++i)
+            {
+                if(!clients[i].connected) continue;
+
+                // This is what will be sent.
+                numOutBytes += netBuffer.headerLength + netBuffer.length;
+
+                try
+                {
+                    App_ServerSystem().user(clients[i].nodeID).send(message);
+                }
+                catch(de::Error const &er)
+                {
+                    LOG_WARNING("N_SendPacket failed: ") << er.asText();
+                }
             }
 
             // Reset back to -1 to notify of the broadcast.
@@ -776,13 +776,17 @@ void Net_Ticker(timespan_t time)
             {
                 if(Sv_IsFrameTarget(i))
                 {
+                    poolcounters_t const *counters = &Sv_GetPool(i)->lastCounters;
+
                     Con_Message("%i(rdy%i): avg=%05ims thres=%05ims "
-                                "bwr=%05i maxfs=%05lub unakd=%05i", i,
+                                "bwr=%05i maxfs=%05lub unakd=%05i "
+                                "rated=%05u merged=%05u sent=%05u", i,
                                 clients[i].ready, 0, 0,
                                 clients[i].bandwidthRating,
                                 /*clients[i].bwrAdjustTime,*/
                                 (unsigned long) Sv_GetMaxFrameSize(i),
-                                Sv_CountUnackedDeltas(i));
+                                Sv_CountUnackedDeltas(i),
+                                counters->rated, counters->merged, counters->sent);
                 }
                 /*if(ddPlayers[i].inGame)
                     Con_Message("%i: cmds=%i", i, clients[i].numTics);*/
@@ -54,12 +54,11 @@ END_PROF_TIMERS()
 
 typedef struct lumlistnode_s {
     struct lumlistnode_s *next;
-    struct lumlistnode_s *nextUsed;
     void *data;
 } lumlistnode_t;
 
 typedef struct listnode_s {
-    struct listnode_s *next, *nextUsed;
+    struct listnode_s *next;
     dynlight_t projection;
 } listnode_t;
 
@@ -110,15 +109,10 @@ static coord_t *luminousDist;
 static byte *luminousClipped;
 static uint *luminousOrder;
 
-// List of unused and used list nodes, for linking lumobjs with BSP leafs.
-static lumlistnode_t *listNodeFirst, *listNodeCursor;
-
-// List of lumobjs for each BSP leaf.
+// List of lumobjs for each BSP leaf. The list nodes are allocated from the
+// frame arena.
 static lumlistnode_t **bspLeafLumObjList;
 
-// Projection list nodes.
-static listnode_t *firstNode, *cursorNode;
-
 // Light projection (dynlight) lists.
 static uint projectionListCount, cursorList;
 static lightprojectionlist_t *projectionLists;
@@ -136,21 +130,7 @@ void LO_Register(void)
 
 static lumlistnode_t* allocListNode(void)
 {
-    lumlistnode_t* ln;
-
-    if(!listNodeCursor)
-    {
-        ln = (lumlistnode_t*) Z_Malloc(sizeof(*ln), PU_APPSTATIC, 0);
-
-        // Link to the list of list nodes.
-        ln->nextUsed = listNodeFirst;
-        listNodeFirst = ln;
-    }
-    else
-    {
-        ln = listNodeCursor;
-        listNodeCursor = listNodeCursor->nextUsed;
-    }
+    lumlistnode_t *ln = R_FrameAllocObject<lumlistnode_t>();
 
     ln->next = 0;
     ln->data = 0;
@@ -182,14 +162,6 @@ static uint lumToIndex(lumobj_t const *lum)
 
 static void initProjectionLists(void)
 {
-    static bool firstTime = true;
-    if(firstTime)
-    {
-        firstNode  = 0;
-        cursorNode = 0;
-        firstTime  = false;
-    }
-
     // All memory for the lists is allocated from Zone so we can "forget" it.
     projectionLists = 0;
     projectionListCount = 0;
@@ -198,10 +170,7 @@ static void initProjectionLists(void)
 
 static void clearProjectionLists(void)
 {
-    // Start reusing nodes from the first one in the list.
-    cursorNode = firstNode;
-
-    // Clear the lists.
+    // Clear the lists. (The nodes are released along with the frame arena.)
     cursorList = 0;
     if(projectionListCount)
     {
@@ -256,23 +225,7 @@ static lightprojectionlist_t *getProjectionList(uint *listIdx, int flags)
 
 static listnode_t *newListNode(void)
 {
-    listnode_t *node;
-
-    // Do we need to allocate mode nodes?
-    if(cursorNode == NULL)
-    {
-        node = (listnode_t *) Z_Malloc(sizeof(*node), PU_APPSTATIC, NULL);
-        if(!node) Con_Error(__FILE__":newListNode failed on allocation of %lu bytes for new node.", (unsigned long) sizeof(*node));
-
-        // Link the new node to the list.
-        node->nextUsed = firstNode;
-        firstNode = node;
-    }
-    else
-    {
-        node = cursorNode;
-        cursorNode = cursorNode->nextUsed;
-    }
+    listnode_t *node = R_FrameAllocObject<listnode_t>();
 
     node->next = NULL;
     return node;
@@ -595,8 +548,7 @@ void LO_BeginWorldFrame()
     }
 #endif
 
-    // Start reusing nodes from the first one in the list.
-    listNodeCursor = listNodeFirst;
+    // The list nodes were released along with the frame arena.
     if(bspLeafLumObjList)
     {
         std::memset(bspLeafLumObjList, 0, sizeof(lumlistnode_t *) * App_World().map().bspLeafCount());
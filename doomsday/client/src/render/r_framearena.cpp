@@ -0,0 +1,138 @@
+/** @file r_framearena.cpp Per-frame memory arena for the renderer.
+ *
+ * @authors Copyright © 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de_base.h"
+#include "de_console.h"
+
+#include "render/r_framearena.h"
+
+/// Size of a regular arena chunk. Larger allocations get a chunk of their own.
+#define FRAMEARENA_CHUNK_SIZE   (256 * 1024)
+
+/// All allocations are aligned to this many bytes.
+#define FRAMEARENA_ALIGNMENT    16
+
+#define FRAMEARENA_ALIGNED(x)   (((x) + FRAMEARENA_ALIGNMENT - 1) & ~size_t(FRAMEARENA_ALIGNMENT - 1))
+
+struct framearenachunk_t
+{
+    framearenachunk_t *next;
+    size_t size; ///< Usable bytes after the header.
+};
+
+/// Size of the chunk header, rounded so that the data area is aligned.
+static size_t const chunkHeaderSize = FRAMEARENA_ALIGNED(sizeof(framearenachunk_t));
+
+byte rendInfoFrameArena = false;
+
+/// All chunks owned by the arena, in allocation order.
+static framearenachunk_t *firstChunk, *lastChunk;
+
+/// Chunk currently being allocated from, and the position in it.
+static framearenachunk_t *currentChunk;
+static size_t currentPos;
+
+static size_t usedBytes; ///< Allocated during the current frame.
+static size_t peakBytes; ///< Largest per-frame total so far.
+
+void R_FrameArenaRegister()
+{
+    C_VAR_BYTE("rend-info-framearena", &rendInfoFrameArena, 0, 0, 1);
+}
+
+static inline byte *chunkData(framearenachunk_t *chunk)
+{
+    return reinterpret_cast<byte *>(chunk) + chunkHeaderSize;
+}
+
+static framearenachunk_t *newChunk(size_t minSize)
+{
+    size_t size = MAX_OF(size_t(FRAMEARENA_CHUNK_SIZE), minSize);
+    framearenachunk_t *chunk = (framearenachunk_t *) M_Malloc(chunkHeaderSize + size);
+    chunk->next = 0;
+    chunk->size = size;
+
+    // Append to the end of the chunk list.
+    if(lastChunk) lastChunk->next = chunk;
+    else firstChunk = chunk;
+    lastChunk = chunk;
+
+    return chunk;
+}
+
+void R_ShutdownFrameArena()
+{
+    while(firstChunk)
+    {
+        framearenachunk_t *next = firstChunk->next;
+        M_Free(firstChunk);
+        firstChunk = next;
+    }
+    lastChunk = currentChunk = 0;
+    currentPos = 0;
+    usedBytes = peakBytes = 0;
+}
+
+void R_ResetFrameArena()
+{
+    peakBytes = MAX_OF(peakBytes, usedBytes);
+
+    if(rendInfoFrameArena)
+    {
+        Con_Printf("Frame arena: %lu bytes (peak %lu)\n",
+                   (unsigned long) usedBytes, (unsigned long) peakBytes);
+    }
+
+    // Rewind to the first chunk; the chunks are kept for reuse.
+    currentChunk = firstChunk;
+    currentPos   = 0;
+    usedBytes    = 0;
+}
+
+void *R_FrameAlloc(size_t size)
+{
+    size = FRAMEARENA_ALIGNED(size);
+
+    // Find a chunk with enough room remaining, continuing forward from the
+    // current chunk. Chunks left behind are reused in the next frame.
+    while(currentChunk && currentPos + size > currentChunk->size)
+    {
+        currentChunk = currentChunk->next;
+        currentPos   = 0;
+    }
+    if(!currentChunk)
+    {
+        currentChunk = newChunk(size);
+        currentPos   = 0;
+    }
+
+    void *ptr = chunkData(currentChunk) + currentPos;
+    currentPos += size;
+    usedBytes  += size;
+    return ptr;
+}
+
+size_t R_FrameArenaUsed()
+{
+    return usedBytes;
+}
+
+size_t R_FrameArenaPeak()
+{
+    return MAX_OF(peakBytes, usedBytes);
+}
@@ -0,0 +1,544 @@
+/** @file r_lightkernels.cpp Vertex lighting kernels.
+ *
+ * @authors Copyright © 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include <cmath>
+
+#include "de_base.h"
+#include "de_console.h"
+
+#include "render/r_lightkernels.h"
+
+/*
+ * The vectorized kernels must not change the results: they use the same
+ * operations in the same order as the scalar kernels (no fused multiply-add,
+ * no reciprocal approximations). Light adaptation is a table lookup and is
+ * always done in scalar code.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define LIGHTKERNELS_SSE2
+#  include <emmintrin.h>
+#  if defined(_MSC_VER) || defined(__clang__) || \
+      (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#    define LIGHTKERNELS_AVX2
+#    include <immintrin.h>
+#    ifdef _MSC_VER
+#      include <intrin.h>
+#      define AVX2_TARGET
+#    else
+#      define AVX2_TARGET __attribute__((target("avx2")))
+#    endif
+#  endif
+#endif
+
+/// Torch light is attenuated to zero at this distance.
+#define TORCH_MAX_DISTANCE      1024
+
+typedef enum {
+    LK_SCALAR,
+    LK_SSE2,
+    LK_AVX2
+} lightkernelimpl_t;
+
+static char const *implNames[] = { "scalar", "SSE2", "AVX2" };
+
+static byte useSimdLightKernels = true;
+
+static lightkernelimpl_t detectImplementation()
+{
+#ifdef LIGHTKERNELS_AVX2
+# ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] >= 7)
+    {
+        __cpuid(info, 1);
+        bool const osxsave = (info[2] & (1 << 27)) != 0;
+        bool const avx     = (info[2] & (1 << 28)) != 0;
+        if(osxsave && avx && (_xgetbv(0) & 6) == 6)
+        {
+            __cpuidex(info, 7, 0);
+            if(info[1] & (1 << 5)) return LK_AVX2;
+        }
+    }
+# else
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return LK_AVX2;
+# endif
+#endif
+#ifdef LIGHTKERNELS_SSE2
+    return LK_SSE2; // Baseline for the build.
+#else
+    return LK_SCALAR;
+#endif
+}
+
+static lightkernelimpl_t implementation()
+{
+    static lightkernelimpl_t const best = detectImplementation();
+    return useSimdLightKernels? best : LK_SCALAR;
+}
+
+void R_LightKernelsRegister()
+{
+    C_VAR_BYTE("rend-light-simd", &useSimdLightKernels, 0, 0, 1);
+}
+
+char const *R_LightKernelName()
+{
+    return implNames[implementation()];
+}
+
+/*
+ * Scalar kernels ------------------------------------------------------------
+ */
+
+static inline float vertexDistance(rvertex_t const &vtx, lightkernelview_t const &view)
+{
+    // Same as Rend_PointDist2D.
+    return float(fabs((view.origin[1] - vtx.pos[VY]) * view.side[0] -
+                      (view.origin[0] - vtx.pos[VX]) * view.side[1]));
+}
+
+static void distancesScalar(float *dists, rvertex_t const *verts, uint first, uint num,
+                            lightkernelview_t const &view)
+{
+    for(uint i = first; i < num; ++i)
+    {
+        dists[i] = vertexDistance(verts[i], view);
+    }
+}
+
+/// Same as Rend_AttenuateLightLevel plus the extra light.
+static void lightValuesScalar(float *values, float const *dists, uint first, uint num,
+                              lightkernellight_t const &light)
+{
+    for(uint i = first; i < num; ++i)
+    {
+        float real = light.level;
+        if(dists[i] > 0 && light.attenuation > 0)
+        {
+            real = light.level - (dists[i] - 32) / light.attenuation * (1 - light.level);
+
+            float minimum = light.level * light.level + (light.level - .63f) * .5f;
+            if(real < minimum)
+                real = minimum; // Clamp it.
+        }
+        values[i] = real + light.extra;
+    }
+}
+
+/// Same as Rend_ApplyLightAdaptation.
+static void applyAdaptation(float *values, uint num, float const *adaptation)
+{
+    for(uint i = 0; i < num; ++i)
+    {
+        int idx = ROUND(255.0f * values[i]);
+        if(idx < 0)   idx = 0;
+        if(idx > 254) idx = 254;
+        values[i] += adaptation[idx];
+    }
+}
+
+static void modulateScalar(ColorRawf *colors, float const *values, uint first, uint num,
+                           float const ambient[3])
+{
+    for(uint i = first; i < num; ++i)
+    {
+        for(int c = 0; c < 3; ++c)
+        {
+            colors[i].rgba[c] = values[i] * ambient[c];
+        }
+    }
+}
+
+static inline bool torchReaches(float dist, lightkerneltorch_t const &torch)
+{
+    return !torch.attenuate || dist < TORCH_MAX_DISTANCE;
+}
+
+static inline float torchWeight(float dist, lightkerneltorch_t const &torch)
+{
+    float d = torch.strength;
+    if(torch.attenuate)
+    {
+        d *= (TORCH_MAX_DISTANCE - dist) / float(TORCH_MAX_DISTANCE);
+    }
+    return d;
+}
+
+/// Same as Rend_ApplyTorchLight.
+static void torchScalar(ColorRawf *colors, float const *dists, uint first, uint num,
+                        lightkerneltorch_t const &torch)
+{
+    for(uint i = first; i < num; ++i)
+    {
+        if(!torchReaches(dists[i], torch)) continue;
+
+        float const d = torchWeight(dists[i], torch);
+        float *color = colors[i].rgba;
+        for(int c = 0; c < 3; ++c)
+        {
+            if(torch.additive)
+                color[c] += d * torch.color[c];
+            else
+                color[c] += d * ((color[c] * torch.color[c]) - color[c]);
+        }
+    }
+}
+
+static void addLightScalar(ColorRawf *colors, ColorRawf const *light, uint first, uint num)
+{
+    for(uint i = first; i < num; ++i)
+    {
+        for(int c = 0; c < 3; ++c)
+        {
+            float newval = colors[i].rgba[c] + light[i].rgba[c];
+            if(newval > 1)
+                newval = 1;
+            colors[i].rgba[c] = newval;
+        }
+    }
+}
+
+/*
+ * SSE2 kernels --------------------------------------------------------------
+ */
+
+#ifdef LIGHTKERNELS_SSE2
+
+/// Select @a a where @a mask is set, otherwise @a b.
+static inline __m128 selectPs(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/// Mask of the RGB lanes of a color.
+static inline __m128 rgbMask()
+{
+    return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+}
+
+static uint distancesSSE2(float *dists, rvertex_t const *verts, uint num,
+                          lightkernelview_t const &view)
+{
+    __m128d const originX = _mm_set1_pd(view.origin[0]);
+    __m128d const originY = _mm_set1_pd(view.origin[1]);
+    __m128d const sideX   = _mm_set1_pd(view.side[0]);
+    __m128d const sideY   = _mm_set1_pd(view.side[1]);
+    __m128d const absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+
+    uint i = 0;
+    for(; i + 2 <= num; i += 2)
+    {
+        __m128d x = _mm_set_pd(verts[i + 1].pos[VX], verts[i].pos[VX]);
+        __m128d y = _mm_set_pd(verts[i + 1].pos[VY], verts[i].pos[VY]);
+
+        __m128d d = _mm_sub_pd(_mm_mul_pd(_mm_sub_pd(originY, y), sideX),
+                               _mm_mul_pd(_mm_sub_pd(originX, x), sideY));
+        d = _mm_and_pd(d, absMask);
+
+        __m128 f = _mm_cvtpd_ps(d);
+        _mm_store_ss(&dists[i],     f);
+        _mm_store_ss(&dists[i + 1], _mm_shuffle_ps(f, f, _MM_SHUFFLE(1, 1, 1, 1)));
+    }
+    return i;
+}
+
+static uint lightValuesSSE2(float *values, float const *dists, uint num,
+                            lightkernellight_t const &light)
+{
+    if(!(light.attenuation > 0))
+    {
+        return 0; // Nothing to vectorize.
+    }
+
+    float const minimum = light.level * light.level + (light.level - .63f) * .5f;
+
+    __m128 const level     = _mm_set1_ps(light.level);
+    __m128 const invLevel  = _mm_set1_ps(1 - light.level);
+    __m128 const atten     = _mm_set1_ps(light.attenuation);
+    __m128 const minimumV  = _mm_set1_ps(minimum);
+    __m128 const extra     = _mm_set1_ps(light.extra);
+    __m128 const offset    = _mm_set1_ps(32);
+    __m128 const zero      = _mm_setzero_ps();
+
+    uint i = 0;
+    for(; i + 4 <= num; i += 4)
+    {
+        __m128 dist = _mm_loadu_ps(&dists[i]);
+
+        __m128 real = _mm_sub_ps(level, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(dist, offset), atten), invLevel));
+        real = selectPs(_mm_cmplt_ps(real, minimumV), minimumV, real);
+        real = selectPs(_mm_cmpgt_ps(dist, zero), real, level);
+
+        _mm_storeu_ps(&values[i], _mm_add_ps(real, extra));
+    }
+    return i;
+}
+
+static void modulateSSE2(ColorRawf *colors, float const *values, uint num,
+                         float const ambient[3])
+{
+    __m128 const amb  = _mm_set_ps(0, ambient[2], ambient[1], ambient[0]);
+    __m128 const mask = rgbMask();
+
+    for(uint i = 0; i < num; ++i)
+    {
+        __m128 color = _mm_loadu_ps(colors[i].rgba);
+        __m128 lit   = _mm_mul_ps(_mm_set1_ps(values[i]), amb);
+        _mm_storeu_ps(colors[i].rgba, selectPs(mask, lit, color));
+    }
+}
+
+static void torchSSE2(ColorRawf *colors, float const *dists, uint num,
+                      lightkerneltorch_t const &torch)
+{
+    __m128 const tcolor = _mm_set_ps(0, torch.color[2], torch.color[1], torch.color[0]);
+    __m128 const mask   = rgbMask();
+
+    for(uint i = 0; i < num; ++i)
+    {
+        if(!torchReaches(dists[i], torch)) continue;
+
+        __m128 const d = _mm_set1_ps(torchWeight(dists[i], torch));
+        __m128 color = _mm_loadu_ps(colors[i].rgba);
+        __m128 delta;
+        if(torch.additive)
+            delta = _mm_mul_ps(d, tcolor);
+        else
+            delta = _mm_mul_ps(d, _mm_sub_ps(_mm_mul_ps(color, tcolor), color));
+
+        _mm_storeu_ps(colors[i].rgba, selectPs(mask, _mm_add_ps(color, delta), color));
+    }
+}
+
+static void setRGBSSE2(ColorRawf *colors, uint num, float value)
+{
+    __m128 const rgb  = _mm_set1_ps(value);
+    __m128 const mask = rgbMask();
+
+    for(uint i = 0; i < num; ++i)
+    {
+        _mm_storeu_ps(colors[i].rgba, selectPs(mask, rgb, _mm_loadu_ps(colors[i].rgba)));
+    }
+}
+
+static void addLightSSE2(ColorRawf *colors, ColorRawf const *light, uint num)
+{
+    __m128 const one  = _mm_set1_ps(1);
+    __m128 const mask = rgbMask();
+
+    for(uint i = 0; i < num; ++i)
+    {
+        __m128 color  = _mm_loadu_ps(colors[i].rgba);
+        __m128 newval = _mm_add_ps(color, _mm_loadu_ps(light[i].rgba));
+        newval = selectPs(_mm_cmpgt_ps(newval, one), one, newval);
+        _mm_storeu_ps(colors[i].rgba, selectPs(mask, newval, color));
+    }
+}
+
+#endif // LIGHTKERNELS_SSE2
+
+/*
+ * AVX2 kernels --------------------------------------------------------------
+ */
+
+#ifdef LIGHTKERNELS_AVX2
+
+AVX2_TARGET
+static uint distancesAVX2(float *dists, rvertex_t const *verts, uint num,
+                          lightkernelview_t const &view)
+{
+    __m256d const originX = _mm256_set1_pd(view.origin[0]);
+    __m256d const originY = _mm256_set1_pd(view.origin[1]);
+    __m256d const sideX   = _mm256_set1_pd(view.side[0]);
+    __m256d const sideY   = _mm256_set1_pd(view.side[1]);
+    __m256d const absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+
+    // Vertices are three floats apart.
+    __m128i const xIndex = _mm_set_epi32(9, 6, 3, 0);
+    __m128i const yIndex = _mm_set_epi32(10, 7, 4, 1);
+
+    uint i = 0;
+    for(; i + 4 <= num; i += 4)
+    {
+        float const *base = verts[i].pos;
+        __m256d x = _mm256_cvtps_pd(_mm_i32gather_ps(base, xIndex, 4));
+        __m256d y = _mm256_cvtps_pd(_mm_i32gather_ps(base, yIndex, 4));
+
+        __m256d d = _mm256_sub_pd(_mm256_mul_pd(_mm256_sub_pd(originY, y), sideX),
+                                  _mm256_mul_pd(_mm256_sub_pd(originX, x), sideY));
+        d = _mm256_and_pd(d, absMask);
+
+        _mm_storeu_ps(&dists[i], _mm256_cvtpd_ps(d));
+    }
+    return i;
+}
+
+AVX2_TARGET
+static uint lightValuesAVX2(float *values, float const *dists, uint num,
+                            lightkernellight_t const &light)
+{
+    if(!(light.attenuation > 0))
+    {
+        return 0; // Nothing to vectorize.
+    }
+
+    float const minimum = light.level * light.level + (light.level - .63f) * .5f;
+
+    __m256 const level     = _mm256_set1_ps(light.level);
+    __m256 const invLevel  = _mm256_set1_ps(1 - light.level);
+    __m256 const atten     = _mm256_set1_ps(light.attenuation);
+    __m256 const minimumV  = _mm256_set1_ps(minimum);
+    __m256 const extra     = _mm256_set1_ps(light.extra);
+    __m256 const offset    = _mm256_set1_ps(32);
+    __m256 const zero      = _mm256_setzero_ps();
+
+    uint i = 0;
+    for(; i + 8 <= num; i += 8)
+    {
+        __m256 dist = _mm256_loadu_ps(&dists[i]);
+
+        __m256 real = _mm256_sub_ps(level, _mm256_mul_ps(_mm256_div_ps(_mm256_sub_ps(dist, offset), atten), invLevel));
+        real = _mm256_blendv_ps(real, minimumV, _mm256_cmp_ps(real, minimumV, _CMP_LT_OQ));
+        real = _mm256_blendv_ps(level, real, _mm256_cmp_ps(dist, zero, _CMP_GT_OQ));
+
+        _mm256_storeu_ps(&values[i], _mm256_add_ps(real, extra));
+    }
+    return i;
+}
+
+#endif // LIGHTKERNELS_AVX2
+
+/*
+ * Public interface ----------------------------------------------------------
+ */
+
+void R_VertexDistances(float *dists, rvertex_t const *verts, uint num,
+                       lightkernelview_t const *view)
+{
+    DENG_ASSERT(dists && verts && view);
+
+    uint done = 0;
+    switch(implementation())
+    {
+#ifdef LIGHTKERNELS_AVX2
+    case LK_AVX2: done = distancesAVX2(dists, verts, num, *view); break;
+#endif
+#ifdef LIGHTKERNELS_SSE2
+    case LK_SSE2: done = distancesSSE2(dists, verts, num, *view); break;
+#endif
+    default: break;
+    }
+    distancesScalar(dists, verts, done, num, *view);
+}
+
+void R_LightVertices(ColorRawf *colors, float const *dists, uint num,
+                     lightkernellight_t const *light)
+{
+    DENG_ASSERT(colors && dists && light);
+
+    // Light values are calculated in batches.
+    float values[64];
+    for(uint first = 0; first < num; first += 64)
+    {
+        uint const count = MIN_OF(num - first, 64u);
+
+        uint done = 0;
+        switch(implementation())
+        {
+#ifdef LIGHTKERNELS_AVX2
+        case LK_AVX2: done = lightValuesAVX2(values, dists + first, count, *light); break;
+#endif
+#ifdef LIGHTKERNELS_SSE2
+        case LK_SSE2: done = lightValuesSSE2(values, dists + first, count, *light); break;
+#endif
+        default: break;
+        }
+        lightValuesScalar(values, dists + first, done, count, *light);
+
+        applyAdaptation(values, count, light->adaptation);
+
+#ifdef LIGHTKERNELS_SSE2
+        if(implementation() != LK_SCALAR)
+        {
+            modulateSSE2(colors + first, values, count, light->ambient);
+            continue;
+        }
+#endif
+        modulateScalar(colors + first, values, 0, count, light->ambient);
+    }
+}
+
+void R_TorchLightVertices(ColorRawf *colors, float const *dists, uint num,
+                          lightkerneltorch_t const *torch)
+{
+    DENG_ASSERT(colors && dists && torch);
+
+#ifdef LIGHTKERNELS_SSE2
+    if(implementation() != LK_SCALAR)
+    {
+        torchSSE2(colors, dists, num, *torch);
+        return;
+    }
+#endif
+    torchScalar(colors, dists, 0, num, *torch);
+}
+
+void R_SetVertexColorRGB(ColorRawf *colors, uint num, float value)
+{
+    DENG_ASSERT(colors || !num);
+
+#ifdef LIGHTKERNELS_SSE2
+    if(implementation() != LK_SCALAR)
+    {
+        setRGBSSE2(colors, num, value);
+        return;
+    }
+#endif
+    for(uint i = 0; i < num; ++i)
+    {
+        ColorRawf *c = &colors[i];
+        c->rgba[CR] = c->rgba[CG] = c->rgba[CB] = value;
+    }
+}
+
+void R_SetVertexColorAlpha(ColorRawf *colors, uint num, float alpha)
+{
+    DENG_ASSERT(colors || !num);
+
+    // A strided store; nothing to gain from vectorizing.
+    for(uint i = 0; i < num; ++i)
+    {
+        colors[i].rgba[CA] = alpha;
+    }
+}
+
+void R_AddVertexLight(ColorRawf *colors, ColorRawf const *light, uint num)
+{
+    DENG_ASSERT((colors && light) || !num);
+
+#ifdef LIGHTKERNELS_SSE2
+    if(implementation() != LK_SCALAR)
+    {
+        addLightSSE2(colors, light, num);
+        return;
+    }
+#endif
+    addLightScalar(colors, light, 0, num);
+}
@@ -105,6 +105,9 @@ void R_Register()
     C_VAR_INT ("rend-info-tris",            &rendInfoTris,          0, 0, 1);
 
     C_CMD("viewgrid", "ii", ViewGrid);
+
+    R_FrameArenaRegister();
+    R_LightKernelsRegister();
 #endif
 }
 
@@ -751,6 +754,9 @@ void R_BeginWorldFrame()
         // Initialize and/or update the LightGrid.
         App_World().map().initLightGrid();
 
+        // Release everything allocated for the previous frame.
+        R_ResetFrameArena();
+
         SB_BeginFrame();
         LO_BeginWorldFrame();
         R_ClearObjlinksForFrame(); // Zeroes the links.
@@ -1228,6 +1234,12 @@ void R_RenderViewPorts()
     // Restore things back to normal.
     displayPlayer = oldDisplay;
     R_UseViewPort(NULL);
+
+    // Continue preparing the skins of models that came into view.
+    if(useModels)
+    {
+        Models_PrepareQueuedSkins();
+    }
 }
 
 static int findSpriteOwner(thinker_t *th, void *context)
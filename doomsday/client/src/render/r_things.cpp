@@ -1058,6 +1058,17 @@ void R_ProjectSprite(mobj_t *mo)
             mf = nextmf = NULL;
             interp = -1;
         }
+
+        // Models whose skins are still being prepared are drawn as sprites.
+        if(mf && !Models_IsReady(mf))
+        {
+            mf = nextmf = NULL;
+            interp = -1;
+        }
+        if(nextmf && !Models_IsReady(nextmf))
+        {
+            nextmf = NULL;
+        }
     }
     visType = !mf? VSPR_SPRITE : VSPR_MODEL;
 
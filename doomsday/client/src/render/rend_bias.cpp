@@ -34,8 +34,6 @@
 
 using namespace de;
 
-static float const biasIgnoreLimit = .005f;
-
 BEGIN_PROF_TIMERS()
   PROF_BIAS_UPDATE
 END_PROF_TIMERS()
@@ -57,6 +55,7 @@ static float biasMin = .85f; //cvar
 static float biasMax = 1.f; //cvar
 static int doUpdateAffected = true; //cvar
 static int lightSpeed = 130; //cvar
+static float biasIgnoreLimit = .005f; //cvar
 
 uint currentTimeSB;
 
@@ -64,7 +63,8 @@ int numSources;
 static source_t sources[MAX_BIAS_LIGHTS];
 static int numSourceDelta;
 
-static uint lastChangeOnFrame;
+/// Affected sources of all surfaces must be determined again.
+static bool needFullUpdate;
 
 /**
  * BS_EvalPoint uses these, so they must be set before it is called.
@@ -78,6 +78,44 @@ static float biasAmount;
 static BiasSurface *surfaces;
 static zblockset_t *biasSurfaceBlockSet;
 
+/// Size of a source/surface grid cell in map units.
+#define BIAS_GRID_CELL_SIZE     512
+
+typedef struct biasgridcell_s {
+    BiasSurface *surfaces;
+    AABoxd surfaceBounds; ///< Bounds of all surfaces in the cell.
+    float minThreshold; ///< Lower bound for the affectThreshold of the surfaces.
+    float maxIntensity; ///< Strongest source in the cell.
+} biasgridcell_t;
+
+/**
+ * Uniform grid over the map for finding the sources near a surface and the
+ * surfaces near a source. Sources outside the grid are kept in an extra
+ * bucket that is always checked. Surfaces that can move in the XY plane
+ * (polyobjs) are not indexed.
+ */
+static struct biasgrid_s {
+    double origin[2];
+    int width, height;
+    biasgridcell_t *cells; // [width * height]
+    /// Sources of cell N are cellSources[cellSourceStart[N] ... cellSourceStart[N+1]-1].
+    /// The sources outside the grid are in the extra cell N == width * height.
+    int *cellSourceStart; // [width * height + 3]
+    int cellSources[MAX_BIAS_LIGHTS];
+    float maxIntensity; ///< Strongest source overall.
+    /// Largest distance the bounds of the surfaces extend outside their cell.
+    double surfaceOverhang;
+    BiasSurface *unindexed; ///< Surfaces not in any cell.
+} grid;
+
+/// Source positions and intensities as they were when the grid was updated.
+static struct indexedsource_s {
+    double origin[2];
+    float intensity;
+} indexedSources[MAX_BIAS_LIGHTS];
+
+static void biasIgnoreLimitChanged();
+
 void SB_Register()
 {
     C_VAR_INT("rend-bias", &useBias, 0, 0, 1);
@@ -88,12 +126,200 @@ void SB_Register()
 
     C_VAR_INT("rend-bias-lightspeed", &lightSpeed, 0, 0, 5000);
 
+    C_VAR_FLOAT2("rend-bias-ignore-limit", &biasIgnoreLimit, 0, .0001f, 1, biasIgnoreLimitChanged);
+
     // Development variables.
     C_VAR_INT("rend-dev-bias-sight", &useSightCheck, CVF_NO_ARCHIVE, 0, 1);
 
     C_VAR_INT("rend-dev-bias-affected", &doUpdateAffected, CVF_NO_ARCHIVE, 0, 1);
 }
 
+static inline int gridCellCount()
+{
+    return grid.width * grid.height;
+}
+
+static inline int gridCoord(double pos, int axis)
+{
+    return int(std::floor((pos - grid.origin[axis]) / BIAS_GRID_CELL_SIZE));
+}
+
+/**
+ * @return  Index of the cell containing the point; gridCellCount() if the
+ * point is outside the grid.
+ */
+static int gridCellAt(double x, double y)
+{
+    int const cx = gridCoord(x, VX);
+    int const cy = gridCoord(y, VY);
+
+    if(cx < 0 || cy < 0 || cx >= grid.width || cy >= grid.height)
+        return gridCellCount();
+
+    return cy * grid.width + cx;
+}
+
+/**
+ * Determine the range of cells (minX, minY, maxX, maxY) covered by @a box,
+ * clamped to the grid.
+ */
+static void gridCellRange(AABoxd const &box, int range[4])
+{
+    range[0] = MINMAX_OF(0, gridCoord(box.minX, VX), grid.width  - 1);
+    range[1] = MINMAX_OF(0, gridCoord(box.minY, VY), grid.height - 1);
+    range[2] = MINMAX_OF(0, gridCoord(box.maxX, VX), grid.width  - 1);
+    range[3] = MINMAX_OF(0, gridCoord(box.maxY, VY), grid.height - 1);
+}
+
+/// @return  Distance from the point to @a box in the XY plane.
+static double boxDistance(AABoxd const &box, double x, double y)
+{
+    double const dx = x < box.minX? box.minX - x : x > box.maxX? x - box.maxX : 0;
+    double const dy = y < box.minY? box.minY - y : y > box.maxY? y - box.maxY : 0;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * @return  Upper bound for the intensity of a source at the given distance
+ * from a surface (see updateAffected()).
+ */
+static inline double maxIntensityAt(float intensity, double distance)
+{
+    // Allow some slack for the single precision math of the affection tests.
+    return intensity / MAX_OF(1, distance - 1);
+}
+
+static void initGrid(Map const &map)
+{
+    AABoxd const &bounds = map.bounds();
+
+    grid.origin[VX] = bounds.minX;
+    grid.origin[VY] = bounds.minY;
+    grid.width  = MAX_OF(1, int(std::ceil((bounds.maxX - bounds.minX) / BIAS_GRID_CELL_SIZE)));
+    grid.height = MAX_OF(1, int(std::ceil((bounds.maxY - bounds.minY) / BIAS_GRID_CELL_SIZE)));
+
+    if(grid.cells) Z_Free(grid.cells);
+    if(grid.cellSourceStart) Z_Free(grid.cellSourceStart);
+
+    grid.cells = (biasgridcell_t *) Z_Calloc(sizeof(*grid.cells) * gridCellCount(), PU_APPSTATIC, 0);
+    for(int i = 0; i < gridCellCount(); ++i)
+    {
+        grid.cells[i].surfaceBounds.clear();
+        grid.cells[i].minThreshold = biasIgnoreLimit;
+    }
+
+    grid.cellSourceStart = (int *) Z_Calloc(sizeof(int) * (gridCellCount() + 3), PU_APPSTATIC, 0);
+    grid.maxIntensity = 0;
+    grid.surfaceOverhang = 0;
+    grid.unindexed = 0;
+}
+
+/**
+ * Add @a bsuf to the surface index.
+ *
+ * @param canMove  The surface can move in the XY plane, so it is not placed
+ *                 in any cell.
+ */
+static void indexSurface(BiasSurface &bsuf, AABoxd const &bounds, bool canMove = false)
+{
+    bsuf.bounds = bounds;
+
+    if(canMove)
+    {
+        bsuf.cell = -1;
+        bsuf.nextInCell = grid.unindexed;
+        grid.unindexed = &bsuf;
+        return;
+    }
+
+    int range[4];
+    gridCellRange(bounds, range);
+    bsuf.cell = ((range[1] + range[3]) / 2) * grid.width + (range[0] + range[2]) / 2;
+
+    biasgridcell_t &cell = grid.cells[bsuf.cell];
+    bsuf.nextInCell = cell.surfaces;
+    cell.surfaces = &bsuf;
+
+    cell.surfaceBounds.minX = MIN_OF(cell.surfaceBounds.minX, bounds.minX);
+    cell.surfaceBounds.minY = MIN_OF(cell.surfaceBounds.minY, bounds.minY);
+    cell.surfaceBounds.maxX = MAX_OF(cell.surfaceBounds.maxX, bounds.maxX);
+    cell.surfaceBounds.maxY = MAX_OF(cell.surfaceBounds.maxY, bounds.maxY);
+
+    // How far outside the cell does the surface extend?
+    double const cellMinX = grid.origin[VX] + (bsuf.cell % grid.width) * BIAS_GRID_CELL_SIZE;
+    double const cellMinY = grid.origin[VY] + (bsuf.cell / grid.width) * BIAS_GRID_CELL_SIZE;
+    double const overhang = de::max(de::max(cellMinX - bounds.minX, bounds.maxX - (cellMinX + BIAS_GRID_CELL_SIZE)),
+                                    de::max(cellMinY - bounds.minY, bounds.maxY - (cellMinY + BIAS_GRID_CELL_SIZE)));
+    grid.surfaceOverhang = de::max(grid.surfaceOverhang, overhang);
+}
+
+static void unindexSurface(BiasSurface &bsuf)
+{
+    if(!grid.cells || bsuf.cell >= gridCellCount()) return;
+
+    BiasSurface **head = (bsuf.cell >= 0? &grid.cells[bsuf.cell].surfaces : &grid.unindexed);
+    for(BiasSurface **it = head; *it; it = &(*it)->nextInCell)
+    {
+        if(*it == &bsuf)
+        {
+            *it = bsuf.nextInCell;
+            break;
+        }
+    }
+    bsuf.cell = -1;
+    bsuf.nextInCell = 0;
+}
+
+/**
+ * Sort the sources into the grid cells. The current origins and intensities
+ * are remembered so that the surfaces affected by the sources can be found
+ * after they change.
+ */
+static void indexSources()
+{
+    int const numCells = gridCellCount();
+    int *start = grid.cellSourceStart;
+    int sourceCell[MAX_BIAS_LIGHTS];
+
+    std::memset(start, 0, sizeof(*start) * (numCells + 3));
+    for(int i = 0; i < numCells; ++i)
+    {
+        grid.cells[i].maxIntensity = 0;
+    }
+    grid.maxIntensity = 0;
+
+    for(int i = 0; i < numSources; ++i)
+    {
+        source_t const &src = sources[i];
+
+        indexedSources[i].origin[VX] = src.origin[VX];
+        indexedSources[i].origin[VY] = src.origin[VY];
+        indexedSources[i].intensity  = src.intensity;
+
+        sourceCell[i] = -1;
+        if(src.intensity <= 0) continue;
+
+        int const cell = sourceCell[i] = gridCellAt(src.origin[VX], src.origin[VY]);
+        start[cell + 2]++;
+
+        if(cell < numCells)
+        {
+            grid.cells[cell].maxIntensity = MAX_OF(grid.cells[cell].maxIntensity, src.intensity);
+        }
+        grid.maxIntensity = MAX_OF(grid.maxIntensity, src.intensity);
+    }
+
+    for(int i = 2; i < numCells + 3; ++i)
+    {
+        start[i] += start[i - 1];
+    }
+    for(int i = 0; i < numSources; ++i)
+    {
+        if(sourceCell[i] < 0) continue;
+        grid.cellSources[start[sourceCell[i] + 1]++] = i;
+    }
+}
+
 BiasSurface *SB_CreateSurface()
 {
     DENG_ASSERT(biasSurfaceBlockSet != 0);
@@ -101,6 +327,10 @@ BiasSurface *SB_CreateSurface()
     BiasSurface *bsuf = (BiasSurface *) ZBlockSet_Allocate(biasSurfaceBlockSet);
     zapPtr(bsuf);
 
+    bsuf->flags = BSF_AFFECTED_DIRTY;
+    bsuf->affectThreshold = biasIgnoreLimit;
+    bsuf->cell = -1;
+
     // Link it in the global list.
     bsuf->next = surfaces;
     surfaces = bsuf;
@@ -110,6 +340,8 @@ BiasSurface *SB_CreateSurface()
 
 void SB_DestroySurface(BiasSurface &bsuf)
 {
+    unindexSurface(bsuf);
+
     // Unlink this surface from the global list.
     /// @todo Optimize: This O(n) algorithm is entirely inadequate given the scale
     /// of "modern" maps which can often require upward of 150k surfaces.
@@ -166,6 +398,9 @@ int SB_NewSourceAt(coord_t x, coord_t y, coord_t z, float size, float minLight,
     // STILL_UNSEEN).
     src->lastUpdateTime = 0;
 
+    // Not yet affecting anything.
+    indexedSources[numSources - 1].intensity = 0;
+
     return numSources; // == index + 1;
 }
 
@@ -220,6 +455,9 @@ void SB_Delete(int which)
 
     // Will be one fewer very soon.
     numSourceDelta--;
+
+    // The indices of the sources change.
+    needFullUpdate = true;
 }
 
 void SB_Clear()
@@ -229,6 +467,7 @@ void SB_Clear()
         sources[numSources].flags |= BLF_CHANGED;
     }
     numSources = 0;
+    needFullUpdate = true;
 }
 
 /**
@@ -265,6 +504,8 @@ static void prepareSurfaces(Map &map)
     biasSurfaceBlockSet = ZBlockSet_New(sizeof(BiasSurface), 512, PU_APPSTATIC);
     surfaces = 0;
 
+    initGrid(map);
+
     size_t numVertIllums = 0;
 
     // First, determine the total number of vertexillum_ts we need.
@@ -301,12 +542,18 @@ static void prepareSurfaces(Map &map)
     {
         if(!segment->hasLineSide()) continue;
 
+        Vector2d const &from = segment->from().origin();
+        Vector2d const &to   = segment->to().origin();
+        AABoxd const bounds(de::min(from.x, to.x), de::min(from.y, to.y),
+                            de::max(from.x, to.x), de::max(from.y, to.y));
+
         for(int i = 0; i < 3; ++i)
         {
             BiasSurface *bsuf = SB_CreateSurface();
 
             bsuf->size  = 4;
             bsuf->illum = illums;
+            indexSurface(*bsuf, bounds);
 
             segment->setBiasSurface(i, bsuf);
 
@@ -325,6 +572,7 @@ static void prepareSurfaces(Map &map)
 
             bsuf->size  = bspLeaf->numFanVertices();
             bsuf->illum = illums;
+            indexSurface(*bsuf, bspLeaf->poly().aaBox());
 
             bspLeaf->setBiasSurface(i, bsuf);
 
@@ -345,6 +593,9 @@ static void prepareSurfaces(Map &map)
             bsuf->illum = illums;
             illums += 4;
 
+            // Polyobjs move, so the bounds are updated when needed.
+            indexSurface(*bsuf, AABoxd(), true /*can move*/);
+
             segment->setBiasSurface(i, bsuf);
         }
     }
@@ -359,6 +610,9 @@ void SB_InitForMap(Map &map)
     loadSources(map);
     prepareSurfaces(map);
 
+    // Determine the affected surfaces from scratch.
+    needFullUpdate = true;
+
     LOG_INFO(String("Completed in %1 seconds.").arg(begunAt.since(), 0, 'g', 2));
 }
 
@@ -386,6 +640,20 @@ void SB_SetColor(float *dest, float *src)
     }
 }
 
+/// @return  Index of the weakest source in @a aff (the later one of equals).
+static int SB_WeakestAffected(Affection const *aff)
+{
+    int weakest = 0;
+    for(int i = 1; i < aff->numFound; ++i)
+    {
+        if(aff->intensities[i] < aff->intensities[weakest] ||
+           (aff->intensities[i] == aff->intensities[weakest] &&
+            aff->affected[i].source > aff->affected[weakest].source))
+            weakest = i;
+    }
+    return weakest;
+}
+
 static void SB_AddAffected(Affection *aff, uint sourceIdx, float intensity)
 {
     DENG_ASSERT(aff);
@@ -398,14 +666,15 @@ static void SB_AddAffected(Affection *aff, uint sourceIdx, float intensity)
     }
     else
     {
-        // Drop the weakest.
-        uint weakest = 0;
+        // Drop the weakest, if this one is stronger. Equally strong sources
+        // are ordered by index so the result doesn't depend on the order in
+        // which the sources are found.
+        int const weakest = SB_WeakestAffected(aff);
 
-        for(uint i = 1; i < MAX_BIAS_AFFECTED; ++i)
-        {
-            if(aff->intensities[i] < aff->intensities[weakest])
-                weakest = i;
-        }
+        if(intensity < aff->intensities[weakest] ||
+           (intensity == aff->intensities[weakest] &&
+            int(sourceIdx) > aff->affected[weakest].source))
+            return;
 
         aff->affected[weakest].source = sourceIdx;
         aff->intensities[weakest] = intensity;
@@ -432,13 +701,15 @@ void SB_SurfaceInit(BiasSurface &bsuf)
 
 void SB_SurfaceMoved(BiasSurface &bsuf)
 {
+    bsuf.flags |= BSF_AFFECTED_DIRTY;
+
     for(int i = 0; i < MAX_BIAS_AFFECTED && bsuf.affected[i].source >= 0; ++i)
     {
         sources[bsuf.affected[i].source].flags |= BLF_CHANGED;
     }
 }
 
-static float SB_Dot(source_t *src, Vector3d const &point, Vector3f const &normal)
+static float SB_Dot(source_t const *src, Vector3d const &point, Vector3f const &normal)
 {
     DENG_ASSERT(src != 0);
 
@@ -449,37 +720,28 @@ static float SB_Dot(source_t *src, Vector3d const &point, Vector3f const &normal
     return delta.dot(normal);
 }
 
-static void updateAffected(BiasSurface *bsuf, Vector2d const &from,
-                           Vector2d const &to, Vector3f const &normal)
+/**
+ * Estimates the effect of a source on a wall segment.
+ */
+struct SegmentAffection
 {
-    DENG_ASSERT(bsuf != 0);
+    Vector2d from, to;
+    Vector3f normal;
 
-    // If the data is already up to date, nothing needs to be done.
-    if(bsuf->updated == lastChangeOnFrame)
-        return;
-
-    bsuf->updated = lastChangeOnFrame;
-
-    Affection aff;
-    aff.affected = bsuf->affected;
-    aff.numFound = 0;
-    std::memset(aff.affected, -1, sizeof(bsuf->affected));
+    SegmentAffection(Vector2d const &from, Vector2d const &to, Vector3f const &normal)
+        : from(from), to(to), normal(normal) {}
 
-    source_t *src = sources;
-    Vector2f delta;
-    for(int i = 0; i < numSources; ++i, src++)
+    bool operator () (source_t const &src, float &intensity) const
     {
-        if(src->intensity <= 0)
-            continue;
-
         // Calculate minimum 2D distance to the segment.
+        Vector2f delta;
         float distance = 0;
         for(int k = 0; k < 2; ++k)
         {
             if(!k)
-                delta = Vector2f(from - Vector2d(src->origin));
+                delta = Vector2f(from - Vector2d(src.origin));
             else
-                delta = Vector2f(to - Vector2d(src->origin));
+                delta = Vector2f(to - Vector2d(src.origin));
 
             float len = delta.length();
             if(k == 0 || len < distance)
@@ -487,52 +749,40 @@ static void updateAffected(BiasSurface *bsuf, Vector2d const &from,
         }
 
         if(delta.normalize().dot(normal) >= 0)
-            continue;
+            return false;
 
         if(distance < 1)
             distance = 1;
 
-        float intensity = src->intensity / distance;
-
-        // Is the source is too weak, ignore it entirely.
-        if(intensity < biasIgnoreLimit)
-            continue;
-
-        SB_AddAffected(&aff, i, intensity);
+        intensity = src.intensity / distance;
+        return true;
     }
-}
+};
 
-static void updateAffected2(BiasSurface *bsuf, struct rvertex_s const *rvertices,
-    size_t numVertices, Vector3d const &point, Vector3f const &normal)
+/**
+ * Estimates the effect of a source on a BSP leaf plane.
+ */
+struct LeafAffection
 {
-    DENG_ASSERT(bsuf != 0 && rvertices != 0);
-    DENG_UNUSED(numVertices);
-
-    // If the data is already up to date, nothing needs to be done.
-    if(bsuf->updated == lastChangeOnFrame)
-        return;
+    rvertex_s const *rvertices;
+    uint numVertices;
+    Vector3d point;
+    Vector3f normal;
 
-    bsuf->updated = lastChangeOnFrame;
-
-    Affection aff;
-    aff.affected = bsuf->affected;
-    aff.numFound = 0;
-    std::memset(aff.affected, -1, sizeof(bsuf->affected)); // array of MAX_BIAS_AFFECTED
+    LeafAffection(rvertex_s const *rvertices, uint numVertices, Vector3d const &point,
+                  Vector3f const &normal)
+        : rvertices(rvertices), numVertices(numVertices), point(point), normal(normal) {}
 
-    source_t *src = sources;
-    Vector2f delta;
-    for(int i = 0; i < numSources; ++i, src++)
+    bool operator () (source_t const &src, float &intensity) const
     {
-        if(src->intensity <= 0)
-            continue;
-
         // Calculate minimum 2D distance to the BSP leaf.
         /// @todo This is probably too accurate an estimate.
+        Vector2f delta;
         coord_t distance = 0;
-        for(uint k = 0; k < bsuf->size; ++k)
+        for(uint k = 0; k < numVertices; ++k)
         {
             float const *vtxPos = rvertices[k].pos;
-            delta = Vector2d(vtxPos[VX], vtxPos[VY]) - Vector2d(src->origin);
+            delta = Vector2d(vtxPos[VX], vtxPos[VY]) - Vector2d(src.origin);
 
             float len = delta.length();
             if(k == 0 || len < distance)
@@ -542,18 +792,162 @@ static void updateAffected2(BiasSurface *bsuf, struct rvertex_s const *rvertices
             distance = 1;
 
         // Estimate the effect on this surface.
-        float dot = SB_Dot(src, point, normal);
+        float dot = SB_Dot(&src, point, normal);
         if(dot <= 0)
+            return false;
+
+        intensity = src.intensity / distance;
+        return true;
+    }
+};
+
+template <typename Evaluator>
+static void addAffectingInCell(Affection &aff, int cell, Evaluator const &evaluator)
+{
+    for(int k = grid.cellSourceStart[cell]; k < grid.cellSourceStart[cell + 1]; ++k)
+    {
+        int const idx = grid.cellSources[k];
+        if(idx >= numSources) continue; // Deleted since the grid was updated.
+
+        source_t const &src = sources[idx];
+        if(src.intensity <= 0)
             continue;
 
-        float intensity = src->intensity / distance;
+        float intensity;
+        if(!evaluator(src, intensity))
+            continue;
 
         // Is the source is too weak, ignore it entirely.
         if(intensity < biasIgnoreLimit)
             continue;
 
-        SB_AddAffected(&aff, i, intensity);
+        SB_AddAffected(&aff, idx, intensity);
+    }
+}
+
+/**
+ * Determine the sources affecting @a bsuf. The grid cells are searched in
+ * rings around the surface until the remaining sources are too far away to
+ * be stronger than the ones already found.
+ */
+template <typename Evaluator>
+static void findAffectingSources(BiasSurface &bsuf, Evaluator const &evaluator)
+{
+    biasaffection_t oldAffected[MAX_BIAS_AFFECTED];
+    std::memcpy(oldAffected, bsuf.affected, sizeof(oldAffected));
+
+    Affection aff;
+    aff.affected = bsuf.affected;
+    aff.numFound = 0;
+    std::memset(aff.affected, -1, sizeof(bsuf.affected)); // array of MAX_BIAS_AFFECTED
+
+    // Sources outside the grid may be anywhere.
+    addAffectingInCell(aff, gridCellCount(), evaluator);
+
+    int range[4];
+    gridCellRange(bsuf.bounds, range);
+
+    for(int ring = 0; ; ++ring)
+    {
+        if(ring > 1)
+        {
+            // The unvisited cells are at least this far away.
+            double const bound = maxIntensityAt(grid.maxIntensity, (ring - 1) * BIAS_GRID_CELL_SIZE);
+
+            if(bound < biasIgnoreLimit)
+                break;
+
+            if(aff.numFound == MAX_BIAS_AFFECTED &&
+               bound < aff.intensities[SB_WeakestAffected(&aff)])
+                break;
+        }
+
+        int const x0 = range[0] - ring, y0 = range[1] - ring;
+        int const x1 = range[2] + ring, y1 = range[3] + ring;
+
+        for(int y = de::max(y0, 0); y <= de::min(y1, grid.height - 1); ++y)
+        {
+            // Only the edges of the ring are new.
+            bool const edgeRow = (ring == 0 || y == y0 || y == y1);
+            int const step = edgeRow? 1 : x1 - x0;
+
+            for(int x = x0; x <= x1; x += step)
+            {
+                if(x < 0 || x >= grid.width) continue;
+
+                int const cell = y * grid.width + x;
+                if(grid.cells[cell].maxIntensity > 0)
+                {
+                    addAffectingInCell(aff, cell, evaluator);
+                }
+            }
+        }
+
+        // The whole grid visited?
+        if(x0 <= 0 && y0 <= 0 && x1 >= grid.width - 1 && y1 >= grid.height - 1)
+            break;
+    }
+
+    bsuf.affectThreshold = (aff.numFound == MAX_BIAS_AFFECTED?
+                            aff.intensities[SB_WeakestAffected(&aff)] : biasIgnoreLimit);
+
+    if(bsuf.cell >= 0)
+    {
+        float &minThreshold = grid.cells[bsuf.cell].minThreshold;
+        minThreshold = MIN_OF(minThreshold, bsuf.affectThreshold);
+    }
+
+    // Sources that were not affecting the surface before must be evaluated
+    // for all the vertices.
+    for(int i = 0; i < aff.numFound; ++i)
+    {
+        int k;
+        for(k = 0; k < MAX_BIAS_AFFECTED && oldAffected[k].source >= 0; ++k)
+        {
+            if(oldAffected[k].source == aff.affected[i].source)
+                break;
+        }
+        if(k == MAX_BIAS_AFFECTED || oldAffected[k].source < 0)
+        {
+            SB_TrackerMark(&bsuf.tracker, aff.affected[i].source);
+        }
+    }
+}
+
+static void updateAffected(BiasSurface *bsuf, Vector2d const &from,
+                           Vector2d const &to, Vector3f const &normal)
+{
+    DENG_ASSERT(bsuf != 0);
+
+    // If the data is already up to date, nothing needs to be done.
+    if(!(bsuf->flags & BSF_AFFECTED_DIRTY))
+        return;
+
+    bsuf->flags &= ~BSF_AFFECTED_DIRTY;
+
+    if(bsuf->cell < 0)
+    {
+        // The surface may have moved.
+        bsuf->bounds = AABoxd(de::min(from.x, to.x), de::min(from.y, to.y),
+                              de::max(from.x, to.x), de::max(from.y, to.y));
     }
+
+    findAffectingSources(*bsuf, SegmentAffection(from, to, normal));
+}
+
+static void updateAffected2(BiasSurface *bsuf, struct rvertex_s const *rvertices,
+    size_t numVertices, Vector3d const &point, Vector3f const &normal)
+{
+    DENG_ASSERT(bsuf != 0 && rvertices != 0);
+    DENG_UNUSED(numVertices);
+
+    // If the data is already up to date, nothing needs to be done.
+    if(!(bsuf->flags & BSF_AFFECTED_DIRTY))
+        return;
+
+    bsuf->flags &= ~BSF_AFFECTED_DIRTY;
+
+    findAffectingSources(*bsuf, LeafAffection(rvertices, bsuf->size, point, normal));
 }
 
 /**
@@ -629,6 +1023,89 @@ static boolean SB_ChangeInAffected(biasaffection_t *affected, biastracker_t *cha
     return false;
 }
 
+/**
+ * The sources in @a changes have changed in a way that may affect @a bsuf.
+ */
+static void markSurfaceChanged(BiasSurface &bsuf, biastracker_t *changes)
+{
+    bsuf.flags |= BSF_AFFECTED_DIRTY;
+
+    SB_TrackerApply(&bsuf.tracker, changes);
+
+    // Everything that is affected by the changed lights will need an
+    // update.
+    if(SB_ChangeInAffected(bsuf.affected, changes))
+    {
+        // Mark the illumination unseen to force an update.
+        for(uint i = 0; i < bsuf.size; ++i)
+            bsuf.illum[i].flags |= VIF_STILL_UNSEEN;
+    }
+}
+
+/**
+ * Marks the surfaces that a source at @a origin with @a intensity affects or
+ * could affect. These are the only surfaces where the affecting sources may
+ * change when the source changes.
+ */
+static void markSurfacesNear(double const origin[2], float intensity, biastracker_t *changes)
+{
+    if(intensity <= 0) return;
+
+    // Beyond this distance the source is weaker than the ignore limit, which
+    // is the lowest possible threshold of any surface.
+    double const reach = intensity / biasIgnoreLimit + 1
+                       + grid.surfaceOverhang;
+
+    int range[4];
+    gridCellRange(AABoxd(origin[VX] - reach, origin[VY] - reach,
+                         origin[VX] + reach, origin[VY] + reach), range);
+
+    for(int y = range[1]; y <= range[3]; ++y)
+    {
+        for(int x = range[0]; x <= range[2]; ++x)
+        {
+            biasgridcell_t &cell = grid.cells[y * grid.width + x];
+
+            if(!cell.surfaces) continue;
+
+            if(maxIntensityAt(intensity, boxDistance(cell.surfaceBounds, origin[VX], origin[VY]))
+               < cell.minThreshold)
+                continue;
+
+            // The threshold of the cell is updated at the same time.
+            float minThreshold = DDMAXFLOAT;
+            for(BiasSurface *bsuf = cell.surfaces; bsuf; bsuf = bsuf->nextInCell)
+            {
+                minThreshold = MIN_OF(minThreshold, bsuf->affectThreshold);
+
+                if(maxIntensityAt(intensity, boxDistance(bsuf->bounds, origin[VX], origin[VY]))
+                   < bsuf->affectThreshold)
+                    continue;
+
+                markSurfaceChanged(*bsuf, changes);
+            }
+            cell.minThreshold = minThreshold;
+        }
+    }
+}
+
+/**
+ * The affection thresholds of the surfaces and cells depend on the ignore
+ * limit, so they are reset and the affected sources determined again.
+ */
+static void biasIgnoreLimitChanged()
+{
+    for(BiasSurface *bsuf = surfaces; bsuf; bsuf = bsuf->next)
+    {
+        bsuf->affectThreshold = biasIgnoreLimit;
+    }
+    for(int i = 0; grid.cells && i < gridCellCount(); ++i)
+    {
+        grid.cells[i].minThreshold = biasIgnoreLimit;
+    }
+    needFullUpdate = true;
+}
+
 void SB_BeginFrame()
 {
 #ifdef DD_PROFILE
@@ -654,6 +1131,7 @@ BEGIN_PROF( PROF_BIAS_UPDATE );
     // Check which sources have changed.
     biastracker_t allChanges;
     std::memset(&allChanges, 0, sizeof(allChanges));
+    bool changed = false;
 
     source_t *s = sources;
     for(int l = 0; l < numSources; ++l, s++)
@@ -694,24 +1172,41 @@ BEGIN_PROF( PROF_BIAS_UPDATE );
             // This is used for interpolation.
             sources[l].lastUpdateTime = currentTimeSB;
 
-            // Recalculate which sources affect which surfaces.
-            lastChangeOnFrame = frameCount;
+            changed = true;
         }
     }
 
-    // Apply to all surfaces.
-    for(BiasSurface *bsuf = surfaces; bsuf; bsuf = bsuf->next)
+    if(needFullUpdate)
     {
-        SB_TrackerApply(&bsuf->tracker, &allChanges);
+        // Apply to all surfaces.
+        for(BiasSurface *bsuf = surfaces; bsuf; bsuf = bsuf->next)
+        {
+            markSurfaceChanged(*bsuf, &allChanges);
+        }
+        needFullUpdate = false;
+        indexSources();
+    }
+    else if(changed)
+    {
+        // Only the surfaces near the changed sources need an update: the
+        // ones affected before the change and the ones affected after it.
+        for(int l = 0; l < numSources; ++l)
+        {
+            if(!SB_TrackerCheck(&allChanges, l)) continue;
+
+            markSurfacesNear(indexedSources[l].origin, indexedSources[l].intensity, &allChanges);
 
-        // Everything that is affected by the changed lights will need an
-        // update.
-        if(SB_ChangeInAffected(bsuf->affected, &allChanges))
+            double const origin[2] = { sources[l].origin[VX], sources[l].origin[VY] };
+            markSurfacesNear(origin, sources[l].intensity, &allChanges);
+        }
+
+        // Surfaces that move are not indexed.
+        for(BiasSurface *bsuf = grid.unindexed; bsuf; bsuf = bsuf->nextInCell)
         {
-            // Mark the illumination unseen to force an update.
-            for(uint i = 0; i < bsuf->size; ++i)
-                bsuf->illum[i].flags |= VIF_STILL_UNSEEN;
+            markSurfaceChanged(*bsuf, &allChanges);
         }
+
+        indexSources();
     }
 
 END_PROF( PROF_BIAS_UPDATE );
@@ -729,19 +1224,11 @@ void SB_EndFrame()
     SBE_EndFrame();
 }
 
-static void addLight(float dest[4], Vector3f const &color, float howMuch = 1.0f)
+static Vector3f ambientLight(Map &map, Vector3d const &point)
 {
-    DENG_ASSERT(dest != 0);
-
-    for(int i = 0; i < 3; ++i)
-    {
-        float newval = dest[i] + (color[i] * howMuch);
-
-        if(newval > 1)
-            newval = 1;
-
-        dest[i] = newval;
-    }
+    if(map.hasLightGrid())
+        return map.lightGrid().evaluate(point);
+    return Vector3f(0, 0, 0);
 }
 
 void SB_RendPoly(struct ColorRawf_s *rcolors, BiasSurface *bsuf,
@@ -765,9 +1252,6 @@ void SB_RendPoly(struct ColorRawf_s *rcolors, BiasSurface *bsuf,
         biasAmount = 0;
     }
 
-    std::memcpy(&trackChanged, &bsuf->tracker, sizeof(trackChanged));
-    std::memset(&trackApplied, 0, sizeof(trackApplied));
-
     // Has any of the old affected lights changed?
     //bool forced = false;
 
@@ -795,6 +1279,10 @@ void SB_RendPoly(struct ColorRawf_s *rcolors, BiasSurface *bsuf,
         }
     }
 
+    // Newly affecting sources were marked changed in the tracker above.
+    std::memcpy(&trackChanged, &bsuf->tracker, sizeof(trackChanged));
+    std::memset(&trackApplied, 0, sizeof(trackApplied));
+
 /*#if _DEBUG
     // Assign primary colors rather than the real values.
     if(isHEdge)
@@ -807,12 +1295,27 @@ void SB_RendPoly(struct ColorRawf_s *rcolors, BiasSurface *bsuf,
     else
 #endif*/
     {
+        Map &map = App_World().map();
+        ColorRawf *ambient = R_AllocRendColors(numVertices);
+
         for(uint i = 0; i < numVertices; ++i)
         {
             rvertex_t const &vtx = rvertices[i];
+            Vector3d const point(vtx.pos[VX], vtx.pos[VY], vtx.pos[VZ]);
+
             SB_EvalPoint(rcolors[i].rgba, &bsuf->illum[i], bsuf->affected,
-                         Vector3d(vtx.pos[VX], vtx.pos[VY], vtx.pos[VZ]), surfaceNormal);
+                         point, surfaceNormal);
+
+            Vector3f const amb = ambientLight(map, point);
+            ambient[i].rgba[CR] = amb.x;
+            ambient[i].rgba[CG] = amb.y;
+            ambient[i].rgba[CB] = amb.z;
         }
+
+        // Add ambient lighting.
+        R_AddVertexLight(rcolors, ambient, numVertices);
+
+        R_FreeRendColors(ambient);
     }
 
 //    colorOverride = SB_CheckColorOverride(affected);
@@ -907,19 +1410,15 @@ float *SB_GetCasted(vertexillum_t *illum, int sourceIndex,
     return 0;
 }
 
-static Vector3f ambientLight(Map &map, Vector3d const &point)
-{
-    if(map.hasLightGrid())
-        return map.lightGrid().evaluate(point);
-    return Vector3f(0, 0, 0);
-}
-
 /**
  * Applies shadow bias to the given point.  If 'forced' is true, new
  * lighting is calculated regardless of whether the lights affecting the
  * point have changed.  This is needed when there has been world geometry
  * changes. 'illum' is allowed to be NULL.
  *
+ * The ambient light of the point is not included; SB_RendPoly() adds it
+ * for all vertices of the poly at once.
+ *
  * @todo Only recalculate the changed lights.  The colors contributed
  *        by the others can be saved with the 'affected' array.
  */
@@ -997,10 +1496,6 @@ void SB_EvalPoint(float light[4], vertexillum_t *illum,
     {
         // Reuse the previous value.
         lerpIllumination(illum, light);
-
-        // Add ambient lighting.
-        addLight(light, ambientLight(map, point));
-
         return;
     }
 
@@ -1114,8 +1609,5 @@ void SB_EvalPoint(float light[4], vertexillum_t *illum,
         light[CB] = newColor[CB];
     }
 
-    // Add ambient lighting.
-    addLight(light, ambientLight(map, point));
-
 #undef COLOR_CHANGE_THRESHOLD
 }
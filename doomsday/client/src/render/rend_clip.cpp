@@ -35,21 +35,10 @@
 
 using namespace de;
 
-struct RoverNode
-{
-    RoverNode* prev, *next;
-};
-
-struct Rover
-{
-    RoverNode* first;
-    RoverNode* last;
-    RoverNode* rover;
-};
-
 struct ClipNode
 {
-    RoverNode rover;
+    /// Next in the list of unused nodes.
+    ClipNode *nextUnused;
 
     /// Previous and next nodes.
     ClipNode* prev, *next;
@@ -68,7 +57,8 @@ struct ClipNode
 
 struct OccNode
 {
-    RoverNode rover;
+    /// Next in the list of unused nodes.
+    OccNode *nextUnused;
 
     /// Previous and next nodes.
     OccNode* prev, *next;
@@ -96,14 +86,16 @@ static void C_OcclusionLister(void);
 
 int devNoCulling = 0; ///< cvar. Set to 1 to fully disable angle based culling.
 
-/// The list of clipnodes.
-static Rover clipNodes;
+/// Clip nodes removed during the current frame, available for reuse.
+/// New nodes are allocated from the frame arena.
+static ClipNode *unusedClipNodes;
 
 /// Head of the clipped regions list.
 static ClipNode* clipHead; // The head node.
 
-/// The list of occlusion nodes.
-static Rover occNodes;
+/// Occlusion nodes removed during the current frame, available for reuse.
+/// New nodes are allocated from the frame arena.
+static OccNode *unusedOccNodes;
 
 /// Head of the occlusion range list.
 static OccNode* occHead; // The head occlusion node.
@@ -137,88 +129,20 @@ static int C_CountUsedOranges(void)
 }
 #endif
 
-static void C_RoverInit(Rover *rover)
-{
-    std::memset(rover, 0, sizeof(*rover));
-}
-
-static void C_RoverRewind(Rover *r)
-{
-    r->rover = r->first;
-}
-
-static void *C_RoverGet(Rover *r)
-{
-    if(!r->rover) return 0;
-
-    // We'll use this.
-    void *node = r->rover;
-    r->rover = r->rover->next;
-    return node;
-}
-
-static void C_RoverAdd(Rover *r, RoverNode *node)
-{
-    // Link it to the start of the rover's list.
-    if(!r->last)
-        r->last = node;
-    if(r->first)
-        r->first->prev = node;
-
-    node->next = r->first;
-    node->prev = 0;
-    r->first = node;
-}
-
-static void C_RoverRemove(Rover *r, RoverNode *node)
-{
-    DENG_ASSERT(r->last);
-
-    if(node == r->last)
-    {
-        DENG_ASSERT(!r->rover);
-
-        // We can only remove the last if all nodes are already in use.
-        r->rover = node;
-    }
-    else
-    {
-        // Unlink from the list entirely.
-        node->next->prev = node->prev;
-        if(node->prev)
-        {
-            node->prev->next = node->next;
-        }
-        else
-        {
-            r->first = r->first->next;
-            r->first->prev = 0;
-        }
-
-        // Put it back to the end of the list.
-        r->last->next = node;
-        node->prev = r->last;
-        node->next = 0;
-        r->last = node;
-
-        // If all were in use, set the rover here. Otherwise the rover
-        // can stay where it is.
-        if(!r->rover)
-            r->rover = r->last;
-    }
-}
-
 /**
  * Finds the first unused clip node.
  */
 static ClipNode *C_NewRange(binangle_t stAng, binangle_t endAng)
 {
-    ClipNode *node = reinterpret_cast<ClipNode *>(C_RoverGet(&clipNodes));
-    if(!node)
+    ClipNode *node = unusedClipNodes;
+    if(node)
+    {
+        unusedClipNodes = node->nextUnused;
+    }
+    else
     {
-        // Allocate a new node and add it to head the list.
-        node = static_cast<ClipNode *>(Z_Malloc(sizeof(ClipNode), PU_APPSTATIC, 0));
-        C_RoverAdd(&clipNodes, reinterpret_cast<RoverNode *>(node));
+        // Allocate a new node for this frame.
+        node = R_FrameAllocObject<ClipNode>();
     }
 
     // Initialize the node.
@@ -241,8 +165,9 @@ static void C_RemoveRange(ClipNode *node)
         node->next->prev = node->prev;
     node->prev = node->next = 0;
 
-    // Move this node to the free node rover.
-    C_RoverRemove(&clipNodes, reinterpret_cast<RoverNode *>(node));
+    // Move this node to the list of unused nodes.
+    node->nextUnused = unusedClipNodes;
+    unusedClipNodes = node;
 }
 
 static void C_AddRange(binangle_t startAngle, binangle_t endAngle)
@@ -419,12 +344,15 @@ static void C_AddRange(binangle_t startAngle, binangle_t endAngle)
 static OccNode *C_NewOcclusionRange(binangle_t stAng, binangle_t endAng,
     float const normal[3], bool topHalf)
 {
-    OccNode *node = reinterpret_cast<OccNode *>(C_RoverGet(&occNodes));
-    if(!node)
+    OccNode *node = unusedOccNodes;
+    if(node)
+    {
+        unusedOccNodes = node->nextUnused;
+    }
+    else
     {
-        // Allocate a new node.
-        node = static_cast<OccNode *>(Z_Malloc(sizeof(OccNode), PU_APPSTATIC, 0));
-        C_RoverAdd(&occNodes, reinterpret_cast<RoverNode *>(node));
+        // Allocate a new node for this frame.
+        node = R_FrameAllocObject<OccNode>();
     }
 
     node->flags = (topHalf ? OCNF_TOPHALF : 0);
@@ -446,7 +374,10 @@ static void C_RemoveOcclusionRange(OccNode *orange)
     if(orange->next)
         orange->next->prev = orange->prev;
 
-    C_RoverRemove(&occNodes, reinterpret_cast<RoverNode*>(orange));
+    // Move this node to the list of unused nodes. Note that the prev/next
+    // links are left intact for the benefit of the caller.
+    orange->nextUnused = unusedOccNodes;
+    unusedOccNodes = orange;
 }
 
 /**
@@ -753,21 +684,21 @@ static void C_CutOcclusionRange(binangle_t startAngle, binangle_t endAngle)
 
 void C_Init()
 {
-    C_RoverInit(&clipNodes);
-    C_RoverInit(&occNodes);
+    clipHead = 0;
+    unusedClipNodes = 0;
+    occHead = 0;
+    unusedOccNodes = 0;
 }
 
 void C_ClearRanges()
 {
+    // The nodes are allocated from the frame arena; any left over from a
+    // previous view are released when the next frame begins.
     clipHead = 0;
-
-    // Rewind the rover.
-    C_RoverRewind(&clipNodes);
+    unusedClipNodes = 0;
 
     occHead = 0;
-
-    // Rewind the rover.
-    C_RoverRewind(&occNodes);
+    unusedOccNodes = 0;
 }
 
 int C_SafeAddRange(binangle_t startAngle, binangle_t endAngle)
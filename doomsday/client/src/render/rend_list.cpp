@@ -24,6 +24,7 @@
  * 02110-1301 USA</small>
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -43,6 +44,8 @@
 
 #include "render/rend_list.h"
 
+#include <de/GLBuffer>
+
 using namespace de;
 
 BEGIN_PROF_TIMERS()
@@ -57,6 +60,31 @@ BEGIN_PROF_TIMERS()
   PROF_RL_RENDER_SKYMASK
 END_PROF_TIMERS()
 
+/**
+ * GL state changes made while drawing the lists. Counted when profiling and
+ * printed along with the PROF_RL_* timers.
+ */
+enum {
+    SC_LISTS,               ///< Lists drawn.
+    SC_PRIMITIVES,          ///< Primitives drawn.
+    SC_TEXTURE_BINDS,       ///< Textures bound.
+    SC_REDUNDANT_BINDS,     ///< Texture binds skipped (already bound).
+    SC_TEXUNIT_SELECTS,     ///< Texture unit configuration changes.
+    SC_REDUNDANT_SELECTS,   ///< Texture unit configuration changes skipped.
+    NUM_STATE_CHANGE_COUNTERS
+};
+
+#ifdef DD_PROFILE
+static uint stateChanges[NUM_STATE_CHANGE_COUNTERS];
+# define COUNT_STATE_CHANGE(x)  (stateChanges[x]++)
+# define PRINT_STATE_CHANGE(x)  Con_Message("[%f per frame] " #x ": %u", \
+                                    frameCount? stateChanges[x] / (float) frameCount : 0, \
+                                    stateChanges[x])
+#else
+# define COUNT_STATE_CHANGE(x)
+# define PRINT_STATE_CHANGE(x)
+#endif
+
 #define RL_HASH_SIZE        128
 
 // Number of extra bytes to keep allocated in the end of each rendering list.
@@ -235,14 +263,40 @@ static rtexmapunit_t const *rtuMap[NUM_TEXMAP_UNITS];
 // GL texture unit state used during write. Global for performance reasons.
 static rtexmapunit_t const *texunits[NUM_TEXTURE_UNITS];
 
+// Vertex array indices (GL buffers of a vertex store).
+enum {
+    VA_VERTEX,
+    VA_COLOR,
+    VA_TEXCOORD0, // First texture coordinate array (TCA_MAIN).
+    NUM_VERTEX_ARRAYS = VA_TEXCOORD0 + NUM_TEXCOORD_ARRAYS
+};
+
+/**
+ * The vertex arrays referenced by the primitives in the rendering lists.
+ * When vertex buffer objects are available the arrays are uploaded to GL
+ * buffers once per frame, which are drawn from instead of submitting each
+ * vertex.
+ */
+typedef struct vertexstore_s {
+    dgl_vertex_t *vertices;
+    dgl_texcoord_t *texCoords[NUM_TEXCOORD_ARRAYS];
+    dgl_color_t *colors;
+    uint numVertices, maxVertices;
+
+    GLBuffer *buffers[NUM_VERTEX_ARRAYS];
+} vertexstore_t;
+
+/// Vertices written anew each frame.
+static vertexstore_t streamStore;
+
 /**
- * The vertex arrays.
+ * GL texture state while drawing the lists of a pass. Binds and texture unit
+ * changes which would not change anything are skipped.
  */
-static dgl_vertex_t *vertices;
-static dgl_texcoord_t *texCoords[NUM_TEXCOORD_ARRAYS];
-static dgl_color_t *colors;
+static int selectedTexUnits = -1; // -1= unknown.
+static rtexmapunit_texture_t boundTextures[2];
+static bool boundTextureKnown[2];
 
-static uint numVertices, maxVertices;
 static boolean rDrawSky;
 
 /**
@@ -320,10 +374,24 @@ static inline void copyUnit(rendlist_texmapunit_t *ltu, rtexmapunit_t const *rtu
     ltu->opacity = MINMAX_OF(0, rtu->opacity, 1);
 }
 
-static void rlBind(rendlist_texmapunit_t const *tmu)
+static void forgetBoundTextures()
 {
-    DENG2_ASSERT(tmu);
-    if(!tmu->hasTexture()) return;
+    boundTextureKnown[0] = boundTextureKnown[1] = false;
+}
+
+/**
+ * Forget all cached texture state; called when other parts of the engine
+ * may have changed it.
+ */
+static void forgetTextureState()
+{
+    selectedTexUnits = -1;
+    forgetBoundTextures();
+}
+
+static void bindUnitTexture(rendlist_texmapunit_t const *tmu)
+{
+    COUNT_STATE_CHANGE(SC_TEXTURE_BINDS);
 
     if(!renderTextures)
     {
@@ -342,6 +410,20 @@ static void rlBind(rendlist_texmapunit_t const *tmu)
     }
 }
 
+/**
+ * Bind the texture of @a tmu to the active texture unit.
+ */
+static void rlBind(rendlist_texmapunit_t const *tmu)
+{
+    DENG2_ASSERT(tmu);
+    if(!tmu->hasTexture()) return;
+
+    // We don't know which unit is active.
+    forgetBoundTextures();
+
+    bindUnitTexture(tmu);
+}
+
 static void rlBindTo(int unit, rendlist_texmapunit_t const *tmu)
 {
     DENG2_ASSERT(tmu);
@@ -351,7 +433,20 @@ static void rlBindTo(int unit, rendlist_texmapunit_t const *tmu)
     DENG_ASSERT_GL_CONTEXT_ACTIVE();
     glActiveTexture(GL_TEXTURE0 + byte(unit));
 
-    rlBind(tmu);
+    if(unit < 2 && renderTextures)
+    {
+        if(boundTextureKnown[unit] &&
+           compareUnitTexture(&boundTextures[unit], &tmu->texture))
+        {
+            COUNT_STATE_CHANGE(SC_REDUNDANT_BINDS);
+            return;
+        }
+
+        boundTextures[unit]     = tmu->texture;
+        boundTextureKnown[unit] = true;
+    }
+
+    bindUnitTexture(tmu);
 }
 
 static void clearHash(listhash_t *hash)
@@ -394,64 +489,145 @@ boolean RL_IsMTexDetails()
     return IS_MTEX_DETAILS;
 }
 
-static void clearVertices()
+static void clearVertices(vertexstore_t *store)
 {
-    numVertices = 0;
+    store->numVertices = 0;
 }
 
-static void destroyVertices()
+static void destroyVertices(vertexstore_t *store)
 {
-    numVertices = maxVertices = 0;
+    store->numVertices = store->maxVertices = 0;
 
-    if(vertices)
+    if(store->vertices)
     {
-        M_Free(vertices); vertices = 0;
+        M_Free(store->vertices); store->vertices = 0;
     }
 
-    if(colors)
+    if(store->colors)
     {
-        M_Free(colors); colors = 0;
+        M_Free(store->colors); store->colors = 0;
     }
 
     for(uint i = 0; i < NUM_TEXCOORD_ARRAYS; ++i)
     {
-        if(texCoords[i])
+        if(store->texCoords[i])
         {
-            M_Free(texCoords[i]); texCoords[i] = 0;
+            M_Free(store->texCoords[i]); store->texCoords[i] = 0;
         }
     }
+
+    for(uint i = 0; i < NUM_VERTEX_ARRAYS; ++i)
+    {
+        delete store->buffers[i]; store->buffers[i] = 0;
+    }
 }
 
 /**
- * Allocate vertices from the global vertex array.
+ * Allocate vertices from the vertex arrays of @a store.
  */
-static uint allocateVertices(uint count)
+static uint allocateVertices(vertexstore_t *store, uint count)
 {
-    uint base = numVertices;
+    uint base = store->numVertices;
 
     // Do we need to allocate more memory?
-    numVertices += count;
-    while(numVertices > maxVertices)
+    store->numVertices += count;
+    while(store->numVertices > store->maxVertices)
     {
-        if(maxVertices == 0)
+        if(store->maxVertices == 0)
         {
-            maxVertices = 16;
+            store->maxVertices = 16;
         }
         else
         {
-            maxVertices *= 2;
+            store->maxVertices *= 2;
         }
 
-        vertices = (dgl_vertex_t *) M_Realloc(vertices, sizeof(dgl_vertex_t) * maxVertices);
-        colors   = (dgl_color_t *) M_Realloc(colors,   sizeof(dgl_color_t)  * maxVertices);
+        store->vertices = (dgl_vertex_t *) M_Realloc(store->vertices, sizeof(dgl_vertex_t) * store->maxVertices);
+        store->colors   = (dgl_color_t *) M_Realloc(store->colors,   sizeof(dgl_color_t)  * store->maxVertices);
         for(uint i = 0; i < NUM_TEXCOORD_ARRAYS; ++i)
         {
-            texCoords[i] = (dgl_texcoord_t *) M_Realloc(texCoords[i], sizeof(dgl_texcoord_t) * maxVertices);
+            store->texCoords[i] = (dgl_texcoord_t *) M_Realloc(store->texCoords[i], sizeof(dgl_texcoord_t) * store->maxVertices);
         }
     }
     return base;
 }
 
+/**
+ * Upload the vertices of @a store to its GL buffers.
+ */
+static void uploadVertices(vertexstore_t *store)
+{
+    DENG_ASSERT_IN_MAIN_THREAD();
+    DENG_ASSERT_GL_CONTEXT_ACTIVE();
+
+    if(!store->numVertices) return;
+
+    for(uint i = 0; i < NUM_VERTEX_ARRAYS; ++i)
+    {
+        if(!store->buffers[i]) store->buffers[i] = new GLBuffer;
+    }
+
+    uint const count = store->numVertices;
+    store->buffers[VA_VERTEX]->setVertices(count, store->vertices, sizeof(dgl_vertex_t) * count, gl::Stream);
+    store->buffers[VA_COLOR]->setVertices(count, store->colors, sizeof(dgl_color_t) * count, gl::Stream);
+    for(uint i = 0; i < NUM_TEXCOORD_ARRAYS; ++i)
+    {
+        store->buffers[VA_TEXCOORD0 + i]->setVertices(count, store->texCoords[i], sizeof(dgl_texcoord_t) * count, gl::Stream);
+    }
+}
+
+/**
+ * Point the GL vertex arrays to the buffers of @a store. Texture coordinate
+ * arrays are enabled for the units which have been assigned one in @a coords.
+ */
+static void bindVertexArrays(vertexstore_t const *store, int conditions,
+    uint const coords[MAX_TEX_UNITS])
+{
+    DENG_ASSERT(store->buffers[VA_VERTEX]);
+
+    glBindBuffer(GL_ARRAY_BUFFER, store->buffers[VA_VERTEX]->glName());
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(dgl_vertex_t), 0);
+
+    if(!(conditions & DCF_NO_COLOR))
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, store->buffers[VA_COLOR]->glName());
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(dgl_color_t), 0);
+    }
+
+    for(int i = 0; i < numTexUnits && i < MAX_TEX_UNITS; ++i)
+    {
+        glClientActiveTexture(GL_TEXTURE0 + i);
+        if(coords[i])
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, store->buffers[VA_TEXCOORD0 + coords[i] - 1]->glName());
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(2, GL_FLOAT, sizeof(dgl_texcoord_t), 0);
+        }
+        else
+        {
+            glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+    }
+    glClientActiveTexture(GL_TEXTURE0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void unbindVertexArrays()
+{
+    for(int i = 0; i < numTexUnits && i < MAX_TEX_UNITS; ++i)
+    {
+        glClientActiveTexture(GL_TEXTURE0 + i);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    }
+    glClientActiveTexture(GL_TEXTURE0);
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
 static void destroyList(rendlist_t *rl)
 {
     DENG_ASSERT(rl);
@@ -503,7 +679,7 @@ void RL_DeleteLists()
 
     destroyList(&skyMaskList);
 
-    destroyVertices();
+    destroyVertices(&streamStore);
 
 #ifdef DENG_DEBUG
     Z_CheckHeap();
@@ -518,6 +694,12 @@ PRINT_PROF( PROF_RL_RENDER_MASKED );
 PRINT_PROF( PROF_RL_RENDER_SHADOW );
 PRINT_PROF( PROF_RL_RENDER_SHINY );
 PRINT_PROF( PROF_RL_RENDER_SKYMASK );
+PRINT_STATE_CHANGE( SC_LISTS );
+PRINT_STATE_CHANGE( SC_PRIMITIVES );
+PRINT_STATE_CHANGE( SC_TEXTURE_BINDS );
+PRINT_STATE_CHANGE( SC_REDUNDANT_BINDS );
+PRINT_STATE_CHANGE( SC_TEXUNIT_SELECTS );
+PRINT_STATE_CHANGE( SC_REDUNDANT_SELECTS );
 }
 
 /**
@@ -566,7 +748,7 @@ void RL_ClearLists()
     rewindList(&skyMaskList);
 
     // Clear the vertex array.
-    clearVertices();
+    clearVertices(&streamStore);
 
     // @todo Does this belong here?
     rDrawSky = false;
@@ -771,7 +953,7 @@ static void endWrite(rendlist_t *list)
     *(int *) list->cursor = 0;
 }
 
-static void writePrimitive(rendlist_t const *list, uint base,
+static void writePrimitive(vertexstore_t *store, rendlist_t const *list, uint base,
     rvertex_t const *rvertices, rtexcoord_t const *coords,
     rtexcoord_t const *coords1, rtexcoord_t const *coords2,
     ColorRawf const *rcolors, uint numElements, rendpolytype_t type)
@@ -780,7 +962,7 @@ static void writePrimitive(rendlist_t const *list, uint base,
     {
         // Vertex.
         rvertex_t const *rvtx = &rvertices[i];
-        dgl_vertex_t *vtx = &vertices[base + i];
+        dgl_vertex_t *vtx = &store->vertices[base + i];
 
         vtx->xyz[0] = rvtx->pos[VX];
         vtx->xyz[1] = rvtx->pos[VZ];
@@ -793,7 +975,7 @@ static void writePrimitive(rendlist_t const *list, uint base,
         if(TU(list, TU_PRIMARY)->hasTexture())
         {
             rtexcoord_t const *rtc = &coords[i];
-            dgl_texcoord_t *tc = &texCoords[TCA_MAIN][base + i];
+            dgl_texcoord_t *tc = &store->texCoords[TCA_MAIN][base + i];
 
             tc->st[0] = rtc->st[0];
             tc->st[1] = rtc->st[1];
@@ -803,7 +985,7 @@ static void writePrimitive(rendlist_t const *list, uint base,
         if(TU(list, TU_INTER)->hasTexture())
         {
             rtexcoord_t const *rtc = &coords1[i];
-            dgl_texcoord_t *tc = &texCoords[TCA_BLEND][base + i];
+            dgl_texcoord_t *tc = &store->texCoords[TCA_BLEND][base + i];
 
             tc->st[0] = rtc->st[0];
             tc->st[1] = rtc->st[1];
@@ -813,7 +995,7 @@ static void writePrimitive(rendlist_t const *list, uint base,
         if((list->last->flags & PF_IS_LIT) && IS_MTEX_LIGHTS)
         {
             rtexcoord_t const *rtc = &coords2[i];
-            dgl_texcoord_t *tc = &texCoords[TCA_LIGHT][base + i];
+            dgl_texcoord_t *tc = &store->texCoords[TCA_LIGHT][base + i];
 
             tc->st[0] = rtc->st[0];
             tc->st[1] = rtc->st[1];
@@ -821,7 +1003,7 @@ static void writePrimitive(rendlist_t const *list, uint base,
 
         // Color.
         ColorRawf const *rcolor = &rcolors[i];
-        dgl_color_t *color = &colors[base + i];
+        dgl_color_t *color = &store->colors[base + i];
 
         if(rcolors)
         {
@@ -865,7 +1047,8 @@ END_PROF( PROF_RL_GET_LIST );
 
     primSize = numElements;
     numIndices = numElements;
-    base = allocateVertices(primSize);
+
+    base = allocateVertices(&streamStore, primSize);
 
     hdr = (primhdr_t *) allocateData(li, sizeof(primhdr_t));
     DENG_ASSERT(hdr);
@@ -925,7 +1108,7 @@ END_PROF( PROF_RL_GET_LIST );
     li->last->type =
         (type == PT_TRIANGLE_STRIP? GL_TRIANGLE_STRIP : GL_TRIANGLE_FAN);
 
-    writePrimitive(li, base, vertices, primaryCoords, interCoords,
+    writePrimitive(&streamStore, li, base, vertices, primaryCoords, interCoords,
                    modCoords, colors, numElements, polyType);
     endWrite(li);
 
@@ -1215,6 +1398,11 @@ static void drawPrimitives(int conditions, uint coords[MAX_TEX_UNITS],
             bypass = true;
     }
 
+    // Draw from the GL buffers of the vertex store, if available.
+    vertexstore_t const *store = &streamStore;
+    bool const useBuffers = GL_state.features.vertexBufferObjects;
+    bool boundBuffers = false;
+
     // Compile our list of indices.
     primhdr_t *hdr = (primhdr_t *) list->data;
     boolean skip = false;
@@ -1241,6 +1429,8 @@ static void drawPrimitives(int conditions, uint coords[MAX_TEX_UNITS],
                 glActiveTexture((conditions & DCF_SET_LIGHT_ENV0)? GL_TEXTURE0 : GL_TEXTURE1);
                 GL_BindTextureUnmanaged(!renderTextures? 0 : hdr->modTex,
                                         GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+                boundTextureKnown[(conditions & DCF_SET_LIGHT_ENV0)? 0 : 1] = false;
+                COUNT_STATE_CHANGE(SC_TEXTURE_BINDS);
 
                 glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, hdr->modColor);
             }
@@ -1297,20 +1487,34 @@ static void drawPrimitives(int conditions, uint coords[MAX_TEX_UNITS],
                 GL_BlendMode(hdr->blendMode);
             }
 
-            glBegin(hdr->type);
-            for(short i = 0; i < hdr->numIndices; ++i)
+            COUNT_STATE_CHANGE(SC_PRIMITIVES);
+
+            if(useBuffers)
+            {
+                if(!boundBuffers)
+                {
+                    bindVertexArrays(store, conditions, coords);
+                    boundBuffers = true;
+                }
+                glDrawElements(hdr->type, hdr->numIndices, GL_UNSIGNED_INT, hdr->indices);
+            }
+            else
             {
-                uint const index = hdr->indices[i];
-                for(short j = 0; j < numTexUnits; ++j)
+                glBegin(hdr->type);
+                for(short i = 0; i < hdr->numIndices; ++i)
                 {
-                    if(coords[j])
-                        glMultiTexCoord2fv(GL_TEXTURE0 + j, texCoords[coords[j] - 1][index].st);
+                    uint const index = hdr->indices[i];
+                    for(short j = 0; j < numTexUnits; ++j)
+                    {
+                        if(coords[j])
+                            glMultiTexCoord2fv(GL_TEXTURE0 + j, store->texCoords[coords[j] - 1][index].st);
+                    }
+                    if(!(conditions & DCF_NO_COLOR))
+                        glColor4ubv(store->colors[index].rgba);
+                    glVertex3fv(store->vertices[index].xyz);
                 }
-                if(!(conditions & DCF_NO_COLOR))
-                    glColor4ubv(colors[index].rgba);
-                glVertex3fv(vertices[index].xyz);
+                glEnd();
             }
-            glEnd();
 
             // Restore the texture matrix if changed.
             if(conditions & DCF_SET_MATRIX_TEXTURE)
@@ -1349,6 +1553,11 @@ static void drawPrimitives(int conditions, uint coords[MAX_TEX_UNITS],
 
         hdr = (primhdr_t *) ((byte *) hdr + hdr->size);
     }
+
+    if(boundBuffers)
+    {
+        unbindVertexArrays();
+    }
 }
 
 /**
@@ -1359,6 +1568,15 @@ static void selectTexUnits(int count)
     DENG_ASSERT_IN_MAIN_THREAD();
     DENG_ASSERT_GL_CONTEXT_ACTIVE();
 
+    if(count == selectedTexUnits)
+    {
+        COUNT_STATE_CHANGE(SC_REDUNDANT_SELECTS);
+        glActiveTexture(GL_TEXTURE0);
+        return;
+    }
+    selectedTexUnits = count;
+    COUNT_STATE_CHANGE(SC_TEXUNIT_SELECTS);
+
     for(int i = numTexUnits - 1; i >= count; i--)
     {
         glActiveTexture(GL_TEXTURE0 + i);
@@ -1420,7 +1638,7 @@ static int setupListState(listmode_t mode, rendlist_t *list)
         {
             // Normal modulation.
             selectTexUnits(1);
-            rlBind(TU(list, TU_PRIMARY));
+            rlBindTo(0, TU(list, TU_PRIMARY));
             GL_ModulateTexture(1);
         }
         return DCF_SET_MATRIX_TEXTURE0 | (TU(list, TU_INTER)->hasTexture()? DCF_SET_MATRIX_TEXTURE1 : 0);
@@ -1507,7 +1725,7 @@ static int setupListState(listmode_t mode, rendlist_t *list)
         }
         // No modulation at all.
         selectTexUnits(1);
-        rlBind(TU(list, TU_PRIMARY));
+        rlBindTo(0, TU(list, TU_PRIMARY));
         GL_ModulateTexture(0);
         return DCF_SET_MATRIX_TEXTURE0 | (mode == LM_MOD_TEXTURE_MANY_LIGHTS ? DCF_MANY_LIGHTS : 0);
 
@@ -1528,7 +1746,7 @@ static int setupListState(listmode_t mode, rendlist_t *list)
         {
             selectTexUnits(1);
             GL_ModulateTexture(0);
-            rlBind(TU(list, TU_PRIMARY));
+            rlBindTo(0, TU(list, TU_PRIMARY));
             return DCF_SET_MATRIX_TEXTURE0;
         }
         break;
@@ -1560,7 +1778,7 @@ static int setupListState(listmode_t mode, rendlist_t *list)
             // Normal modulation.
             selectTexUnits(1);
             GL_ModulateTexture(1);
-            rlBind(TU(list, TU_PRIMARY));
+            rlBindTo(0, TU(list, TU_PRIMARY));
             return DCF_SET_MATRIX_TEXTURE0;
         }
         break;
@@ -1587,7 +1805,10 @@ static int setupListState(listmode_t mode, rendlist_t *list)
         if(TU(list, TU_PRIMARY)->hasTexture())
             rlBind(TU(list, TU_PRIMARY));
         else
+        {
             GL_BindTextureUnmanaged(0);
+            forgetBoundTextures();
+        }
 
         if(!TU(list, TU_PRIMARY)->hasTexture())
         {
@@ -1961,8 +2182,101 @@ static void setupPassState(listmode_t mode, uint coords[MAX_TEX_UNITS])
     }
 }
 
+/// A list in the draw queue of a pass.
+typedef struct drawitem_s {
+    duint64 key;
+    rendlist_t *list;
+} drawitem_t;
+
+static drawitem_t drawQueue[MAX_RLISTS];
+static drawitem_t drawQueueSorted[MAX_RLISTS];
+
+static inline DGLuint unitTextureName(rendlist_texmapunit_t const *tmu)
+{
+    if(!tmu->hasTexture()) return 0;
+    if(tmu->texture.flags & TUF_TEXTURE_IS_MANAGED)
+    {
+        return tmu->texture.variant? reinterpret_cast<de::Texture::Variant *>(tmu->texture.variant)->glName() : 0;
+    }
+    return tmu->texture.gl.name;
+}
+
 /**
- * Renders the given lists. They must not be empty.
+ * Compose the sort key for drawing @a list in the pass @a mode. Lists are
+ * drawn in ascending key order, so the most expensive state is placed in
+ * the most significant bits:
+ *
+ * - 63..56: Pass (list mode).
+ * - 55..48: Texture unit configuration (which units are in use).
+ * - 47..24: Secondary texture (interpolation target, or primary detail).
+ * - 23..0:  Primary texture.
+ */
+static duint64 listSortKey(listmode_t mode, rendlist_t const *list)
+{
+    rendlist_texmapunit_t const *secondary =
+        TU(list, TU_INTER)->hasTexture()? TU(list, TU_INTER) : TU(list, TU_PRIMARY_DETAIL);
+
+    uint const unitConfig = (TU(list, TU_PRIMARY)->hasTexture()?        0x1 : 0)
+                          | (TU(list, TU_PRIMARY_DETAIL)->hasTexture()? 0x2 : 0)
+                          | (TU(list, TU_INTER)->hasTexture()?          0x4 : 0)
+                          | (TU(list, TU_INTER_DETAIL)->hasTexture()?   0x8 : 0);
+
+    return (duint64(mode & 0xff)                          << 56)
+         | (duint64(unitConfig)                           << 48)
+         | (duint64(unitTextureName(secondary) & 0xffffff) << 24)
+         |  duint64(unitTextureName(TU(list, TU_PRIMARY)) & 0xffffff);
+}
+
+/**
+ * Sort @a items by key using an LSD radix sort with 8-bit digits. The sort is
+ * stable. Digits shared by all the keys are skipped.
+ *
+ * @param items    Items to sort.
+ * @param scratch  Temporary storage for @a num items.
+ * @param num      Number of items.
+ */
+static void radixSortDrawItems(drawitem_t *items, drawitem_t *scratch, uint num)
+{
+    drawitem_t *src = items, *dst = scratch;
+
+    for(int shift = 0; shift < 64; shift += 8)
+    {
+        uint offsets[256];
+        std::memset(offsets, 0, sizeof(offsets));
+
+        for(uint i = 0; i < num; ++i)
+        {
+            offsets[(src[i].key >> shift) & 0xff]++;
+        }
+
+        // All keys have the same digit?
+        if(offsets[(src[0].key >> shift) & 0xff] == num) continue;
+
+        uint total = 0;
+        for(uint d = 0; d < 256; ++d)
+        {
+            uint const count = offsets[d];
+            offsets[d] = total;
+            total += count;
+        }
+
+        for(uint i = 0; i < num; ++i)
+        {
+            dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+        }
+
+        std::swap(src, dst);
+    }
+
+    if(src != items)
+    {
+        std::memcpy(items, src, sizeof(*items) * num);
+    }
+}
+
+/**
+ * Renders the given lists. They must not be empty. The lists are drawn in
+ * sort key order to minimize GL state changes.
  */
 static void renderLists(listmode_t mode, rendlist_t **lists, uint num)
 {
@@ -1970,14 +2284,27 @@ static void renderLists(listmode_t mode, rendlist_t **lists, uint num)
     // all lists to contain something.
     if(!num || !lists[0]->last) return;
 
+    // GL state may have been changed since the previous pass.
+    forgetTextureState();
+
     // Setup GL state that's common to all the lists in this mode.
     uint coords[MAX_TEX_UNITS];
     setupPassState(mode, coords);
 
+    // Compose the draw queue.
+    for(uint i = 0; i < num; ++i)
+    {
+        drawQueue[i].key  = listSortKey(mode, lists[i]);
+        drawQueue[i].list = lists[i];
+    }
+    radixSortDrawItems(drawQueue, drawQueueSorted, num);
+
     // Draw each given list.
     for(uint i = 0; i < num; ++i)
     {
-        rendlist_t *list = lists[i];
+        rendlist_t *list = drawQueue[i].list;
+
+        COUNT_STATE_CHANGE(SC_LISTS);
 
         // Setup GL state for this list, and draw the necessary subset of
         // primitives on the list.
@@ -1988,6 +2315,8 @@ static void renderLists(listmode_t mode, rendlist_t **lists, uint num)
     }
 
     finishPassState(mode);
+
+    forgetTextureState();
 }
 
 /**
@@ -2041,6 +2370,11 @@ BEGIN_PROF( PROF_RL_RENDER_ALL );
             rDrawSky = true;
     }
 
+    if(GL_state.features.vertexBufferObjects)
+    {
+        uploadVertices(&streamStore);
+    }
+
     lists[0] = &skyMaskList;
 
     // Is the sky visible?
@@ -26,6 +26,7 @@
 #include <de/libdeng2.h>
 
 #include <QtAlgorithms>
+#include <QVector>
 
 #include "de_base.h"
 #include "de_console.h"
@@ -176,6 +177,9 @@ static Vector3f currentSectorLightColor;
 static float currentSectorLightLevel;
 static bool firstBspLeaf; // No range checking for the first one.
 
+/// Vertex distances of the world poly being lit (grows to fit the largest).
+static QVector<float> vertexDists;
+
 static void markLightGridForFullUpdate()
 {
     if(App_World().hasMap())
@@ -280,11 +284,15 @@ void Rend_Init()
     C_Init();
     RL_Init();
     Sky_Init();
+
+    LOG_VERBOSE("Vertex lighting kernels: %s") << R_LightKernelName();
 }
 
 void Rend_Shutdown()
 {
     RL_Shutdown();
+    R_ShutdownFrameArena();
+    vertexDists.clear();
 }
 
 /// World/map renderer reset.
@@ -330,19 +338,12 @@ static inline double viewFacingDot(Vector2d const &v1, Vector2d const &v2)
 
 static void Rend_VertexColorsGlow(ColorRawf *colors, uint num, float glow)
 {
-    for(uint i = 0; i < num; ++i)
-    {
-        ColorRawf *c = &colors[i];
-        c->rgba[CR] = c->rgba[CG] = c->rgba[CB] = glow;
-    }
+    R_SetVertexColorRGB(colors, num, glow);
 }
 
 static void Rend_VertexColorsAlpha(ColorRawf *colors, uint num, float alpha)
 {
-    for(uint i = 0; i < num; ++i)
-    {
-        colors[i].rgba[CA] = alpha;
-    }
+    R_SetVertexColorAlpha(colors, num, alpha);
 }
 
 void Rend_ApplyTorchLight(float color[3], float distance)
@@ -472,39 +473,52 @@ Material *Rend_ChooseMapSurfaceMaterial(Surface const &surface)
     return 0;
 }
 
-static void lightVertex(ColorRawf &color, rvertex_t const &vtx, float lightLevel,
-                        Vector3f const &ambientColor)
+/**
+ * Calculate the distances of @a verts to the viewer (see Rend_PointDist2D).
+ */
+static void vertexDistances(uint num, float *dists, rvertex_t const *verts)
 {
-    float const dist = Rend_PointDist2D(vtx.pos);
-    float lightVal = Rend_AttenuateLightLevel(dist, lightLevel);
+    lightkernelview_t view;
+    view.origin[0] = vOrigin[VX];
+    view.origin[1] = vOrigin[VZ];
+    view.side[0]   = viewsidex;
+    view.side[1]   = viewsidey;
 
-    // Add extra light.
-    lightVal += Rend_ExtraLightDelta();
-
-    Rend_ApplyLightAdaptation(lightVal);
-
-    // Mix with the surface color.
-    for(int i = 0; i < 3; ++i)
-    {
-        color.rgba[i] = lightVal * ambientColor[i];
-    }
+    R_VertexDistances(dists, verts, num, &view);
 }
 
-static void lightVertices(uint num, ColorRawf *colors, rvertex_t const *verts,
+static void lightVertices(uint num, ColorRawf *colors, float const *dists,
                           float lightLevel, Vector3f const &ambientColor)
 {
-    for(uint i = 0; i < num; ++i)
-    {
-        lightVertex(colors[i], verts[i], lightLevel, ambientColor);
-    }
+    lightkernellight_t light;
+    light.level       = lightLevel;
+    light.ambient[0]  = ambientColor.x;
+    light.ambient[1]  = ambientColor.y;
+    light.ambient[2]  = ambientColor.z;
+    light.attenuation = rendLightDistanceAttenuation;
+    light.extra       = Rend_ExtraLightDelta();
+    light.adaptation  = lightModRange;
+
+    R_LightVertices(colors, dists, num, &light);
 }
 
-static void torchLightVertices(uint num, ColorRawf *colors, rvertex_t const *verts)
+static void torchLightVertices(uint num, ColorRawf *colors, float const *dists)
 {
-    for(uint i = 0; i < num; ++i)
-    {
-        Rend_ApplyTorchLight(colors[i].rgba, Rend_PointDist2D(verts[i].pos));
-    }
+    ddplayer_t *ddpl = &viewPlayer->shared;
+
+    // Disabled?
+    if(!ddpl->fixedColorMap) return;
+
+    lightkerneltorch_t torch;
+    // Colormap 1 is the brightest. I'm guessing 16 would be the darkest.
+    torch.strength  = (16 - ddpl->fixedColorMap) / 15.0f;
+    torch.color[0]  = torchColor[CR];
+    torch.color[1]  = torchColor[CG];
+    torch.color[2]  = torchColor[CB];
+    torch.additive  = torchAdditive != 0;
+    torch.attenuate = rendLightAttenuateFixedColormap != 0;
+
+    R_TorchLightVertices(colors, dists, num, &torch);
 }
 
 int RIT_FirstDynlightIterator(dynlight_t const *dyn, void *parameters)
@@ -780,9 +794,17 @@ static bool renderWorldPoly(rvertex_t *rvertices, uint numVertices,
     rtexmapunit_t const *shinyMaskRTU     = (useShinySurfaces && !(p.flags & RPF_SKYMASK) && ms.unit(RTU_REFLECTION).hasTexture() && ms.unit(RTU_REFLECTION_MASK).hasTexture())? &ms.unit(RTU_REFLECTION_MASK) : NULL;
 
     ColorRawf *rcolors          = !skyMaskedMaterial? R_AllocRendColors(realNumVertices) : 0;
+    float *dists                = 0;
     rtexcoord_t *primaryCoords  = R_AllocRendTexCoords(realNumVertices);
     rtexcoord_t *interCoords    = interRTU? R_AllocRendTexCoords(realNumVertices) : 0;
 
+    if(!skyMaskedMaterial)
+    {
+        if(vertexDists.size() < int(realNumVertices))
+            vertexDists.resize(realNumVertices);
+        dists = vertexDists.data();
+    }
+
     ColorRawf *shinyColors      = 0;
     rtexcoord_t *shinyTexCoords = 0;
     rtexcoord_t *modCoords      = 0;
@@ -926,6 +948,8 @@ static bool renderWorldPoly(rvertex_t *rvertices, uint numVertices,
             }
             else
             {
+                vertexDistances(numVertices, dists, rvertices);
+
                 float llL = de::clamp(0.f, currentSectorLightLevel + p.surfaceLightLevelDL + p.glowing, 1.f);
                 float llR = de::clamp(0.f, currentSectorLightLevel + p.surfaceLightLevelDR + p.glowing, 1.f);
 
@@ -937,14 +961,12 @@ static bool renderWorldPoly(rvertex_t *rvertices, uint numVertices,
 
                     if(p.isWall && llL != llR)
                     {
-                        lightVertex(rcolors[0], rvertices[0], llL, vColor);
-                        lightVertex(rcolors[1], rvertices[1], llL, vColor);
-                        lightVertex(rcolors[2], rvertices[2], llR, vColor);
-                        lightVertex(rcolors[3], rvertices[3], llR, vColor);
+                        lightVertices(2, rcolors,     dists,     llL, vColor);
+                        lightVertices(2, rcolors + 2, dists + 2, llR, vColor);
                     }
                     else
                     {
-                        lightVertices(numVertices, rcolors, rvertices, llL, vColor);
+                        lightVertices(numVertices, rcolors, dists, llL, vColor);
                     }
                 }
                 else
@@ -952,14 +974,12 @@ static bool renderWorldPoly(rvertex_t *rvertices, uint numVertices,
                     // Use sector light+color only.
                     if(p.isWall && llL != llR)
                     {
-                        lightVertex(rcolors[0], rvertices[0], llL, currentSectorLightColor);
-                        lightVertex(rcolors[1], rvertices[1], llL, currentSectorLightColor);
-                        lightVertex(rcolors[2], rvertices[2], llR, currentSectorLightColor);
-                        lightVertex(rcolors[3], rvertices[3], llR, currentSectorLightColor);
+                        lightVertices(2, rcolors,     dists,     llL, currentSectorLightColor);
+                        lightVertices(2, rcolors + 2, dists + 2, llR, currentSectorLightColor);
                     }
                     else
                     {
-                        lightVertices(numVertices, rcolors, rvertices, llL, currentSectorLightColor);
+                        lightVertices(numVertices, rcolors, dists, llL, currentSectorLightColor);
                     }
                 }
 
@@ -969,15 +989,19 @@ static bool renderWorldPoly(rvertex_t *rvertices, uint numVertices,
                     // Blend sector light+color+surfacecolor
                     Vector3f vColor = (*p.wall.surfaceColor2) * currentSectorLightColor;
 
-                    lightVertex(rcolors[0], rvertices[0], llL, vColor);
-                    lightVertex(rcolors[2], rvertices[2], llR, vColor);
+                    lightVertices(1, rcolors,     dists,     llL, vColor);
+                    lightVertices(1, rcolors + 2, dists + 2, llR, vColor);
                 }
             }
 
             // Apply torch light?
             if(viewPlayer->shared.fixedColorMap)
             {
-                torchLightVertices(numVertices, rcolors, rvertices);
+                if(useBias && p.bsuf)
+                {
+                    vertexDistances(numVertices, dists, rvertices);
+                }
+                torchLightVertices(numVertices, rcolors, dists);
             }
         }
 
@@ -35,9 +35,15 @@
 #include "de_graphics.h"
 #include "de_misc.h"
 
+#include <QHash>
+#include <QList>
+#include <de/GLBuffer>
+#include <de/GLProgram>
+#include <de/GLUniform>
 #include <de/Log>
 #include <de/memory.h>
 
+#include "clientapp.h"
 #include "network/net_main.h" // for gametic
 #include "MaterialSnapshot"
 #include "MaterialVariantSpec"
@@ -51,6 +57,10 @@ using namespace de;
 
 #define MAX_ARRAYS  (2 + MAX_TEX_UNITS)
 
+/// Maximum number of lights affecting a vertex when drawing with shaders
+/// ("rend-model-lights" + 1). Must match the light arrays in model.vsh.
+#define MAX_SHADER_LIGHTS   11
+
 typedef enum rendcmd_e {
     RC_COMMAND_COORDS,
     RC_OTHER_COORDS,
@@ -62,11 +72,142 @@ typedef struct array_s {
     void *data;
 } array_t;
 
+/**
+ * Vertex of a model frame in the GL buffer of the frames.
+ */
+struct ModelFrameVertex
+{
+    Vector3f pos;
+    Vector3f normal;
+};
+
+/**
+ * Vertex format for the texture coordinates of the drawn vertices.
+ */
+struct ModelTexVertex
+{
+    Vector2f texCoord;
+
+    DENG2_DECLARE_VERTEX_FORMAT(1)
+};
+
+internal::AttribSpec const ModelTexVertex::_spec[1] = {
+    { internal::AttribSpec::TexCoord0, 2, GL_FLOAT, false, sizeof(ModelTexVertex), 0 }
+};
+internal::AttribSpecs ModelTexVertex::formatSpec() {
+    return internal::AttribSpecs(_spec, sizeof(_spec)/sizeof(_spec[0]));
+}
+
+/**
+ * GL buffers for drawing a model with shaders. Each distinct pair of model
+ * vertex and texture coordinate in the GL commands becomes a drawn vertex.
+ * The drawn vertices of every frame are uploaded once; the two frames to
+ * interpolate between are chosen with the attribute offsets. All the LODs
+ * share the texture coordinates and draw a range of one index buffer.
+ */
+struct ModelDrawBuffers
+{
+    typedef GLBufferT<ModelTexVertex> TriangleBuffer;
+
+    GLBuffer frames;            ///< Vertices of all the frames, frame after frame.
+    dsize vertexCount;          ///< Number of drawn vertices in each frame.
+    TriangleBuffer triangles;   ///< Texture coordinates, and the triangles of all LODs.
+    duint firstIndex[MAX_LODS]; ///< Start of each LOD's triangles in the indices.
+    int triangleCount[MAX_LODS];
+
+    ModelDrawBuffers() : vertexCount(0)
+    {
+        zap(firstIndex);
+        zap(triangleCount);
+    }
+};
+
+typedef QHash<model_t const *, ModelDrawBuffers *> ModelDrawBufferMap;
+
+/**
+ * Shader program for drawing models. GLUniform has no arrays, so the
+ * locations of the light arrays are looked up when the program is built.
+ */
+struct ModelProgram
+{
+    GLProgram program;
+    GLint uLightVector; ///< -1 if the program does not use the lights.
+    GLint uLightColor;
+    GLint uLightParams;
+
+    ModelProgram() : uLightVector(-1), uLightColor(-1), uLightParams(-1) {}
+};
+
+/**
+ * Shader programs for drawing models, and their uniforms.
+ */
+struct ModelShaders
+{
+    ModelProgram skin;         ///< Lit skin.
+    ModelProgram shiny;        ///< Shiny skin only.
+    ModelProgram shinyMasked;  ///< Shiny skin masked by the alpha of the skin.
+    ModelProgram skinShiny;    ///< Lit skin plus specular shiny skin.
+
+    GLUniform uMvpMatrix;
+    GLUniform uInter;
+    GLUniform uMirror;
+    GLUniform uAmbient;
+    GLUniform uShinyMatrix;
+    GLUniform uShinyColor;
+    GLUniform uLightCount;
+    GLUniform uTex;
+    GLUniform uShinyTex;
+
+    ModelShaders()
+        : uMvpMatrix  ("uMvpMatrix",   GLUniform::Mat4),
+          uInter      ("uInter",       GLUniform::Float),
+          uMirror     ("uMirror",      GLUniform::Float),
+          uAmbient    ("uAmbient",     GLUniform::Vec4),
+          uShinyMatrix("uShinyMatrix", GLUniform::Mat3),
+          uShinyColor ("uShinyColor",  GLUniform::Vec4),
+          uLightCount ("uLightCount",  GLUniform::Int),
+          uTex        ("uTex",         GLUniform::Int),
+          uShinyTex   ("uShinyTex",    GLUniform::Int)
+    {
+        // Skins are bound to the first texture unit, shiny skins to the second.
+        uTex      = 0;
+        uShinyTex = 1;
+
+        build(skin,        "model.skin");
+        build(shiny,       "model.shiny");
+        build(shinyMasked, "model.shiny_masked");
+        build(skinShiny,   "model.skin_shiny");
+    }
+
+    void build(ModelProgram &prog, char const *name)
+    {
+        ClientApp::glShaderBank().build(prog.program, name)
+                << uMvpMatrix << uInter << uMirror << uAmbient << uShinyMatrix
+                << uShinyColor << uLightCount << uTex << uShinyTex;
+
+        GLuint const glName = prog.program.glName();
+        prog.uLightVector = glGetUniformLocation(glName, "uLightVector");
+        prog.uLightColor  = glGetUniformLocation(glName, "uLightColor");
+        prog.uLightParams = glGetUniformLocation(glName, "uLightParams");
+    }
+};
+
+/**
+ * Lights of a submodel, in model space.
+ */
+typedef struct {
+    int count;
+    float vector[MAX_SHADER_LIGHTS][3];
+    float color[MAX_SHADER_LIGHTS][3];
+    float params[MAX_SHADER_LIGHTS][4]; ///< Offset, light side, dark side, affected by ambient.
+} modelshaderlights_t;
+
 int modelLight         = 4;
 int frameInter         = true;
 int mirrorHudModels;
 int modelShinyMultitex = true;
 float modelShinyFactor = 1.0f;
+int modelShaders       = true;
 int modelTriCount;
 float rend_model_lod   = 256;
 
@@ -85,6 +226,14 @@ static float modelCenter[3];
 static int activeLod;
 static char *vertexUsage;
 
+// Drawing with shaders.
+static ModelShaders *shaders;
+static bool shadersFailed; ///< Building the programs failed; use the CPU.
+static ModelDrawBufferMap drawBuffers; ///< @c NULL for models drawn on the CPU.
+static QList<ModelDrawBuffers *> releasedDrawBuffers; ///< Deleted in the main thread.
+static modelshaderlights_t shaderLights;
+static Matrix4f viewMatrix; ///< Projection and view of the model being drawn.
+
 static uint vertexBufferMax; ///< Maximum number of vertices we'll be required to render per submodel.
 static uint vertexBufferSize; ///< Current number of vertices supported by the render buffer.
 #if _DEBUG
@@ -104,6 +253,7 @@ void Rend_ModelRegister()
     C_VAR_FLOAT("rend-model-spin-speed",     &modelSpinSpeed,       CVF_NO_MAX | CVF_NO_MIN, 0, 0);
     C_VAR_INT  ("rend-model-shiny-multitex", &modelShinyMultitex,   0, 0, 1);
     C_VAR_FLOAT("rend-model-shiny-strength", &modelShinyFactor,     0, 0, 10);
+    C_VAR_INT  ("rend-model-shader",         &modelShaders,         0, 0, 1);
 }
 
 boolean Rend_ModelExpandVertexBuffers(uint numVertices)
@@ -629,22 +779,33 @@ typedef struct {
     bool invert;
 } lightmodelvertexparams_t;
 
-static boolean lightModelVertex(vlight_t const *vlight, void *context)
+/**
+ * Transform the vector of @a vlight to model space.
+ */
+static void modelSpaceLightVector(vlight_t const *vlight, float rotateYaw, float rotatePitch,
+    bool invert, float lightVector[3])
 {
-    lightmodelvertexparams_t* parm = (lightmodelvertexparams_t *) context;
-
-    // Take a copy of the light vector as we intend to change it.
-    float lightVector[3] = { vlight->vector[0], vlight->vector[1], vlight->vector[2] };
+    lightVector[VX] = vlight->vector[VX];
+    lightVector[VY] = vlight->vector[VY];
+    lightVector[VZ] = vlight->vector[VZ];
 
-    // We must transform the light vector to model space.
-    M_RotateVector(lightVector, parm->rotateYaw, parm->rotatePitch);
+    M_RotateVector(lightVector, rotateYaw, rotatePitch);
 
     // Quick hack: Flip light normal if model inverted.
-    if(parm->invert)
+    if(invert)
     {
         lightVector[VX] = -lightVector[VX];
         lightVector[VY] = -lightVector[VY];
     }
+}
+
+static boolean lightModelVertex(vlight_t const *vlight, void *context)
+{
+    lightmodelvertexparams_t* parm = (lightmodelvertexparams_t *) context;
+
+    // We must transform the light vector to model space.
+    float lightVector[3];
+    modelSpaceLightVector(vlight, parm->rotateYaw, parm->rotatePitch, parm->invert, lightVector);
 
     float dot = DOTPROD(lightVector, parm->normal->xyz);
     dot += vlight->offset; // Shift a bit towards the light.
@@ -783,6 +944,309 @@ static void Mod_ShinyCoords(int count, dgl_texcoord_t *coords, dgl_vertex_t *nor
     }
 }
 
+typedef struct {
+    float rotateYaw, rotatePitch;
+    int maxLights;
+    bool invert;
+} collectshaderlightsparams_t;
+
+static boolean collectShaderLight(vlight_t const *vlight, void *context)
+{
+    collectshaderlightsparams_t *parm = (collectshaderlightsparams_t *) context;
+    int const idx = shaderLights.count++;
+
+    modelSpaceLightVector(vlight, parm->rotateYaw, parm->rotatePitch, parm->invert,
+                          shaderLights.vector[idx]);
+
+    shaderLights.color[idx][CR] = vlight->color[CR];
+    shaderLights.color[idx][CG] = vlight->color[CG];
+    shaderLights.color[idx][CB] = vlight->color[CB];
+
+    shaderLights.params[idx][0] = vlight->offset;
+    shaderLights.params[idx][1] = vlight->lightSide;
+    shaderLights.params[idx][2] = vlight->darkSide;
+    shaderLights.params[idx][3] = vlight->affectedByAmbient? 1 : 0;
+
+    return shaderLights.count < parm->maxLights; // Continue iteration?
+}
+
+/**
+ * Collect the lights affecting a submodel for the model shaders. This is the
+ * shader counterpart of Mod_VertexColors().
+ */
+static void Mod_ShaderLights(uint vLightListIdx, int maxLights, bool invert,
+    float rotateYaw, float rotatePitch)
+{
+    shaderLights.count = 0;
+    if(!vLightListIdx) return;
+
+    collectshaderlightsparams_t parm;
+    parm.rotateYaw   = rotateYaw;
+    parm.rotatePitch = rotatePitch;
+    parm.maxLights   = MIN_OF(maxLights, MAX_SHADER_LIGHTS);
+    parm.invert      = invert;
+
+    VL_ListIterator(vLightListIdx, &parm, collectShaderLight);
+}
+
+/**
+ * Calculate the rotation applied to the normals for the shiny texture
+ * coordinates. This is the shader counterpart of Mod_ShinyCoords().
+ */
+static Matrix3f Mod_ShinyMatrix(float normYaw, float normPitch, float shinyAng,
+    float shinyPnt, float reactSpeed)
+{
+    // M_RotateVector() is linear, so the columns of the matrix are the
+    // rotated basis vectors.
+    float values[9];
+    for(int i = 0; i < 3; ++i)
+    {
+        float *column = values + 3 * i;
+        column[VX] = column[VY] = column[VZ] = 0;
+        column[i] = 1;
+
+        M_RotateVector(column,
+                       (shinyPnt + normYaw) * 360 * reactSpeed,
+                       (shinyAng + normPitch - .5f) * 180 * reactSpeed);
+    }
+    return Matrix3f(values);
+}
+
+static inline quint64 texCoordKey(float s, float t)
+{
+    quint32 bits[2];
+    std::memcpy(&bits[0], &s, sizeof(s));
+    std::memcpy(&bits[1], &t, sizeof(t));
+    return (quint64(bits[0]) << 32) | bits[1];
+}
+
+/**
+ * Convert the GL commands of the model into indexed triangles and upload all
+ * the frames into GL buffers.
+ *
+ * @return  The buffers, or @c NULL if the model cannot be drawn with shaders.
+ */
+static ModelDrawBuffers *Mod_BuildDrawBuffers(model_t const &mdl)
+{
+    DENG_ASSERT_IN_MAIN_THREAD();
+    DENG_ASSERT_GL_CONTEXT_ACTIVE();
+
+    typedef QPair<int, quint64> DrawnVertexKey; // Model vertex, texture coordinate.
+    QHash<DrawnVertexKey, int> drawnVertices;
+    QVector<int> modelVertex; // Model vertex of each drawn vertex.
+    ModelDrawBuffers::TriangleBuffer::Vertices texCoords;
+    GLBuffer::Indices triangles[MAX_LODS];
+
+    for(int lod = 0; lod < mdl.info.numLODs && lod < MAX_LODS; ++lod)
+    {
+        if(!mdl.lods[lod].glCommands) continue;
+
+        QVector<GLBuffer::Index> prim;
+        byte const *pos = (byte const *) mdl.lods[lod].glCommands;
+        int count;
+        while((count = LONG(*(int const *) pos)) != 0)
+        {
+            pos += 4;
+
+            // The type of primitive depends on the sign.
+            bool const isFan = (count < 0);
+            if(count < 0) count = -count;
+
+            prim.clear();
+            while(count--)
+            {
+                glcommand_vertex_t const *v = (glcommand_vertex_t const *) pos;
+                pos += sizeof(glcommand_vertex_t);
+
+                int const index = LONG(v->index);
+                if(index < 0 || index >= mdl.info.numVertices) return 0;
+
+                float const st[2] = { FLOAT(v->s), FLOAT(v->t) };
+                DrawnVertexKey const key(index, texCoordKey(st[0], st[1]));
+
+                QHash<DrawnVertexKey, int>::const_iterator found = drawnVertices.constFind(key);
+                if(found == drawnVertices.constEnd())
+                {
+                    // Drawn vertices are indexed with 16 bits.
+                    if(modelVertex.size() > DDMAXUSHORT) return 0;
+
+                    ModelTexVertex tv;
+                    tv.texCoord = Vector2f(st);
+                    found = drawnVertices.insert(key, modelVertex.size());
+                    modelVertex.append(index);
+                    texCoords.append(tv);
+                }
+                prim.append(GLBuffer::Index(found.value()));
+            }
+
+            // Split the primitive into triangles, keeping the winding.
+            for(int i = 2; i < prim.size(); ++i)
+            {
+                if(isFan)
+                {
+                    triangles[lod] << prim[0] << prim[i - 1] << prim[i];
+                }
+                else if(i & 1)
+                {
+                    triangles[lod] << prim[i - 1] << prim[i - 2] << prim[i];
+                }
+                else
+                {
+                    triangles[lod] << prim[i - 2] << prim[i - 1] << prim[i];
+                }
+            }
+        }
+    }
+
+    if(modelVertex.isEmpty()) return 0;
+
+    ModelDrawBuffers *bufs = new ModelDrawBuffers;
+    bufs->vertexCount = modelVertex.size();
+
+    QVector<ModelFrameVertex> frameVerts(mdl.info.numFrames * modelVertex.size());
+    ModelFrameVertex *out = frameVerts.data();
+    for(int i = 0; i < mdl.info.numFrames; ++i)
+    {
+        model_frame_t const &frame = mdl.frames[i];
+        for(int k = 0; k < modelVertex.size(); ++k, ++out)
+        {
+            out->pos    = Vector3f(frame.vertices[modelVertex[k]].xyz);
+            out->normal = Vector3f(frame.normals[modelVertex[k]].xyz);
+        }
+    }
+    bufs->frames.setVertices(frameVerts.size(), frameVerts.constData(),
+                             sizeof(ModelFrameVertex) * frameVerts.size(), gl::Static);
+
+    // The texture coordinates are the same for every LOD.
+    GLBuffer::Indices allTriangles;
+    for(int lod = 0; lod < mdl.info.numLODs && lod < MAX_LODS; ++lod)
+    {
+        bufs->firstIndex[lod]    = allTriangles.size();
+        bufs->triangleCount[lod] = triangles[lod].size() / 3;
+        allTriangles += triangles[lod];
+    }
+    bufs->triangles.setVertices(texCoords, gl::Static);
+    bufs->triangles.setIndices(gl::Triangles, allTriangles, gl::Static);
+
+    return bufs;
+}
+
+static void Mod_DeleteReleasedDrawBuffers()
+{
+    qDeleteAll(releasedDrawBuffers);
+    releasedDrawBuffers.clear();
+}
+
+void Rend_ModelReleaseBuffers(model_t const &mdl)
+{
+    ModelDrawBufferMap::iterator found = drawBuffers.find(&mdl);
+    if(found == drawBuffers.end()) return;
+
+    if(found.value())
+    {
+        releasedDrawBuffers.append(found.value());
+    }
+    drawBuffers.erase(found);
+}
+
+/**
+ * Returns the shader programs for drawing models, or @c NULL if models are
+ * to be drawn on the CPU.
+ */
+static ModelShaders *Mod_Shaders()
+{
+    if(!modelShaders || shadersFailed) return 0;
+
+    // Fog and untextured drawing are only implemented on the CPU.
+    if(usingFog || !renderTextures) return 0;
+
+    if(!shaders)
+    {
+        try
+        {
+            shaders = new ModelShaders;
+        }
+        catch(Error const &er)
+        {
+            LOG_WARNING("Failed to build the model shaders, models will be drawn without them:\n%s")
+                << er.asText();
+            delete shaders; shaders = 0;
+            shadersFailed = true;
+        }
+    }
+    return shaders;
+}
+
+/**
+ * Returns the GL buffers for drawing @a mdl with shaders, building them the
+ * first time the model is drawn.
+ */
+static ModelDrawBuffers *Mod_DrawBuffers(model_t const &mdl)
+{
+    ModelDrawBufferMap::const_iterator found = drawBuffers.constFind(&mdl);
+    if(found != drawBuffers.constEnd())
+    {
+        return found.value();
+    }
+
+    ModelDrawBuffers *bufs = Mod_BuildDrawBuffers(mdl);
+    drawBuffers.insert(&mdl, bufs);
+    return bufs;
+}
+
+static void enableFrameAttrib(internal::AttribSpec::Semantic semantic, dsize offset)
+{
+    glEnableVertexAttribArray(GLuint(semantic));
+    glVertexAttribPointer(GLuint(semantic), 3, GL_FLOAT, GL_FALSE, sizeof(ModelFrameVertex),
+                          (void const *) dintptr(offset));
+}
+
+/**
+ * Draw a LOD of the model with a shader program, interpolating between two
+ * frames. The uniforms have already been set up.
+ */
+static void Mod_DrawWithShader(ModelDrawBuffers &bufs, ModelProgram &prog, int lod,
+    int frame, int nextFrame)
+{
+    DENG_ASSERT_IN_MAIN_THREAD();
+    DENG_ASSERT_GL_CONTEXT_ACTIVE();
+
+    using internal::AttribSpec;
+
+    if(!bufs.triangleCount[lod]) return;
+
+    dsize const frameSize = sizeof(ModelFrameVertex) * bufs.vertexCount;
+
+    glBindBuffer(GL_ARRAY_BUFFER, bufs.frames.glName());
+    enableFrameAttrib(AttribSpec::Position,       frameSize * frame);
+    enableFrameAttrib(AttribSpec::Normal,         frameSize * frame + sizeof(Vector3f));
+    enableFrameAttrib(AttribSpec::TargetPosition, frameSize * nextFrame);
+    enableFrameAttrib(AttribSpec::TargetNormal,   frameSize * nextFrame + sizeof(Vector3f));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    prog.program.beginUse();
+
+    // GLUniform has no arrays; the lights are given directly. The location is
+    // -1 (ignored) if the program does not use the lights.
+    if(shaderLights.count > 0)
+    {
+        glUniform3fv(prog.uLightVector, shaderLights.count, shaderLights.vector[0]);
+        glUniform3fv(prog.uLightColor,  shaderLights.count, shaderLights.color[0]);
+        glUniform4fv(prog.uLightParams, shaderLights.count, shaderLights.params[0]);
+    }
+
+    bufs.triangles.draw(bufs.firstIndex[lod], bufs.triangleCount[lod] * 3);
+    prog.program.endUse();
+
+    glDisableVertexAttribArray(GLuint(AttribSpec::Position));
+    glDisableVertexAttribArray(GLuint(AttribSpec::Normal));
+    glDisableVertexAttribArray(GLuint(AttribSpec::TargetPosition));
+    glDisableVertexAttribArray(GLuint(AttribSpec::TargetNormal));
+
+    // Increment the total model triangle counter.
+    modelTriCount += bufs.triangleCount[lod];
+}
+
 static int chooseSelSkin(modeldef_t *mf, int submodel, int selector)
 {
     if(mf->def->hasSub(submodel))
@@ -860,6 +1324,48 @@ texturevariantspecification_t &Rend_ModelShinyTextureSpec()
                                  false, false, false, false);
 }
 
+/**
+ * Composes the transformation from the space of a submodel to world space.
+ */
+static Matrix4f Mod_SubModelMatrix(rendmodelparams_t const *parm, modeldef_t *mf,
+    modeldef_t *mfNext, submodeldef_t *smf, float inter, int zSign)
+{
+    // Model space => World space
+    Matrix4f mat = Matrix4f::translate(
+        Vector3f(parm->origin[VX] + parm->srvo[VX] +
+                   Mod_Lerp(mf->offset[VX], mfNext->offset[VX], inter),
+                 parm->origin[VZ] + parm->srvo[VZ] +
+                   Mod_Lerp(mf->offset[VY], mfNext->offset[VY], inter),
+                 parm->origin[VY] + parm->srvo[VY] + zSign *
+                   Mod_Lerp(mf->offset[VZ], mfNext->offset[VZ], inter)));
+
+    if(parm->extraYawAngle || parm->extraPitchAngle)
+    {
+        // Sky models have an extra rotation.
+        mat = mat * Matrix4f::scale(Vector3f(1, 200 / 240.0f, 1))
+                  * Matrix4f::rotate(parm->extraYawAngle,   Vector3f(1, 0, 0))
+                  * Matrix4f::rotate(parm->extraPitchAngle, Vector3f(0, 0, 1))
+                  * Matrix4f::scale(Vector3f(1, 240 / 200.0f, 1));
+    }
+
+    // Model rotation.
+    mat = mat * Matrix4f::rotate(parm->viewAlign ? parm->yawAngleOffset : parm->yaw,
+                                 Vector3f(0, 1, 0))
+              * Matrix4f::rotate(parm->viewAlign ? parm->pitchAngleOffset : parm->pitch,
+                                 Vector3f(0, 0, 1));
+
+    // Scaling and model space offset.
+    mat = mat * Matrix4f::scale(Vector3f(Mod_Lerp(mf->scale[VX], mfNext->scale[VX], inter),
+                                         Mod_Lerp(mf->scale[VY], mfNext->scale[VY], inter),
+                                         Mod_Lerp(mf->scale[VZ], mfNext->scale[VZ], inter)));
+    if(parm->extraScale)
+    {
+        // Particle models have an extra scale.
+        mat = mat * Matrix4f::scale(parm->extraScale);
+    }
+    return mat * Matrix4f::translate(Vector3f(smf->offset[VX], smf->offset[VY], smf->offset[VZ]));
+}
+
 /**
  * Render a submodel from the vissprite.
  */
@@ -877,6 +1383,8 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
     float shininess, *shinyColor;
     float normYaw, normPitch, shinyAng, shinyPnt;
     float inter = parm->inter;
+    ModelShaders *progs = 0;
+    ModelDrawBuffers *bufs = 0;
     blendmode_t blending;
     Texture::Variant *skinTexture = NULL, *shinyTexture = NULL;
     int zSign = (parm->mirror? -1 : 1);
@@ -963,42 +1471,10 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
     }
 
     // Setup transformation.
+    Matrix4f const modelMatrix = Mod_SubModelMatrix(parm, mf, mfNext, smf, inter, zSign);
     glMatrixMode(GL_MODELVIEW);
     glPushMatrix();
-
-    // Model space => World space
-    glTranslatef(parm->origin[VX] + parm->srvo[VX] +
-                   Mod_Lerp(mf->offset[VX], mfNext->offset[VX], inter),
-                 parm->origin[VZ] + parm->srvo[VZ] +
-                   Mod_Lerp(mf->offset[VY], mfNext->offset[VY], inter),
-                 parm->origin[VY] + parm->srvo[VY] + zSign *
-                   Mod_Lerp(mf->offset[VZ], mfNext->offset[VZ], inter));
-
-    if(parm->extraYawAngle || parm->extraPitchAngle)
-    {
-        // Sky models have an extra rotation.
-        glScalef(1, 200 / 240.0f, 1);
-        glRotatef(parm->extraYawAngle, 1, 0, 0);
-        glRotatef(parm->extraPitchAngle, 0, 0, 1);
-        glScalef(1, 240 / 200.0f, 1);
-    }
-
-    // Model rotation.
-    glRotatef(parm->viewAlign ? parm->yawAngleOffset : parm->yaw,
-              0, 1, 0);
-    glRotatef(parm->viewAlign ? parm->pitchAngleOffset : parm->pitch,
-              0, 0, 1);
-
-    // Scaling and model space offset.
-    glScalef(Mod_Lerp(mf->scale[VX], mfNext->scale[VX], inter),
-             Mod_Lerp(mf->scale[VY], mfNext->scale[VY], inter),
-             Mod_Lerp(mf->scale[VZ], mfNext->scale[VZ], inter));
-    if(parm->extraScale)
-    {
-        // Particle models have an extra scale.
-        glScalef(parm->extraScale, parm->extraScale, parm->extraScale);
-    }
-    glTranslatef(smf->offset[VX], smf->offset[VY], smf->offset[VZ]);
+    glMultMatrixf(modelMatrix.values());
 
     /**
      * Now we can draw.
@@ -1025,15 +1501,25 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
         vertexUsage = NULL;
     }
 
-    // Interpolate vertices and normals.
-    Mod_LerpVertices(inter, numVerts, frame->vertices, nextFrame->vertices,
-                     modelVertices);
-    Mod_LerpVertices(inter, numVerts, frame->normals, nextFrame->normals,
-                     modelNormals);
-    if(zSign < 0)
+    // When drawing with shaders, the interpolation, lighting and shiny
+    // coordinates are calculated on the GPU.
+    if((progs = Mod_Shaders()) != 0)
+    {
+        bufs = Mod_DrawBuffers(*mdl);
+    }
+
+    if(!bufs)
     {
-        Mod_MirrorVertices(numVerts, modelVertices, VZ);
-        Mod_MirrorVertices(numVerts, modelNormals, VY);
+        // Interpolate vertices and normals.
+        Mod_LerpVertices(inter, numVerts, frame->vertices, nextFrame->vertices,
+                         modelVertices);
+        Mod_LerpVertices(inter, numVerts, frame->normals, nextFrame->normals,
+                         modelNormals);
+        if(zSign < 0)
+        {
+            Mod_MirrorVertices(numVerts, modelVertices, VZ);
+            Mod_MirrorVertices(numVerts, modelNormals, VY);
+        }
     }
 
     // Coordinates to the center of the model (game coords).
@@ -1043,11 +1529,15 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
                         mf->offset[VY];
 
     // Calculate lighting.
+    shaderLights.count = 0;
     if(smf->testFlag(MFF_FULLBRIGHT) && !smf->testFlag(MFF_DIM))
     {
         // Submodel-specific lighting override.
         ambient[CR] = ambient[CG] = ambient[CB] = ambient[CA] = 1;
-        Mod_FullBrightVertexColors(numVerts, modelColors, alpha);
+        if(!bufs)
+        {
+            Mod_FullBrightVertexColors(numVerts, modelColors, alpha);
+        }
     }
     else if(!parm->vLightListIdx)
     {
@@ -1056,7 +1546,10 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
         ambient[CG] = parm->ambientColor[CG];
         ambient[CB] = parm->ambientColor[CB];
         ambient[CA] = alpha;
-        Mod_FixedVertexColors(numVerts, modelColors, ambient);
+        if(!bufs)
+        {
+            Mod_FixedVertexColors(numVerts, modelColors, ambient);
+        }
     }
     else
     {
@@ -1066,10 +1559,19 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
         ambient[CB] = parm->ambientColor[CB];
         ambient[CA] = alpha;
 
-        Mod_VertexColors(numVerts, modelColors, modelNormals,
-                         parm->vLightListIdx, modelLight + 1, ambient,
-                         mf->scale[VY] < 0? true: false,
-                         -parm->yaw, -parm->pitch);
+        if(bufs)
+        {
+            Mod_ShaderLights(parm->vLightListIdx, modelLight + 1,
+                             mf->scale[VY] < 0? true: false,
+                             -parm->yaw, -parm->pitch);
+        }
+        else
+        {
+            Mod_VertexColors(numVerts, modelColors, modelNormals,
+                             parm->vLightListIdx, modelLight + 1, ambient,
+                             mf->scale[VY] < 0? true: false,
+                             -parm->yaw, -parm->pitch);
+        }
     }
 
     shininess = 0;
@@ -1131,9 +1633,17 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
             shinyPnt = QATAN2(delta[VY], delta[VX]) / (2 * PI);
         }
 
-        Mod_ShinyCoords(numVerts, modelTexCoords, modelNormals, normYaw,
-                        normPitch, shinyAng, shinyPnt,
-                        mf->def->sub(number).shinyReact);
+        if(bufs)
+        {
+            progs->uShinyMatrix = Mod_ShinyMatrix(normYaw, normPitch, shinyAng, shinyPnt,
+                                                  mf->def->sub(number).shinyReact);
+        }
+        else
+        {
+            Mod_ShinyCoords(numVerts, modelTexCoords, modelNormals, normYaw,
+                            normPitch, shinyAng, shinyPnt,
+                            mf->def->sub(number).shinyReact);
+        }
 
         // Shiny color.
         if(smf->testFlag(MFF_SHINY_LIT))
@@ -1169,6 +1679,17 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
         }
     }
 
+    if(bufs)
+    {
+        progs->uMvpMatrix  = viewMatrix * modelMatrix;
+        progs->uInter      = inter;
+        progs->uMirror     = float(zSign);
+        progs->uAmbient    = Vector4f(ambient[CR], ambient[CG], ambient[CB], alpha);
+        progs->uLightCount = shaderLights.count;
+    }
+    int const frameIdx     = frame - mdl->frames;
+    int const nextFrameIdx = nextFrame - mdl->frames;
+
     // If we mirror the model, triangles have a different orientation.
     if(zSign < 0)
     {
@@ -1194,9 +1715,16 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
             GL_BlendMode(blending);
             GL_BindTexture(renderTextures? skinTexture : 0);
 
-            Mod_RenderCommands(RC_COMMAND_COORDS,
-                               mdl->lods[activeLod].glCommands, /*numVerts,*/
-                               modelVertices, modelColors, NULL);
+            if(bufs)
+            {
+                Mod_DrawWithShader(*bufs, progs->skin, activeLod, frameIdx, nextFrameIdx);
+            }
+            else
+            {
+                Mod_RenderCommands(RC_COMMAND_COORDS,
+                                   mdl->lods[activeLod].glCommands, /*numVerts,*/
+                                   modelVertices, modelColors, NULL);
+            }
         }
 
         if(shininess > 0)
@@ -1210,7 +1738,14 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
                 GL_BlendMode(BM_NORMAL);
 
             // Shiny color.
-            Mod_FixedVertexColors(numVerts, modelColors, color);
+            if(bufs)
+            {
+                progs->uShinyColor = Vector4f(color);
+            }
+            else
+            {
+                Mod_FixedVertexColors(numVerts, modelColors, color);
+            }
 
             if(numTexUnits > 1 && modelShinyMultitex)
             {
@@ -1225,9 +1760,16 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
                 glActiveTexture(GL_TEXTURE0);
                 GL_BindTexture(renderTextures? skinTexture : 0);
 
-                Mod_RenderCommands(RC_BOTH_COORDS,
-                                   mdl->lods[activeLod].glCommands, /*numVerts,*/
-                                   modelVertices, modelColors, modelTexCoords);
+                if(bufs)
+                {
+                    Mod_DrawWithShader(*bufs, progs->shinyMasked, activeLod, frameIdx, nextFrameIdx);
+                }
+                else
+                {
+                    Mod_RenderCommands(RC_BOTH_COORDS,
+                                       mdl->lods[activeLod].glCommands, /*numVerts,*/
+                                       modelVertices, modelColors, modelTexCoords);
+                }
 
                 Mod_SelectTexUnits(1);
                 GL_ModulateTexture(1);
@@ -1238,9 +1780,16 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
                 Mod_SelectTexUnits(1);
                 GL_BindTexture(renderTextures? shinyTexture : 0);
 
-                Mod_RenderCommands(RC_OTHER_COORDS,
-                                   mdl->lods[activeLod].glCommands, /*numVerts,*/
-                                   modelVertices, modelColors, modelTexCoords);
+                if(bufs)
+                {
+                    Mod_DrawWithShader(*bufs, progs->shiny, activeLod, frameIdx, nextFrameIdx);
+                }
+                else
+                {
+                    Mod_RenderCommands(RC_OTHER_COORDS,
+                                       mdl->lods[activeLod].glCommands, /*numVerts,*/
+                                       modelVertices, modelColors, modelTexCoords);
+                }
             }
         }
     }
@@ -1265,9 +1814,17 @@ static void Mod_RenderSubModel(uint number, rendmodelparams_t const *parm)
         glActiveTexture(GL_TEXTURE0);
         GL_BindTexture(renderTextures? skinTexture : 0);
 
-        Mod_RenderCommands(RC_BOTH_COORDS, mdl->lods[activeLod].glCommands,
-                           /*numVerts,*/ modelVertices, modelColors,
-                           modelTexCoords);
+        if(bufs)
+        {
+            progs->uShinyColor = Vector4f(color);
+            Mod_DrawWithShader(*bufs, progs->skinShiny, activeLod, frameIdx, nextFrameIdx);
+        }
+        else
+        {
+            Mod_RenderCommands(RC_BOTH_COORDS, mdl->lods[activeLod].glCommands,
+                               /*numVerts,*/ modelVertices, modelColors,
+                               modelTexCoords);
+        }
 
         Mod_SelectTexUnits(1);
         GL_ModulateTexture(1);
@@ -1316,6 +1873,16 @@ void Rend_ModelShutdown()
 {
     if(!inited) return;
 
+    Mod_DeleteReleasedDrawBuffers();
+    DENG2_FOR_EACH(ModelDrawBufferMap, i, drawBuffers)
+    {
+        delete i.value();
+    }
+    drawBuffers.clear();
+
+    delete shaders; shaders = 0;
+    shadersFailed = false;
+
     if(modelVertices)
     {
         M_Free(modelVertices);
@@ -1359,6 +1926,20 @@ void Rend_RenderModel(rendmodelparams_t const *parm)
 
     if(!parm || !parm->mf) return;
 
+    // Buffers of destroyed models are deleted here, where the GL context
+    // is available.
+    Mod_DeleteReleasedDrawBuffers();
+
+    if(Mod_Shaders())
+    {
+        // The view is read back once per model. The transformations of the
+        // submodels are composed on the CPU.
+        float projMatrix[16], modelViewMatrix[16];
+        glGetFloatv(GL_PROJECTION_MATRIX, projMatrix);
+        glGetFloatv(GL_MODELVIEW_MATRIX, modelViewMatrix);
+        viewMatrix = Matrix4f(projMatrix) * Matrix4f(modelViewMatrix);
+    }
+
     // Render all the submodels of this model.
     for(uint i = 0; i < parm->mf->subCount(); ++i)
     {
@@ -20,6 +20,8 @@
  */
 
 #include <stdlib.h>
+#include <cstring>
+#include <algorithm>
 
 #include "de_base.h"
 #include "de_console.h"
@@ -60,6 +62,7 @@ static byte visiblePtcGens[Generators::GENERATORS_MAX];
 
 static size_t orderSize = 0;
 static porder_t *order = NULL;
+static porder_t *orderTemp = NULL; // Work buffer for sorting.
 
 // Currently active Generators collection. Global for performance.
 static Generators *gens;
@@ -258,14 +261,65 @@ void Rend_ParticleMarkInSectorVisible(Sector *sector)
 }
 
 /**
- * Sorts in descending order.
+ * The bit pattern of a positive float has the same order as the value itself,
+ * so the distance is used as is for the sort key.
  */
-static int C_DECL comparePOrder(const void* pt1, const void* pt2)
+static inline uint32_t depthSortKey(porder_t const* slot)
 {
-    if(((porder_t *) pt1)->distance > ((porder_t *) pt2)->distance) return -1;
-    else if(((porder_t *) pt1)->distance < ((porder_t *) pt2)->distance) return 1;
-    // Highly unlikely (but possible)...
-    return 0;
+    uint32_t bits;
+    std::memcpy(&bits, &slot->distance, sizeof(bits));
+    return ~bits; // Descending order.
+}
+
+/**
+ * Sorts the order buffer in descending order of distance with a stable
+ * LSD radix sort.
+ */
+static void sortOrderBuffer()
+{
+#define RADIX_BITS      11
+#define RADIX_SIZE      (1 << RADIX_BITS)
+
+    size_t offsets[RADIX_SIZE];
+    porder_t* from = order;
+    porder_t* to = orderTemp;
+
+    for(int shift = 0; shift < 32; shift += RADIX_BITS)
+    {
+        size_t i;
+
+        de::zap(offsets);
+        for(i = 0; i < numParts; ++i)
+        {
+            offsets[(depthSortKey(&from[i]) >> shift) & (RADIX_SIZE - 1)]++;
+        }
+
+        // If all keys have the same digit, this pass would not change anything.
+        if(offsets[(depthSortKey(&from[0]) >> shift) & (RADIX_SIZE - 1)] == numParts)
+            continue;
+
+        size_t total = 0;
+        for(i = 0; i < RADIX_SIZE; ++i)
+        {
+            size_t const count = offsets[i];
+            offsets[i] = total;
+            total += count;
+        }
+
+        for(i = 0; i < numParts; ++i)
+        {
+            to[offsets[(depthSortKey(&from[i]) >> shift) & (RADIX_SIZE - 1)]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+
+    if(from != order)
+    {
+        std::memcpy(order, from, sizeof(porder_t) * numParts);
+    }
+
+#undef RADIX_SIZE
+#undef RADIX_BITS
 }
 
 /**
@@ -286,7 +340,10 @@ static void checkOrderBuffer(size_t max)
     }
 
     if(orderSize > currentSize)
+    {
         order = (porder_t *) Z_Realloc(order, sizeof(porder_t) * orderSize, PU_APPSTATIC);
+        orderTemp = (porder_t *) Z_Realloc(orderTemp, sizeof(porder_t) * orderSize, PU_APPSTATIC);
+    }
 }
 
 static int countParticles(ptcgen_t* gen, void* parameters)
@@ -403,8 +460,8 @@ static int listVisibleParticles()
     // This is the real number of possibly visible particles.
     numParts = numVisibleParticles;
 
-    // Sort the order list back->front. A quicksort is fast enough.
-    qsort(order, numParts, sizeof(porder_t), comparePOrder);
+    // Sort the order list back->front.
+    sortOrderBuffer();
 
     return true;
 }
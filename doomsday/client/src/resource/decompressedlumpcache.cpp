@@ -0,0 +1,210 @@
+/** @file decompressedlumpcache.cpp Shared cache of decompressed lumps.
+ *
+ * @authors Copyright &copy; 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include "de_base.h"
+#include "resource/decompressedlumpcache.h"
+
+#include <list>
+#include <cstring> // memcpy
+#include <QHash>
+#include <QPair>
+#include <de/Guard>
+#include <de/Lockable>
+#include <de/memory.h>
+
+namespace de {
+
+/// Total size of the cached data before unlocked entries are freed.
+static size_t const MAXIMUM_CACHED_BYTES = 64 * 1024 * 1024;
+
+namespace internal {
+
+struct CachedLump
+{
+    File1 const* container;
+    int lumpIdx;
+    uint8_t* data;
+    size_t size;
+    int lockCount; ///< Number of users holding the data; evictable at zero.
+};
+
+typedef std::list<CachedLump> CachedLumps; // Most recently used first.
+typedef QPair<File1 const*, int> CachedLumpKey;
+
+struct CachedLumpIndex : public Lockable
+{
+    CachedLumps lumps;
+    QHash<CachedLumpKey, CachedLumps::iterator> index;
+    size_t totalSize;
+
+    CachedLumpIndex() : totalSize(0) {}
+
+    ~CachedLumpIndex()
+    {
+        DENG2_FOR_EACH(CachedLumps, i, lumps)
+        {
+            M_Free(i->data);
+        }
+    }
+
+    /// Finds a cached lump and marks it the most recently used.
+    CachedLump* find(File1 const& container, int lumpIdx)
+    {
+        QHash<CachedLumpKey, CachedLumps::iterator>::iterator found =
+                index.find(CachedLumpKey(&container, lumpIdx));
+        if(found == index.end()) return 0;
+
+        lumps.splice(lumps.begin(), lumps, found.value());
+        return &lumps.front();
+    }
+
+    void release(CachedLumps::iterator i)
+    {
+        totalSize -= i->size;
+        M_Free(i->data);
+        index.remove(CachedLumpKey(i->container, i->lumpIdx));
+        lumps.erase(i);
+    }
+
+    /// Frees the least recently used unlocked lumps until within the limit.
+    void evict()
+    {
+        CachedLumps::iterator i = lumps.end();
+        while(totalSize > MAXIMUM_CACHED_BYTES && i != lumps.begin())
+        {
+            CachedLumps::iterator victim = --i;
+            if(victim->lockCount > 0) continue;
+
+            ++i; // Continue from the lump following the victim.
+            release(victim);
+        }
+    }
+};
+
+static CachedLumpIndex& cachedLumps()
+{
+    static CachedLumpIndex cached;
+    return cached;
+}
+
+} // namespace internal
+
+using namespace internal;
+
+uint8_t const* DecompressedLumpCache::lock(File1 const& container, int lumpIdx)
+{
+    CachedLumpIndex& cached = cachedLumps();
+    DENG2_GUARD(cached);
+
+    CachedLump* lump = cached.find(container, lumpIdx);
+    if(!lump) return 0;
+
+    lump->lockCount++;
+    return lump->data;
+}
+
+uint8_t const* DecompressedLumpCache::insert(File1 const& container, int lumpIdx,
+    uint8_t* data, size_t size)
+{
+    CachedLumpIndex& cached = cachedLumps();
+    DENG2_GUARD(cached);
+
+    if(CachedLump* lump = cached.find(container, lumpIdx))
+    {
+        // Another thread got here first.
+        M_Free(data);
+        lump->lockCount++;
+        return lump->data;
+    }
+
+    CachedLump lump;
+    lump.container = &container;
+    lump.lumpIdx   = lumpIdx;
+    lump.data      = data;
+    lump.size      = size;
+    lump.lockCount = 1;
+    cached.lumps.push_front(lump);
+    cached.index.insert(CachedLumpKey(&container, lumpIdx), cached.lumps.begin());
+    cached.totalSize += size;
+
+    cached.evict();
+    return data;
+}
+
+bool DecompressedLumpCache::read(File1 const& container, int lumpIdx, uint8_t* buffer,
+    size_t startOffset, size_t length)
+{
+    CachedLumpIndex& cached = cachedLumps();
+    DENG2_GUARD(cached);
+
+    CachedLump* lump = cached.find(container, lumpIdx);
+    if(!lump || startOffset > lump->size || length > lump->size - startOffset) return false;
+
+    std::memcpy(buffer, lump->data + startOffset, length);
+    return true;
+}
+
+void DecompressedLumpCache::unlock(File1 const& container, int lumpIdx)
+{
+    CachedLumpIndex& cached = cachedLumps();
+    DENG2_GUARD(cached);
+
+    QHash<CachedLumpKey, CachedLumps::iterator>::iterator found =
+            cached.index.find(CachedLumpKey(&container, lumpIdx));
+    if(found == cached.index.end()) return;
+
+    CachedLump& lump = *found.value();
+    if(lump.lockCount > 0) lump.lockCount--;
+    if(lump.lockCount > 0) return;
+
+    cached.evict();
+}
+
+bool DecompressedLumpCache::remove(File1 const& container, int lumpIdx)
+{
+    CachedLumpIndex& cached = cachedLumps();
+    DENG2_GUARD(cached);
+
+    QHash<CachedLumpKey, CachedLumps::iterator>::iterator found =
+            cached.index.find(CachedLumpKey(&container, lumpIdx));
+    if(found == cached.index.end()) return false;
+
+    cached.release(found.value());
+    return true;
+}
+
+void DecompressedLumpCache::removeAll(File1 const& container)
+{
+    CachedLumpIndex& cached = cachedLumps();
+    DENG2_GUARD(cached);
+
+    CachedLumps::iterator i = cached.lumps.begin();
+    while(i != cached.lumps.end())
+    {
+        CachedLumps::iterator next = i;
+        ++next;
+        if(i->container == &container)
+        {
+            cached.release(i);
+        }
+        i = next;
+    }
+}
+
+} // namespace de
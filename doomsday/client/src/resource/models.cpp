@@ -22,17 +22,21 @@
  */
 
 #include <QDir>
+#include <QSet>
 #include <de/App>
 #include <de/ByteOrder>
 #include <de/NativePath>
 #include <de/StringPool>
+#include <de/TaskPool>
 #include <de/mathutil.h> // for M_CycleIntoRange()
 #include <de/memory.h>
 
 #include "de_platform.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring> // memset
+#include <deque>
 
 #include "de_base.h"
 #include "de_console.h"
@@ -60,6 +64,12 @@ float rModelAspectMod = 1 / 1.2f; //.833334f;
 
 static StringPool* modelRepository; // Owns model_t instances.
 static std::vector<int> stateModefs; // Index to the modefs array.
+static bool renormalize; // Rebuild the vertex normals of loaded models (-renorm).
+static std::deque<modeldef_t *> skinQueue; // Models whose skins are to be prepared.
+static QSet<modelid_t> failedModels; // Model files that could not be loaded.
+
+/// Time in milliseconds that may be spent preparing queued skins per frame.
+static uint const MAX_SKIN_PREPARE_TIME = 4;
 
 static float avertexnormals[NUMVERTEXNORMALS][3] = {
 #include "tab_anorms.h"
@@ -99,77 +109,73 @@ static void unpackVector(ushort packed, float vec[3])
 
 /**
  * Calculate vertex normals. Only with -renorm.
+ *
+ * Each vertex normal is the average of the normals of the triangles that use
+ * the vertex. The triangle normals are accumulated in one pass over the
+ * triangles of each frame.
  */
-#if 0 // unused atm.
-static void rebuildNormals(model_t &mdl)
+template <typename TriangleType>
+static void rebuildNormals(model_t &mdl, TriangleType const *tris, int numTris)
 {
-    // Renormalizing?
-    if(!CommandLine_Check("-renorm")) return;
-
-    int const tris  = mdl.lodInfo[0].numTriangles;
     int const verts = mdl.info.numVertices;
 
-    vector_t* normals = (vector_t*) Z_Malloc(sizeof(vector_t) * tris, PU_APPSTATIC, 0);
-    vector_t norm;
-    int cnt;
+    float (*sums)[3] = (float (*)[3]) M_Malloc(sizeof(*sums) * verts);
+    int *counts      = (int *) M_Malloc(sizeof(*counts) * verts);
+    if(!sums || !counts) throw std::bad_alloc();
 
-    // Calculate the normal for each vertex.
     for(int i = 0; i < mdl.info.numFrames; ++i)
     {
-        model_vertex_t* list = mdl.frames[i].vertices;
+        model_frame_t &frame = mdl.frames[i];
 
-        for(int k = 0; k < tris; ++k)
-        {
-            dmd_triangle_t const& tri = mdl.lods[0].triangles[k];
-
-            // First calculate surface normals, combine them to vertex ones.
-            V3f_PointCrossProduct(normals[k].pos,
-                                  list[tri.vertexIndices[0]].vertex,
-                                  list[tri.vertexIndices[2]].vertex,
-                                  list[tri.vertexIndices[1]].vertex);
-            V3f_Normalize(normals[k].pos);
-        }
+        std::memset(sums, 0, sizeof(*sums) * verts);
+        std::memset(counts, 0, sizeof(*counts) * verts);
 
-        for(int k = 0; k < verts; ++k)
+        // First calculate surface normals, combine them to vertex ones.
+        for(int k = 0; k < numTris; ++k)
         {
-            memset(&norm, 0, sizeof(norm));
-            cnt = 0;
+            int const idx[3] = { SHORT(tris[k].vertexIndices[0]),
+                                 SHORT(tris[k].vertexIndices[1]),
+                                 SHORT(tris[k].vertexIndices[2]) };
+            if(idx[0] < 0 || idx[0] >= verts ||
+               idx[1] < 0 || idx[1] >= verts ||
+               idx[2] < 0 || idx[2] >= verts) continue; // Bad data.
+
+            float norm[3];
+            V3f_PointCrossProduct(norm, frame.vertices[idx[0]].xyz,
+                                        frame.vertices[idx[2]].xyz,
+                                        frame.vertices[idx[1]].xyz);
+            V3f_Normalize(norm);
 
-            for(int j = 0; j < tris; ++j)
+            for(int n = 0; n < 3; ++n)
             {
-                dmd_triangle_t const& tri = mdl.lods[0].triangles[j];
+                // A vertex used twice by a triangle is counted once.
+                if(n > 0 && idx[n] == idx[0]) continue;
+                if(n > 1 && idx[n] == idx[1]) continue;
 
-                for(int n = 0; n < 3; ++n)
+                counts[idx[n]]++;
+                for(int c = 0; c < 3; ++c)
                 {
-                    if(tri.vertexIndices[n] == k)
-                    {
-                        cnt++;
-                        for(int n = 0; n < 3; ++n)
-                        {
-                            norm.pos[n] += normals[j].pos[n];
-                        }
-                        break;
-                    }
+                    sums[idx[n]][c] += norm[c];
                 }
             }
+        }
 
-            if(!cnt) continue; // Impossible...
+        for(int k = 0; k < verts; ++k)
+        {
+            if(!counts[k]) continue; // Unused vertex.
 
-            // Calculate the average.
-            for(int n = 0; n < 3; ++n)
+            // Calculate the average and normalize it.
+            for(int c = 0; c < 3; ++c)
             {
-                norm.pos[n] /= cnt;
+                frame.normals[k].xyz[c] = sums[k][c] / counts[k];
             }
-
-            // Normalize it.
-            V3f_Normalize(norm.pos);
-            memcpy(list[k].normal, norm.pos, sizeof(norm.pos));
+            V3f_Normalize(frame.normals[k].xyz);
         }
     }
 
-    Z_Free(normals);
+    M_Free(counts);
+    M_Free(sums);
 }
-#endif
 
 static void* allocAndLoad(de::FileHandle& file, int offset, int len)
 {
@@ -302,6 +308,14 @@ static void loadMd2(de::FileHandle& file, model_t& mdl)
     mdl.lods[0].glCommands = (int*) allocAndLoad(file, mdl.lodInfo[0].offsetGlCommands,
                                                  sizeof(int) * mdl.lodInfo[0].numGlCommands);
 
+    if(renormalize)
+    {
+        md2_triangle_t *triangles = (md2_triangle_t *) allocAndLoad(file, mdl.lodInfo[0].offsetTriangles,
+                                                                    sizeof(md2_triangle_t) * mdl.lodInfo[0].numTriangles);
+        rebuildNormals(mdl, triangles, mdl.lodInfo[0].numTriangles);
+        M_Free(triangles);
+    }
+
     // Load skins. (Note: numSkins may be zero.)
     mdl.skins = (dmd_skin_t*) M_Calloc(sizeof(*mdl.skins) * inf.numSkins);
     if(!mdl.skins) throw std::bad_alloc();
@@ -458,6 +472,11 @@ static void loadDmd(de::FileHandle& file, model_t& mdl)
         }
     }
 
+    if(renormalize && inf.numLODs > 0)
+    {
+        rebuildNormals(mdl, triangles[0], mdl.lodInfo[0].numTriangles);
+    }
+
     // We don't need the triangles any more.
     for(int i = 0; i < inf.numLODs; ++i)
     {
@@ -465,21 +484,25 @@ static void loadDmd(de::FileHandle& file, model_t& mdl)
     }
 }
 
-static model_t* modelForId(modelid_t modelId, bool canCreate = false)
+/**
+ * Allocates a new model_t. It is not added to the repository, so this can be
+ * called in any thread.
+ */
+static model_t *newModel(modelid_t modelId)
 {
-    DENG_ASSERT(modelRepository);
-    model_t* mdl = reinterpret_cast<model_t*>(modelRepository->userPointer(modelId));
-    if(!mdl && canCreate)
-    {
-        // Allocate a new model_t.
-        mdl = (model_t*) M_Calloc(sizeof(model_t));
-        mdl->modelId = modelId;
-        mdl->allowTexComp = true;
-        modelRepository->setUserPointer(modelId, mdl);
-    }
+    model_t *mdl = (model_t *) M_Calloc(sizeof(model_t));
+    if(!mdl) throw std::bad_alloc();
+    mdl->modelId = modelId;
+    mdl->allowTexComp = true;
     return mdl;
 }
 
+static model_t* modelForId(modelid_t modelId)
+{
+    DENG_ASSERT(modelRepository);
+    return reinterpret_cast<model_t*>(modelRepository->userPointer(modelId));
+}
+
 model_t* Models_ToModel(modelid_t id)
 {
     return modelForId(id);
@@ -602,7 +625,7 @@ static model_t *interpretDmd(de::FileHandle &hndl, String path, modelid_t modelI
     {
         LOG_AS("DmdFileType");
         LOG_VERBOSE("Interpreted \"" + NativePath(path).pretty() + "\".");
-        model_t *mdl = modelForId(modelId, true/*create*/);
+        model_t *mdl = newModel(modelId);
         loadDmd(hndl, *mdl);
         return mdl;
     }
@@ -615,7 +638,7 @@ static model_t *interpretMd2(de::FileHandle &hndl, String path, modelid_t modelI
     {
         LOG_AS("Md2FileType");
         LOG_VERBOSE("Interpreted \"" + NativePath(path).pretty() + "\".");
-        model_t *mdl = modelForId(modelId, true/*create*/);
+        model_t *mdl = newModel(modelId);
         loadMd2(hndl, *mdl);
         return mdl;
     }
@@ -688,50 +711,232 @@ static model_t *interpretModel(de::FileHandle &hndl, String path, modelid_t mode
     return mdl;
 }
 
+/**
+ * Model file being loaded. The file is opened in the main thread and released
+ * as soon as its contents are buffered in memory, so that the model can be
+ * interpreted in a worker thread.
+ */
+struct ModelFile
+{
+    modelid_t modelId;
+    String path;
+    de::FileHandle *buffered; ///< Contents of the file.
+    model_t *mdl;             ///< Interpreted model, if any.
+
+    ModelFile() : modelId(NOMODELID), buffered(0), mdl(0) {}
+};
+typedef std::vector<ModelFile> ModelFiles;
+
+/// Maximum total size of the model files buffered at once (see preloadModels()).
+static size_t const MAX_BUFFERED_MODEL_BYTES = 64 * 1024 * 1024;
+
+/**
+ * Releases the buffered contents of the model file.
+ */
+static void releaseModelFile(ModelFile &file)
+{
+    delete file.buffered;
+    file.buffered = 0;
+}
+
+/**
+ * Opens the model file at @a path and buffers its contents. The opened file
+ * is released before returning.
+ *
+ * @return  @c true if the file was opened and buffered into @a file.
+ */
+static bool openModelFile(String path, ModelFile &file)
+{
+    file.modelId  = modelRepository->intern(path);
+    file.path     = path;
+    file.buffered = 0;
+    file.mdl      = 0;
+
+    de::FileHandle *hndl = 0;
+    uint8_t *data = 0;
+    try
+    {
+        hndl = &App_FileSystem().openFile(path, "rb");
+
+        // Read the contents through the opened handle; model files are not
+        // necessarily lumps that can be buffered directly.
+        size_t const length = hndl->length();
+        data = (uint8_t *) M_Malloc(de::max(length, size_t(1)));
+        hndl->seek(0, SeekSet);
+        if(hndl->read(data, length) != length)
+        {
+            throw Error("openModelFile", "Failed to read " + String::number(length) + " bytes");
+        }
+
+        file.buffered = FileHandleBuilder::fromData(hndl->file(), data, length);
+        data = 0; // Owned by the buffer.
+    }
+    catch(Error const &er)
+    {
+        LOG_WARNING("Failed to open \"%s\": %s, ignoring.")
+            << NativePath(path).pretty() << er.asText();
+    }
+
+    // We're done with the file; the buffer only refers to it.
+    if(hndl)
+    {
+        App_FileSystem().releaseFile(hndl->file());
+        delete hndl;
+    }
+
+    if(file.buffered) return true;
+
+    M_Free(data);
+    failedModels.insert(file.modelId);
+    return false;
+}
+
+/**
+ * Interprets buffered model files. Only the buffered contents are accessed,
+ * so the files can be interpreted concurrently.
+ */
+struct ModelFileInterpreter
+{
+    ModelFiles *files;
+
+    ModelFileInterpreter(ModelFiles &files) : files(&files) {}
+
+    void operator () (int index) const
+    {
+        ModelFile &file = (*files)[index];
+        try
+        {
+            file.mdl = interpretModel(*file.buffered, file.path, file.modelId);
+        }
+        catch(Error const &er)
+        {
+            LOG_AS("ModelFileInterpreter");
+            LOG_WARNING("Failed to load \"%s\": %s")
+                << NativePath(file.path).pretty() << er.asText();
+        }
+    }
+};
+
+/**
+ * Releases the model file and adds the interpreted model to the repository.
+ *
+ * @return  The loaded model, if any.
+ */
+static model_t *closeModelFile(ModelFile &file)
+{
+    // We're done with the contents.
+    releaseModelFile(file);
+
+    model_t *mdl = file.mdl;
+    if(!mdl)
+    {
+        // Don't try to load it again.
+        failedModels.insert(file.modelId);
+        return 0;
+    }
+
+    modelRepository->setUserPointer(file.modelId, mdl);
+
+    defineAllSkins(*mdl);
+
+    // Enlarge the vertex buffers in preparation for drawing of this model.
+    if(!Rend_ModelExpandVertexBuffers(mdl->info.numVertices))
+    {
+        LOG_WARNING("Model \"%s\" contains more than %u max vertices (%u), it will not be rendered.")
+            << NativePath(file.path).pretty()
+            << uint(RENDER_MAX_MODEL_VERTS) << uint(mdl->info.numVertices);
+    }
+
+    return mdl;
+}
+
 /**
  * Finds the existing model or loads in a new one.
  */
 static model_t *loadModel(String path)
 {
     // Have we already loaded this?
-    modelid_t modelId = modelRepository->intern(path);
-    model_t *mdl = Models_ToModel(modelId);
-    if(mdl) return mdl; // Yes.
+    modelid_t const modelId = modelRepository->intern(path);
+    if(model_t *mdl = Models_ToModel(modelId)) return mdl; // Yes.
 
-    try
+    // Or failed to load it?
+    if(failedModels.contains(modelId)) return 0;
+
+    ModelFile file;
+    if(!openModelFile(path, file)) return 0;
+
+    ModelFiles files(1, file);
+    ModelFileInterpreter(files)(0);
+    return closeModelFile(files[0]);
+}
+
+static void interpretModelFiles(ModelFiles &files)
+{
+    TaskPool::parallelFor(0, files.size(), ModelFileInterpreter(files));
+
+    // Models are added to the repository in the order they were opened.
+    DENG2_FOR_EACH(ModelFiles, i, files)
     {
-        // Attempt to interpret and load this model file.
-        de::FileHandle &hndl = App_FileSystem().openFile(path, "rb");
+        closeModelFile(*i);
+    }
+    files.clear();
+}
 
-        mdl = interpretModel(hndl, path, modelId);
+/**
+ * Loads all the model files used by the Model definitions. The files are read
+ * in batches; the models of a batch are interpreted concurrently.
+ */
+static void preloadModels()
+{
+    LOG_AS("preloadModels");
 
-        // We're done with the file.
-        App_FileSystem().releaseFile(hndl.file());
-        delete &hndl;
+    ModelFiles files;
+    size_t bufferedBytes = 0;
 
-        // Loaded?
-        if(mdl)
+    // Use the same order as setupModel() so that the log is in the usual order.
+    for(int i = int(defs.models.size()) - 1; i >= 0; --i)
+    {
+        if(!(i % 100))
         {
-            defineAllSkins(*mdl);
+            // This may take a while, so keep updating the progress.
+            Con_SetProgress(130 + 50*(defs.models.size() - i)/defs.models.size());
+        }
 
-            // Enlarge the vertex buffers in preparation for drawing of this model.
-            if(!Rend_ModelExpandVertexBuffers(mdl->info.numVertices))
+        ded_model_t const &def = defs.models[i];
+        for(uint k = 0; k < def.subCount(); ++k)
+        {
+            ded_submodel_t const &subdef = def.sub(k);
+            if(!subdef.filename || Uri_IsEmpty(subdef.filename)) continue;
+
+            de::Uri const &searchPath = reinterpret_cast<de::Uri &>(*subdef.filename);
+            try
             {
-                LOG_WARNING("Model \"%s\" contains more than %u max vertices (%u), it will not be rendered.")
-                    << NativePath(path).pretty()
-                    << uint(RENDER_MAX_MODEL_VERTS) << uint(mdl->info.numVertices);
+                String foundPath = App_FileSystem().findPath(searchPath, RLF_DEFAULT,
+                                                             DD_ResourceClassById(RC_MODEL));
+                // Ensure the found path is absolute.
+                foundPath = App_BasePath() / foundPath;
+
+                // Files used by several definitions are loaded only once.
+                if(modelRepository->isInterned(foundPath)) continue;
+
+                ModelFile file;
+                if(!openModelFile(foundPath, file)) continue;
+
+                files.push_back(file);
+                bufferedBytes += file.buffered->length();
             }
+            catch(FS1::NotFoundError const &)
+            {} // setupModel() will warn about this.
 
-            return mdl;
+            if(bufferedBytes >= MAX_BUFFERED_MODEL_BYTES)
+            {
+                interpretModelFiles(files);
+                bufferedBytes = 0;
+            }
         }
     }
-    catch(FS1::NotFoundError const &er)
-    {
-        // Huh?? Should never happen.
-        LOG_WARNING(er.asText() + ", ignoring.");
-    }
 
-    return 0;
+    interpretModelFiles(files);
 }
 
 /**
@@ -1281,6 +1486,8 @@ static int destroyModelInRepository(StringPool::Id id, void* /*parm*/)
     model_t* mdl = reinterpret_cast<model_t*>(modelRepository->userPointer(id));
     if(!mdl) return 0;
 
+    Rend_ModelReleaseBuffers(*mdl);
+
     M_Free(mdl->skins);
     for(int i = 0; i < mdl->info.numFrames; ++i)
     {
@@ -1319,6 +1526,8 @@ void Models_Init(void)
 
     clearModelList();
     modefs.clear();
+    skinQueue.clear();
+    failedModels.clear();
 
     // There can't be more modeldefs than there are DED Models.
     for(uint i = 0; i < defs.models.size(); ++i)
@@ -1334,13 +1543,16 @@ void Models_Init(void)
     }
 
     // Read in the model files and their data.
+    renormalize = CommandLine_Check("-renorm") != 0;
+    preloadModels();
+
     // Use the latest definition available for each sprite ID.
     for(int i = int(defs.models.size()) - 1; i >= 0; --i)
     {
         if(!(i % 100))
         {
             // This may take a while, so keep updating the progress.
-            Con_SetProgress(130 + 70*(defs.models.size() - i)/defs.models.size());
+            Con_SetProgress(180 + 20*(defs.models.size() - i)/defs.models.size());
         }
 
         setupModel(defs.models[i]);
@@ -1407,6 +1619,8 @@ void Models_Init(void)
 void Models_Shutdown(void)
 {
     /// @todo Why only centralized memory deallocation? Bad (lazy) design...
+    skinQueue.clear();
+    failedModels.clear();
     modefs.clear();
     stateModefs.clear();
 
@@ -1443,6 +1657,34 @@ void Models_Cache(modeldef_t *modef)
             tex->prepareVariant(Rend_ModelShinyTextureSpec());
         }
     }
+
+    modef->skinsReady = true;
+}
+
+bool Models_IsReady(modeldef_t *modef)
+{
+    if(!modef) return false;
+    if(modef->skinsReady) return true;
+
+    if(std::find(skinQueue.begin(), skinQueue.end(), modef) == skinQueue.end())
+    {
+        skinQueue.push_back(modef);
+    }
+    return false;
+}
+
+void Models_PrepareQueuedSkins(void)
+{
+    uint const startTime = Timer_RealMilliseconds();
+
+    // At least one model is prepared per frame.
+    while(!skinQueue.empty())
+    {
+        Models_Cache(skinQueue.front());
+        skinQueue.pop_front();
+
+        if(Timer_RealMilliseconds() - startTime >= MAX_SKIN_PREPARE_TIME) break;
+    }
 }
 
 #undef Models_CacheForState
@@ -353,6 +353,18 @@ struct Wad::Instance
         return 0; // Continue iteration.
     }
 
+    /**
+     * Returns the address of a range of the wad's data in memory, or @c 0 if
+     * the file cannot be memory-mapped.
+     */
+    uint8_t const *mappedRange(size_t offset, size_t length)
+    {
+        size_t mappedLength;
+        uint8_t const *mapped = self->handle_->mapData(&mappedLength);
+        if(!mapped || offset > mappedLength || length > mappedLength - offset) return 0;
+        return mapped + offset;
+    }
+
     void buildLumpNodeLut()
     {
         LOG_AS("Wad");
@@ -457,6 +469,12 @@ uint8_t const *Wad::cacheLump(int lumpIdx)
         << (unsigned long) file.info().size
         << (file.info().isCompressed()? ", compressed" : "");
 
+    // The lump can be accessed directly in the mapped file.
+    if(uint8_t const *mapped = d->mappedRange(file.info().baseOffset, file.info().size))
+    {
+        return mapped;
+    }
+
     // Time to create the cache?
     if(!d->lumpCache)
     {
@@ -532,6 +550,13 @@ size_t Wad::readLump(int lumpIdx, uint8_t *buffer, size_t startOffset,
         }
     }
 
+    // Copy from the mapped file, if possible.
+    if(uint8_t const *mapped = d->mappedRange(file.info().baseOffset + startOffset, length))
+    {
+        std::memcpy(buffer, mapped, length);
+        return length;
+    }
+
     handle_->seek(file.info().baseOffset + startOffset, SeekSet);
     size_t readBytes = handle_->read(buffer, length);
 
@@ -23,9 +23,11 @@
 #include <zlib.h>
 
 #include <vector>
+#include <QList>
 
 #include "de_base.h"
 #include "de_filesys.h"
+#include "resource/decompressedlumpcache.h"
 #include "resource/lumpcache.h"
 #include "resource/zip.h"
 
@@ -132,7 +134,7 @@ typedef struct centralend_s {
 #pragma pack()
 
 static String invalidIndexMessage(int invalidIdx, int lastValidIdx);
-static bool applyGamePathMappings(String& path);
+static bool applyGamePathMappings(String& path, Zip::PathMappings const& mappings);
 
 class ZipFile : public File1
 {
@@ -236,6 +238,10 @@ struct Zip::Instance
     /// Lump data cache.
     LumpCache* lumpCache;
 
+    /// Warnings from reading the lump directory, logged on the main thread.
+    typedef QList<String> Warnings;
+    Warnings pendingWarnings;
+
     Instance(Zip* d)
         : self(d), lumpDirectory(0), lumpNodeLut(0), lumpCache(0)
     {}
@@ -337,7 +343,31 @@ struct Zip::Instance
 
     void readLumpDirectory()
     {
+        if(!lumpDirectory)
+        {
+            readLumpDirectory(PathMappings::current());
+        }
+        logPendingWarnings();
+    }
+
+    void logPendingWarnings()
+    {
+        if(pendingWarnings.isEmpty()) return;
+
         LOG_AS("Zip");
+        DENG2_FOR_EACH_CONST(Warnings, i, pendingWarnings)
+        {
+            LOG_WARNING("%s") << *i;
+        }
+        pendingWarnings.clear();
+    }
+
+    /**
+     * Reads the lump directory. Nothing outside the archive is accessed and
+     * warnings are only collected, so this can be run in a worker thread.
+     */
+    void readLumpDirectory(PathMappings const& mappings)
+    {
         // Already been here?
         if(lumpDirectory) return;
 
@@ -402,15 +432,17 @@ struct Zip::Instance
                    USHORT(header->compression) != ZFC_DEFLATED)
                 {
                     if(pass != 0) continue;
-                    LOG_WARNING("Zip %s:'%s' uses an unsupported compression algorithm, ignoring.")
-                        << NativePath(self->composePath()).pretty() << NativePath(filePath).pretty();
+                    pendingWarnings << String("Zip %1:'%2' uses an unsupported compression algorithm, ignoring.")
+                                           .arg(NativePath(self->composePath()).pretty())
+                                           .arg(NativePath(filePath).pretty());
                 }
 
                 if(USHORT(header->flags) & ZFH_ENCRYPTED)
                 {
                     if(pass != 0) continue;
-                    LOG_WARNING("Zip %s:'%s' is encrypted.\n  Encryption is not supported, ignoring.")
-                        << NativePath(self->composePath()).pretty() << NativePath(filePath).pretty();
+                    pendingWarnings << String("Zip %1:'%2' is encrypted.\n  Encryption is not supported, ignoring.")
+                                           .arg(NativePath(self->composePath()).pretty())
+                                           .arg(NativePath(filePath).pretty());
                 }
 
                 if(pass == 0)
@@ -438,23 +470,11 @@ struct Zip::Instance
                     compressedSize = ULONG(header->size);
                 }
 
-                if(App_GameLoaded())
+                if(mappings.enabled)
                 {
                     // In some cases the path to the file is mapped to some
                     // other location in the virtual file system.
-                    String filePathCopy = filePath;
-                    if(applyGamePathMappings(filePathCopy))
-                    {
-                        try
-                        {
-                            // Resolve all symbolic references in the path.
-                            filePath = Uri(filePathCopy, RC_NULL).resolved();
-                        }
-                        catch(de::Uri::ResolveError const& er)
-                        {
-                            LOG_WARNING(er.asText());
-                        }
-                    }
+                    applyGamePathMappings(filePath, mappings);
                 }
 
                 // Make it absolute.
@@ -501,6 +521,18 @@ struct Zip::Instance
         lumpDirectory->traverse(PathTree::NoBranch, NULL, PathTree::no_hash, buildLumpNodeLutWorker, (void*)this);
     }
 
+    /**
+     * Returns the address of a range of the archive's data in memory, or @c 0
+     * if the file cannot be memory-mapped.
+     */
+    uint8_t const* mappedRange(size_t offset, size_t length)
+    {
+        size_t mappedLength;
+        uint8_t const* mapped = self->handle_->mapData(&mappedLength);
+        if(!mapped || offset > mappedLength || length > mappedLength - offset) return 0;
+        return mapped + offset;
+    }
+
     /**
      * @param lump      Lump/file to be buffered.
      * @param buffer    Must be large enough to hold the entire uncompressed data lump.
@@ -511,6 +543,23 @@ struct Zip::Instance
         LOG_AS("Zip");
 
         FileInfo const& lumpInfo = lump.info();
+
+        // Read straight from the mapped file, if possible.
+        if(uint8_t const* mapped = mappedRange(lumpInfo.baseOffset, lumpInfo.compressedSize))
+        {
+            if(lumpInfo.isCompressed())
+            {
+                // zlib does not modify the input.
+                if(!uncompressRaw(const_cast<uint8_t*>(mapped), lumpInfo.compressedSize,
+                                  buffer, lumpInfo.size)) return 0; // Inflate failed.
+            }
+            else
+            {
+                memcpy(buffer, mapped, lumpInfo.size);
+            }
+            return lumpInfo.size;
+        }
+
         self->handle_->seek(lumpInfo.baseOffset, SeekSet);
 
         if(lumpInfo.isCompressed())
@@ -570,6 +619,12 @@ bool Zip::empty()
     return !lumpCount();
 }
 
+void Zip::readLumpDirectory(PathMappings const& mappings)
+{
+    d->readLumpDirectory(mappings);
+    d->buildLumpNodeLut();
+}
+
 PathTree::Node& Zip::lumpDirectoryNode(int lumpIdx) const
 {
     if(!isValidIndex(lumpIdx)) throw NotFoundError("Zip::lumpDirectoryNode", invalidIndexMessage(lumpIdx, lastIndex()));
@@ -593,7 +648,12 @@ void Zip::clearCachedLump(int lumpIdx, bool* retCleared)
 
     if(isValidIndex(lumpIdx))
     {
-        if(d->lumpCache)
+        if(lump(lumpIdx).info().isCompressed())
+        {
+            bool removed = DecompressedLumpCache::remove(*this, lumpIdx);
+            if(retCleared) *retCleared = removed;
+        }
+        else if(d->lumpCache)
         {
             d->lumpCache->remove(lumpIdx, retCleared);
         }
@@ -612,6 +672,7 @@ void Zip::clearCachedLump(int lumpIdx, bool* retCleared)
 void Zip::clearLumpCache()
 {
     LOG_AS("Zip::clearLumpCache");
+    DecompressedLumpCache::removeAll(*this);
     if(d->lumpCache) d->lumpCache->clear();
 }
 
@@ -628,6 +689,25 @@ uint8_t const* Zip::cacheLump(int lumpIdx)
         << (unsigned long) file.info().size
         << (file.info().isCompressed()? ", compressed" : "");
 
+    if(file.info().isCompressed())
+    {
+        // Decompressed lumps are kept in the shared cache.
+        uint8_t const* data = DecompressedLumpCache::lock(*this, lumpIdx);
+        if(data) return data;
+
+        uint8_t* region = (uint8_t*) M_Malloc(MAX_OF(file.info().size, 1));
+        if(!region) throw Error("Zip::cacheLump", QString("Failed on allocation of %1 bytes for decompressed copy of lump #%2").arg(file.info().size).arg(lumpIdx));
+
+        readLump(lumpIdx, region, false);
+        return DecompressedLumpCache::insert(*this, lumpIdx, region, file.info().size);
+    }
+
+    // Stored lumps can be accessed directly in the mapped file.
+    if(uint8_t const* mapped = d->mappedRange(file.info().baseOffset, file.info().size))
+    {
+        return mapped;
+    }
+
     // Time to create the cache?
     if(!d->lumpCache)
     {
@@ -653,7 +733,11 @@ void Zip::unlockLump(int lumpIdx)
 
     if(isValidIndex(lumpIdx))
     {
-        if(d->lumpCache)
+        if(lump(lumpIdx).info().isCompressed())
+        {
+            DecompressedLumpCache::unlock(*this, lumpIdx);
+        }
+        else if(d->lumpCache)
         {
             d->lumpCache->unlock(lumpIdx);
         }
@@ -690,6 +774,25 @@ size_t Zip::readLump(int lumpIdx, uint8_t* buffer, size_t startOffset,
         << startOffset
         << length;
 
+    // Try to avoid decompressing by checking for a cached copy.
+    if(tryCache && file.isCompressed())
+    {
+        bool const found = DecompressedLumpCache::read(*this, lumpIdx, buffer, startOffset, length);
+        LOG_TRACE("Cache %s on #%i") << (found? "hit" : "miss") << lumpIdx;
+        if(found) return length;
+    }
+
+    // Stored lumps are copied straight from the mapped file.
+    if(!file.isCompressed() && startOffset <= file.size())
+    {
+        size_t const readBytes = MIN_OF(length, file.size() - startOffset);
+        if(uint8_t const* mapped = d->mappedRange(file.info().baseOffset + startOffset, readBytes))
+        {
+            memcpy(buffer, mapped, readBytes);
+            return readBytes;
+        }
+    }
+
     // Try to avoid a file system read by checking for a cached copy.
     if(tryCache)
     {
@@ -922,26 +1025,33 @@ bool Zip::uncompressRaw(uint8_t* in, size_t inSize, uint8_t* out, size_t outSize
 /**
  * The path inside the zip might be mapped to another virtual location.
  *
+ * @param path      Path inside the zip. Replaced with the mapped location.
+ * @param mappings  Resolved locations of the current game.
+ *
  * @return  @c true= iff @a path was mapped to another location.
  *
  * @todo This is clearly implemented in the wrong place. Path mapping
  *       should be done at a higher level.
  */
-static bool applyGamePathMappings(String& path)
+static bool applyGamePathMappings(String& path, Zip::PathMappings const& mappings)
 {
     // Manually mapped to Defs?
     if(path.beginsWith('@'))
     {
+        if(mappings.defsPath.isEmpty()) return false;
+
         path.remove(0, 1);
         if(path.at(0) == '/') path.remove(0, 1);
 
-        path = String("$(App.DefsPath)/$(GamePlugin.Name)/auto") / path;
+        path = mappings.defsPath / "auto" / path;
         return true;
     }
 
     // Manually mapped to Data?
     if(path.beginsWith('#'))
     {
+        if(mappings.dataPath.isEmpty()) return false;
+
         path.remove(0, 1);
         if(path.at(0) == '/') path.remove(0, 1);
 
@@ -957,7 +1067,7 @@ static bool applyGamePathMappings(String& path)
             }
         }
 
-        path = String("$(App.DataPath)/$(GamePlugin.Name)/auto") / path;
+        path = mappings.dataPath / "auto" / path;
         return true;
     }
 
@@ -971,12 +1081,14 @@ static bool applyGamePathMappings(String& path)
         {
         case RC_PACKAGE:
             // Mapped to the Data directory.
-            path = String("$(App.DataPath)/$(GamePlugin.Name)/auto") / path;
+            if(mappings.dataPath.isEmpty()) return false;
+            path = mappings.dataPath / "auto" / path;
             return true;
 
         case RC_DEFINITION:
             // Mapped to the Defs directory?
-            path = String("$(App.DefsPath)/$(GamePlugin.Name)/auto") / path;
+            if(mappings.defsPath.isEmpty()) return false;
+            path = mappings.defsPath / "auto" / path;
             return true;
 
         default:
@@ -985,17 +1097,47 @@ static bool applyGamePathMappings(String& path)
     }
 
     // Key-named directories in the root might be mapped to another location.
-    FS1::Schemes const& schemes = App_FileSystem().allSchemes();
-    DENG2_FOR_EACH_CONST(FS1::Schemes, i, schemes)
+    // Schemes map such paths into the game's Data directory.
+    if(mappings.dataPath.isEmpty()) return false;
+    DENG2_FOR_EACH_CONST(FS1::Schemes, i, mappings.schemes)
     {
-        if((*i)->mapPath(path))
+        String mapped = path;
+        if((*i)->mapPath(mapped))
         {
+            path = mappings.dataPath / path;
             return true;
         }
     }
     return false;
 }
 
+/// Resolves a symbolic path of the current game, or returns an empty string.
+static String resolveGamePath(String const& symbolicPath)
+{
+    try
+    {
+        return Uri(symbolicPath, RC_NULL).resolved();
+    }
+    catch(de::Uri::ResolveError const& er)
+    {
+        LOG_WARNING(er.asText());
+    }
+    return "";
+}
+
+Zip::PathMappings Zip::PathMappings::current()
+{
+    PathMappings mappings;
+    mappings.enabled = App_GameLoaded();
+    if(mappings.enabled)
+    {
+        mappings.dataPath = resolveGamePath("$(App.DataPath)/$(GamePlugin.Name)");
+        mappings.defsPath = resolveGamePath("$(App.DefsPath)/$(GamePlugin.Name)");
+        mappings.schemes  = App_FileSystem().allSchemes();
+    }
+    return mappings;
+}
+
 static String invalidIndexMessage(int invalidIdx, int lastValidIdx)
 {
     String msg = String("Invalid lump index %1").arg(invalidIdx);
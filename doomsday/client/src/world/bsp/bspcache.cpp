@@ -0,0 +1,792 @@
+/** @file bspcache.cpp World map BSP cache.
+ *
+ * @authors Copyright © 2013 Daniel Swanson <danij@dengine.net>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, write to the Free
+ * Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA</small>
+ */
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QVector>
+
+#include <de/IByteArray>
+#include <de/Log>
+#include <de/NativePath>
+#include <de/Reader>
+#include <de/Writer>
+
+#include "de_base.h" // ddRuntimePath
+
+#include "BspLeaf"
+#include "BspNode"
+#include "Face"
+#include "HEdge"
+#include "Line"
+#include "Mesh"
+#include "Sector"
+#include "Segment"
+#include "Vertex"
+
+#include "world/bsp/bspcache.h"
+
+namespace de {
+namespace bsp {
+
+/// Identifies a BSP cache file.
+static duint32 const CACHE_MAGIC = 0x50534244; // "DBSP"
+
+/// Increment when the format or the partitioner output changes.
+static duint32 const CACHE_VERSION = 2;
+
+/// Cache files are stored here (relative to the runtime folder).
+static char const *CACHE_DIR = "mapcache/bsp";
+
+/// Child element reference types.
+enum {
+    ChildNone,
+    ChildNode,
+    ChildLeaf
+};
+
+namespace internal
+{
+    /// A half-edge and the Segment attributed to it.
+    struct HEdgeRecord
+    {
+        dint32 vertex;
+        dint32 lineSide; ///< Line index * 2 + side; otherwise @c -1.
+        ddouble lineSideOffset;
+        ddouble length;
+        duint32 angle;
+        dint32 back;     ///< Back segment; otherwise @c -1.
+        dint32 twinVertex;
+    };
+
+    /// Half-edges of a face in the order they were created.
+    typedef QVector<HEdgeRecord> FaceRecord;
+
+    struct LeafRecord
+    {
+        dint32 sector;
+        QList<FaceRecord> extraFaces;
+        bool hasPoly;
+        FaceRecord poly;
+    };
+
+    struct ChildRef
+    {
+        duchar type;
+        dint32 index;
+    };
+
+    struct NodeRecord
+    {
+        Partition partition;
+        AABoxd aaBox[2];
+        ChildRef child[2];
+    };
+
+    struct SideRecord
+    {
+        dint32 side;
+        dint32 leftSegment;
+        dint32 rightSegment;
+    };
+
+    struct UnclosedRecord
+    {
+        dint32 sector;
+        Vector2d nearPoint;
+    };
+
+    /// Returns the half-edges of @a face in the order they were created.
+    static QList<HEdge *> hedgesInCreationOrder(Face const &face)
+    {
+        // New half-edges are linked to the head of the face, so walking
+        // backwards from the oldest yields the original order.
+        QList<HEdge *> hedges;
+        HEdge *hedge = &face.hedge()->prev();
+        for(int i = 0; i < face.hedgeCount(); ++i)
+        {
+            hedges.append(hedge);
+            hedge = &hedge->prev();
+        }
+        return hedges;
+    }
+}
+
+using namespace internal;
+
+DENG2_PIMPL_NOREF(BspCache)
+{
+    Mesh &mesh;
+    Lines const &lines;
+    Sectors const &sectors;
+    LineSet const &linesToBuildFor;
+    Block key;
+
+    // Parsed cache data:
+    QVector<Vector2d> newVertexes;
+    QList<LeafRecord> leafs;
+    QList<NodeRecord> nodes;
+    ChildRef root;
+    QList<SideRecord> sides;
+    QList<UnclosedRecord> unclosed;
+    int segmentCount;
+
+    Instance(Mesh &mesh, Lines const &lines, Sectors const &sectors,
+             LineSet const &linesToBuildFor)
+        : mesh(mesh),
+          lines(lines),
+          sectors(sectors),
+          linesToBuildFor(linesToBuildFor),
+          segmentCount(0)
+    {}
+
+    /**
+     * Hash everything the partitioner's output depends on.
+     */
+    void composeKey(int splitCostFactor)
+    {
+        Block input;
+        Writer writer(input);
+
+        writer << CACHE_VERSION << dint32(splitCostFactor);
+
+        writer << dint32(mesh.vertexCount());
+        foreach(Vertex *vertex, mesh.vertexes())
+        {
+            writer << vertex->origin().x << vertex->origin().y;
+        }
+
+        writer << dint32(sectors.count()) << dint32(lines.count());
+        foreach(Line *line, lines)
+        {
+            writer << duchar(linesToBuildFor.contains(line)? 1 : 0)
+                   << dint32(line->from().indexInMap())
+                   << dint32(line->to().indexInMap())
+                   << sectorIndex(line->frontSectorPtr())
+                   << sectorIndex(line->hasBackSector()? line->backSectorPtr() : 0)
+                   << sectorIndex(line->_bspWindowSector);
+        }
+
+        key = QCryptographicHash::hash(input, QCryptographicHash::Md5);
+    }
+
+    static dint32 sectorIndex(Sector const *sector)
+    {
+        return sector? sector->indexInMap() : -1;
+    }
+
+    static void writeFace(Writer &writer, QList<HEdge *> const &hedges,
+                          QHash<Segment const *, int> const &segmentIds)
+    {
+        writer << dint32(hedges.count());
+        foreach(HEdge *hedge, hedges)
+        {
+            Segment const &seg = *hedge->mapElement()->as<Segment>();
+
+            writer << dint32(hedge->vertex().indexInMap())
+                   << dint32(seg.hasLineSide()? seg.line().indexInMap() * 2 + seg.lineSide().sideId() : -1)
+                   << seg.lineSideOffset()
+                   << seg.length()
+                   << duint32(seg.angle())
+                   << dint32(seg.hasBack()? segmentIds[&seg.back()] : -1)
+                   << dint32(hedge->hasTwin()? hedge->twin().vertex().indexInMap() : -1);
+        }
+    }
+
+    static void writeChild(Writer &writer, MapElement const *elem,
+                           QHash<MapElement const *, int> const &elementIds)
+    {
+        if(!elem)
+        {
+            writer << duchar(ChildNone) << dint32(0);
+            return;
+        }
+        writer << duchar(elem->type() == DMU_BSPNODE? ChildNode : ChildLeaf)
+               << dint32(elementIds[elem]);
+    }
+
+    static void readFace(Reader &reader, FaceRecord &face)
+    {
+        dint32 count;
+        reader >> count;
+        if(count < 1 || count > 0x100000)
+            throw ReadError("BspCache::readFace", "Invalid half-edge count");
+
+        face.resize(count);
+        for(int i = 0; i < count; ++i)
+        {
+            HEdgeRecord &rec = face[i];
+            reader >> rec.vertex >> rec.lineSide >> rec.lineSideOffset
+                   >> rec.length >> rec.angle >> rec.back >> rec.twinVertex;
+        }
+    }
+
+    static void readChild(Reader &reader, ChildRef &ref)
+    {
+        reader >> ref.type >> ref.index;
+    }
+
+    /**
+     * Parse the cached data. No map elements are created.
+     */
+    void parse(Block const &data)
+    {
+        Reader reader(data);
+
+        duint32 magic, version;
+        Block fileKey;
+        reader >> magic >> version >> fileKey;
+        if(magic != CACHE_MAGIC || version != CACHE_VERSION || fileKey != key)
+            throw ReadError("BspCache::parse", "Not a cache file for this map");
+
+        dint32 count;
+        reader >> count;
+        if(count < 0 || count > data.size() / 16)
+            throw ReadError("BspCache::parse", "Invalid vertex count");
+        newVertexes.resize(count);
+        for(int i = 0; i < count; ++i)
+        {
+            reader >> newVertexes[i].x >> newVertexes[i].y;
+        }
+
+        reader >> count;
+        if(count < 1) throw ReadError("BspCache::parse", "Invalid leaf count");
+        for(int i = 0; i < count; ++i)
+        {
+            leafs.append(LeafRecord());
+            LeafRecord &leaf = leafs.last();
+
+            dint32 extraCount;
+            duchar hasPoly;
+            reader >> leaf.sector >> extraCount;
+            if(extraCount < 0) throw ReadError("BspCache::parse", "Invalid mesh count");
+            for(int k = 0; k < extraCount; ++k)
+            {
+                leaf.extraFaces.append(FaceRecord());
+                readFace(reader, leaf.extraFaces.last());
+                segmentCount += leaf.extraFaces.last().count();
+            }
+            reader >> hasPoly;
+            leaf.hasPoly = (hasPoly != 0);
+            if(leaf.hasPoly)
+            {
+                readFace(reader, leaf.poly);
+                segmentCount += leaf.poly.count();
+            }
+        }
+
+        reader >> count;
+        if(count < 0) throw ReadError("BspCache::parse", "Invalid node count");
+        for(int i = 0; i < count; ++i)
+        {
+            nodes.append(NodeRecord());
+            NodeRecord &node = nodes.last();
+
+            reader >> node.partition.direction.x >> node.partition.direction.y
+                   >> node.partition.origin.x    >> node.partition.origin.y;
+            for(int k = 0; k < 2; ++k)
+            {
+                reader >> node.aaBox[k].minX >> node.aaBox[k].minY
+                       >> node.aaBox[k].maxX >> node.aaBox[k].maxY;
+            }
+            readChild(reader, node.child[0]);
+            readChild(reader, node.child[1]);
+        }
+        readChild(reader, root);
+
+        reader >> count;
+        if(count < 0) throw ReadError("BspCache::parse", "Invalid side count");
+        for(int i = 0; i < count; ++i)
+        {
+            SideRecord rec;
+            reader >> rec.side >> rec.leftSegment >> rec.rightSegment;
+            sides.append(rec);
+        }
+
+        reader >> count;
+        if(count < 0) throw ReadError("BspCache::parse", "Invalid unclosed sector count");
+        for(int i = 0; i < count; ++i)
+        {
+            UnclosedRecord rec;
+            reader >> rec.sector >> rec.nearPoint.x >> rec.nearPoint.y;
+            unclosed.append(rec);
+        }
+
+        if(!reader.atEnd())
+            throw ReadError("BspCache::parse", "Unexpected trailing data");
+    }
+
+    void validateFace(FaceRecord const &face, int firstSegment,
+                      QVector<HEdgeRecord const *> &segments) const
+    {
+        int const vertexCount = mesh.vertexCount() + newVertexes.count();
+        for(int i = 0; i < face.count(); ++i)
+        {
+            HEdgeRecord const &rec = face[i];
+            if(rec.vertex < 0 || rec.vertex >= vertexCount ||
+               rec.twinVertex < -1 || rec.twinVertex >= vertexCount ||
+               rec.lineSide < -1 || rec.lineSide >= lines.count() * 2 ||
+               rec.back < -1 || rec.back >= segmentCount || rec.back == firstSegment + i)
+                throw ReadError("BspCache::validate", "Invalid half-edge");
+
+            segments[firstSegment + i] = &rec;
+        }
+    }
+
+    bool validateChild(ChildRef const &ref, QVector<bool> &nodeUsed,
+                       QVector<bool> &leafUsed) const
+    {
+        QVector<bool> &used = (ref.type == ChildNode? nodeUsed : leafUsed);
+        if((ref.type != ChildNode && ref.type != ChildLeaf) ||
+           ref.index < 0 || ref.index >= used.count() || used[ref.index])
+            return false;
+        used[ref.index] = true;
+        return true;
+    }
+
+    /**
+     * Ensure the parsed data describes a well formed tree whose references
+     * are all within range, so that reconstruction cannot fail midway.
+     */
+    void validate() const
+    {
+        QVector<HEdgeRecord const *> segments(segmentCount);
+        int segmentIdx = 0;
+        foreach(LeafRecord const &leaf, leafs)
+        {
+            if(leaf.sector < -1 || leaf.sector >= sectors.count())
+                throw ReadError("BspCache::validate", "Invalid sector");
+
+            foreach(FaceRecord const &face, leaf.extraFaces)
+            {
+                validateFace(face, segmentIdx, segments);
+                segmentIdx += face.count();
+            }
+            if(leaf.hasPoly)
+            {
+                validateFace(leaf.poly, segmentIdx, segments);
+                segmentIdx += leaf.poly.count();
+            }
+        }
+
+        // Back segments must be paired.
+        for(int i = 0; i < segmentCount; ++i)
+        {
+            int const back = segments[i]->back;
+            if(back >= 0 && segments[back]->back != i)
+                throw ReadError("BspCache::validate", "Unpaired back segment");
+        }
+
+        // Each element must be reachable from the root exactly once.
+        QVector<bool> nodeUsed(nodes.count()), leafUsed(leafs.count());
+        if(!validateChild(root, nodeUsed, leafUsed))
+            throw ReadError("BspCache::validate", "Invalid root");
+
+        QList<int> stack;
+        if(root.type == ChildNode) stack.append(root.index);
+        int reached = 1;
+        while(!stack.isEmpty())
+        {
+            NodeRecord const &node = nodes[stack.takeLast()];
+            for(int k = 0; k < 2; ++k)
+            {
+                ChildRef const &child = node.child[k];
+                if(child.type == ChildNone) continue;
+
+                if(!validateChild(child, nodeUsed, leafUsed))
+                    throw ReadError("BspCache::validate", "Invalid child");
+
+                reached += 1;
+                if(child.type == ChildNode) stack.append(child.index);
+            }
+        }
+        if(reached != nodes.count() + leafs.count())
+            throw ReadError("BspCache::validate", "Unreachable elements");
+
+        foreach(SideRecord const &rec, sides)
+        {
+            if(rec.side < 0 || rec.side >= lines.count() * 2 ||
+               rec.leftSegment  < -1 || rec.leftSegment  >= segmentCount ||
+               rec.rightSegment < -1 || rec.rightSegment >= segmentCount)
+                throw ReadError("BspCache::validate", "Invalid line side");
+        }
+
+        foreach(UnclosedRecord const &rec, unclosed)
+        {
+            if(rec.sector < 0 || rec.sector >= sectors.count())
+                throw ReadError("BspCache::validate", "Invalid unclosed sector");
+        }
+    }
+
+    Face *buildFace(Mesh &faceMesh, FaceRecord const &face,
+                    QVector<Segment *> &segments)
+    {
+        Face *poly = faceMesh.newFace();
+
+        foreach(HEdgeRecord const &rec, face)
+        {
+            HEdge *hedge = faceMesh.newHEdge(*mesh.vertexes().at(rec.vertex));
+
+            Line::Side *mapSide = 0;
+            if(rec.lineSide >= 0)
+            {
+                mapSide = &lines.at(rec.lineSide / 2)->side(rec.lineSide % 2);
+            }
+
+            Segment *seg = new Segment(mapSide, hedge);
+            hedge->setMapElement(seg);
+
+            seg->setLineSideOffset(rec.lineSideOffset);
+            seg->setLength(rec.length);
+            seg->setAngle(rec.angle);
+
+            hedge->setNext(poly->hedge());
+            poly->setHEdge(hedge);
+
+            segments.append(seg);
+        }
+
+        // Link the half-edges anticlockwise and close the ring.
+        HEdge *hedge = poly->hedge();
+        forever
+        {
+            /// @todo Face should encapsulate.
+            poly->_hedgeCount += 1;
+            hedge->setFace(poly);
+
+            if(hedge->hasNext())
+            {
+                hedge->next().setPrev(hedge);
+                hedge = &hedge->next();
+            }
+            else
+            {
+                hedge->setNext(poly->hedge());
+                hedge->next().setPrev(hedge);
+                break;
+            }
+        }
+
+        /// @todo Face should encapsulate.
+        poly->updateAABox();
+        poly->updateCenter();
+
+        return poly;
+    }
+
+    MapElement *childElement(ChildRef const &ref, BspNodes const &builtNodes,
+                             BspLeafs const &builtLeafs) const
+    {
+        switch(ref.type)
+        {
+        case ChildNode: return builtNodes.at(ref.index);
+        case ChildLeaf: return builtLeafs.at(ref.index);
+        default:        return 0;
+        }
+    }
+
+    /**
+     * Reconstruct the map elements from the (validated) parsed data.
+     */
+    void build(Elements &elements)
+    {
+        foreach(Vector2d const &origin, newVertexes)
+        {
+            mesh.newVertex(origin);
+        }
+
+        QVector<Segment *> segments;
+        segments.reserve(segmentCount);
+
+        QList<FaceRecord const *> faceRecords;
+        foreach(LeafRecord const &rec, leafs)
+        {
+            BspLeaf *leaf = new BspLeaf;
+
+            foreach(FaceRecord const &face, rec.extraFaces)
+            {
+                Mesh *extraMesh = new Mesh;
+                buildFace(*extraMesh, face, segments);
+                leaf->assignExtraMesh(*extraMesh);
+                faceRecords.append(&face);
+            }
+
+            if(rec.sector >= 0)
+            {
+                leaf->setSector(sectors.at(rec.sector));
+            }
+
+            if(rec.hasPoly)
+            {
+                leaf->setPoly(buildFace(mesh, rec.poly, segments));
+                faceRecords.append(&rec.poly);
+            }
+
+            elements.leafs.append(leaf);
+        }
+
+        // Link back segments and finish with the twin half-edges.
+        int segmentIdx = 0;
+        foreach(FaceRecord const *face, faceRecords)
+        foreach(HEdgeRecord const &rec, *face)
+        {
+            Segment *seg = segments[segmentIdx++];
+            HEdge &hedge = seg->hedge();
+
+            if(rec.back >= 0)
+            {
+                Segment *back = segments[rec.back];
+                seg->setBack(back);
+                hedge.setTwin(&back->hedge());
+            }
+            else if(rec.twinVertex >= 0)
+            {
+                // Allocate the twin from the same mesh.
+                hedge.setTwin(hedge.mesh().newHEdge(*mesh.vertexes().at(rec.twinVertex)));
+                hedge.twin().setTwin(&hedge);
+            }
+        }
+
+        foreach(NodeRecord const &rec, nodes)
+        {
+            BspNode *node = new BspNode(rec.partition);
+            node->setRightAABox(&rec.aaBox[BspNode::Right]);
+            node->setLeftAABox(&rec.aaBox[BspNode::Left]);
+            elements.nodes.append(node);
+        }
+        for(int i = 0; i < nodes.count(); ++i)
+        {
+            NodeRecord const &rec = nodes[i];
+            BspNode *node = elements.nodes[i];
+            if(MapElement *right = childElement(rec.child[BspNode::Right], elements.nodes, elements.leafs))
+            {
+                node->setRight(right);
+            }
+            if(MapElement *left = childElement(rec.child[BspNode::Left], elements.nodes, elements.leafs))
+            {
+                node->setLeft(left);
+            }
+        }
+
+        elements.root = childElement(root, elements.nodes, elements.leafs);
+
+        foreach(SideRecord const &rec, sides)
+        {
+            Line::Side &side = lines.at(rec.side / 2)->side(rec.side % 2);
+            side.setLeftSegment(rec.leftSegment >= 0? segments[rec.leftSegment] : 0);
+            side.setRightSegment(rec.rightSegment >= 0? segments[rec.rightSegment] : 0);
+        }
+
+        foreach(UnclosedRecord const &rec, unclosed)
+        {
+            elements.unclosedSectors.append(UnclosedSector(sectors.at(rec.sector), rec.nearPoint));
+        }
+    }
+};
+
+BspCache::BspCache(Mesh &mesh, Lines const &lines, Sectors const &sectors,
+                   LineSet const &linesToBuildFor, int splitCostFactor)
+    : d(new Instance(mesh, lines, sectors, linesToBuildFor))
+{
+    d->composeKey(splitCostFactor);
+}
+
+Block const &BspCache::key() const
+{
+    return d->key;
+}
+
+String BspCache::path() const
+{
+    return String(ddRuntimePath) / CACHE_DIR / QString::fromLatin1(d->key.toHex()) + ".dbsp";
+}
+
+bool BspCache::read(Elements &elements)
+{
+    LOG_AS("BspCache");
+
+    QFile file(path());
+    if(!file.open(QFile::ReadOnly))
+        return false;
+
+    Block data(file.readAll());
+    file.close();
+
+    try
+    {
+        d->parse(data);
+        d->validate();
+    }
+    catch(IByteArray::OffsetError const &er)
+    {
+        // Truncated data, most likely.
+        throw ReadError("BspCache::read", er.asText());
+    }
+
+    d->build(elements);
+    return true;
+}
+
+bool BspCache::write(int firstNewVertex, Elements const &elements) const
+{
+    LOG_AS("BspCache");
+
+    // Assign identifiers to the segments and BSP elements, in the order in
+    // which they will be written.
+    QHash<Segment const *, int> segmentIds;
+    QHash<MapElement const *, int> elementIds;
+    QList<QList<QList<HEdge *> > > leafFaces;
+
+    foreach(BspLeaf *leaf, elements.leafs)
+    {
+        elementIds.insert(leaf, elementIds.count());
+
+        Face const *poly = leaf->hasPoly()? &leaf->poly() : 0;
+
+        // Faces of the extra meshes are not directly accessible; find them
+        // via the segments.
+        QList<Face const *> faces;
+        foreach(Segment *seg, leaf->allSegments())
+        {
+            Face const *face = &seg->hedge().face();
+            if(face != poly && !faces.contains(face))
+                faces.append(face);
+        }
+        if(poly) faces.append(poly);
+
+        leafFaces.append(QList<QList<HEdge *> >());
+        foreach(Face const *face, faces)
+        {
+            QList<HEdge *> hedges = hedgesInCreationOrder(*face);
+            foreach(HEdge *hedge, hedges)
+            {
+                segmentIds.insert(hedge->mapElement()->as<Segment>(), segmentIds.count());
+            }
+            leafFaces.last().append(hedges);
+        }
+    }
+    for(int i = 0; i < elements.nodes.count(); ++i)
+    {
+        elementIds.insert(elements.nodes[i], i);
+    }
+
+    Block data;
+    Writer writer(data);
+
+    writer << CACHE_MAGIC << CACHE_VERSION << d->key;
+
+    writer << dint32(d->mesh.vertexCount() - firstNewVertex);
+    for(int i = firstNewVertex; i < d->mesh.vertexCount(); ++i)
+    {
+        Vector2d const &origin = d->mesh.vertexes().at(i)->origin();
+        writer << origin.x << origin.y;
+    }
+
+    writer << dint32(elements.leafs.count());
+    for(int i = 0; i < elements.leafs.count(); ++i)
+    {
+        BspLeaf const *leaf = elements.leafs[i];
+        QList<QList<HEdge *> > const &faces = leafFaces[i];
+        int const extraCount = faces.count() - (leaf->hasPoly()? 1 : 0);
+
+        writer << Instance::sectorIndex(leaf->hasSector()? &leaf->sector() : 0)
+               << dint32(extraCount);
+        for(int k = 0; k < extraCount; ++k)
+        {
+            Instance::writeFace(writer, faces[k], segmentIds);
+        }
+        writer << duchar(leaf->hasPoly()? 1 : 0);
+        if(leaf->hasPoly())
+        {
+            Instance::writeFace(writer, faces.last(), segmentIds);
+        }
+    }
+
+    writer << dint32(elements.nodes.count());
+    foreach(BspNode *node, elements.nodes)
+    {
+        Partition const &partition = node->partition();
+        writer << partition.direction.x << partition.direction.y
+               << partition.origin.x    << partition.origin.y;
+        for(int k = 0; k < 2; ++k)
+        {
+            AABoxd const &box = node->childAABox(k);
+            writer << box.minX << box.minY << box.maxX << box.maxY;
+        }
+        for(int k = 0; k < 2; ++k)
+        {
+            Instance::writeChild(writer, node->hasChild(k)? &node->child(k) : 0, elementIds);
+        }
+    }
+    Instance::writeChild(writer, elements.root, elementIds);
+
+    QList<SideRecord> sideRecords;
+    foreach(Line *line, d->linesToBuildFor)
+    for(int i = 0; i < 2; ++i)
+    {
+        Line::Side const &side = line->side(i);
+        if(!side.leftSegment() && !side.rightSegment()) continue;
+
+        SideRecord rec;
+        rec.side         = line->indexInMap() * 2 + i;
+        rec.leftSegment  = segmentIds.value(side.leftSegment(),  -1);
+        rec.rightSegment = segmentIds.value(side.rightSegment(), -1);
+        sideRecords.append(rec);
+    }
+    writer << dint32(sideRecords.count());
+    foreach(SideRecord const &rec, sideRecords)
+    {
+        writer << rec.side << rec.leftSegment << rec.rightSegment;
+    }
+
+    writer << dint32(elements.unclosedSectors.count());
+    foreach(UnclosedSector const &unclosed, elements.unclosedSectors)
+    {
+        writer << Instance::sectorIndex(unclosed.sector)
+               << unclosed.nearPoint.x << unclosed.nearPoint.y;
+    }
+
+    // Write to a temporary file first so that an interrupted write does not
+    // leave a truncated cache file behind.
+    String const cachePath = path();
+    QDir().mkpath(cachePath.fileNamePath());
+
+    QFile file(cachePath + ".tmp");
+    if(!file.open(QFile::WriteOnly | QFile::Truncate) ||
+       file.write(data) != data.size())
+    {
+        LOG_WARNING("Failed writing \"%s\".") << NativePath(cachePath).pretty();
+        return false;
+    }
+    file.close();
+
+    QFile::remove(cachePath);
+    if(!QFile::rename(cachePath + ".tmp", cachePath))
+    {
+        LOG_WARNING("Failed writing \"%s\".") << NativePath(cachePath).pretty();
+        return false;
+    }
+
+    LOG_VERBOSE("Wrote \"%s\".") << NativePath(cachePath).pretty();
+    return true;
+}
+
+} // namespace bsp
+} // namespace de
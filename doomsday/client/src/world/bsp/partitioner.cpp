@@ -26,9 +26,11 @@
 
 #include <QList>
 #include <QHash>
+#include <QVector>
 #include <QtAlgorithms>
 
 #include <de/Log>
+#include <de/TaskPool>
 
 #include "world/map.h"
 #include "BspLeaf"
@@ -58,6 +60,27 @@ typedef QList<ConvexSubspace>              ConvexSubspaces;
 typedef QHash<Vertex *, EdgeTips>          EdgeTipSetMap;
 typedef QList<LineSegment *>               LineSegments;
 typedef QList<Line *>                      Lines;
+typedef QVector<LineSegment::Side *>       PartitionCandidates;
+
+/// Minimum number of partition candidates per worker task. With fewer
+/// candidates the costs are evaluated on the calling thread.
+static int const MIN_CANDIDATES_PER_TASK = 32;
+
+/**
+ * A range of partition candidates and the best one found among them.
+ */
+struct PartitionCandidateRange
+{
+    LineSegment::Side *const *begin;
+    LineSegment::Side *const *end;
+    LineSegment::Side *best;
+    PartitionCost bestCost;
+
+    PartitionCandidateRange(LineSegment::Side *const *begin = 0,
+                            LineSegment::Side *const *end = 0)
+        : begin(begin), end(end), best(0)
+    {}
+};
 
 DENG2_PIMPL(Partitioner)
 {
@@ -257,7 +280,7 @@ DENG2_PIMPL(Partitioner)
     }
 
     void evalPartitionCostForSegment(LineSegment::Side const &plSeg,
-        LineSegment::Side const &seg, PartitionCost &cost)
+        LineSegment::Side const &seg, PartitionCost &cost) const
     {
         int const costFactorMultiplier = splitCostFactor;
 
@@ -345,7 +368,7 @@ DENG2_PIMPL(Partitioner)
      */
     bool evalPartitionCostForSuperBlock(SuperBlock const &block,
         LineSegment::Side *best, PartitionCost const &bestCost,
-        LineSegment::Side const &seg, PartitionCost &cost)
+        LineSegment::Side const &seg, PartitionCost &cost) const
     {
         /*
          * Test the whole block against the partition line to quickly handle
@@ -424,7 +447,7 @@ DENG2_PIMPL(Partitioner)
      */
     bool evalPartition(SuperBlock const &block,
                        LineSegment::Side *best, PartitionCost const &bestCost,
-                       LineSegment::Side const &lineSeg, PartitionCost &cost)
+                       LineSegment::Side const &lineSeg, PartitionCost &cost) const
     {
         // Only map line segments are potential candidates.
         if(!lineSeg.hasMapSide()) return false;
@@ -464,22 +487,11 @@ DENG2_PIMPL(Partitioner)
         return true;
     }
 
-    void chooseNextPartitionFromSuperBlock(SuperBlock const &partList,
-        SuperBlock const &segs, LineSegment::Side **best, PartitionCost &bestCost)
+    void collectPartitionCandidates(SuperBlock const &partList,
+                                    PartitionCandidates &candidates)
     {
-        DENG2_ASSERT(best != 0);
-
-        //LOG_AS("chooseNextPartitionFromSuperBlock");
-
-        // Test each line segment as a potential partition.
         foreach(LineSegment::Side *seg, partList.segments())
         {
-            //LOG_DEBUG("%sline segment %p sector:%d %s -> %s")
-            //    << (seg->hasMapLineSide()? "" : "mini-") << de::dintptr(*seg)
-            //    << (seg->sector? seg->sector->indexInMap() : -1)
-            //    << seg->fromOrigin().asText()
-            //    << seg->toOrigin().asText();
-
             // Optimization: Only the first line segment produced from a given
             // line is tested per round of partition costing (they are all
             // collinear).
@@ -491,26 +503,67 @@ DENG2_PIMPL(Partitioner)
                 seg->mapLine().setValidCount(validCount);
             }
 
+            candidates.append(seg);
+        }
+    }
+
+    /**
+     * Evaluate the partition candidates in @a range, finding the best one.
+     * Only reads the partitioner state, so this can be called from worker
+     * threads.
+     */
+    void chooseBestCandidate(SuperBlock const &segs, PartitionCandidateRange &range) const
+    {
+        // Test each line segment as a potential partition.
+        for(LineSegment::Side *const *it = range.begin; it != range.end; ++it)
+        {
+            LineSegment::Side *seg = *it;
+
             // Calculate the cost metrics for this line segment.
             PartitionCost cost;
-            if(evalPartition(segs, *best, bestCost, *seg, cost))
+            if(evalPartition(segs, range.best, range.bestCost, *seg, cost))
             {
                 // Suitable for use as a partition.
-                if(!*best || cost < bestCost)
+                if(!range.best || cost < range.bestCost)
                 {
                     // We have a new better choice.
-                    bestCost = cost;
+                    range.bestCost = cost;
 
                     // Remember which line segment.
-                    *best = seg;
+                    range.best = seg;
                 }
             }
         }
     }
 
+    /**
+     * Function object for evaluating the partition candidate ranges with
+     * TaskPool::parallelFor().
+     */
+    struct CandidateRangeEvaluator
+    {
+        Instance const *inst;
+        SuperBlock const *segs;
+        PartitionCandidateRange *ranges;
+
+        CandidateRangeEvaluator(Instance const &inst, SuperBlock const &segs,
+                                PartitionCandidateRange *ranges)
+            : inst(&inst), segs(&segs), ranges(ranges) {}
+
+        void operator () (int i) const
+        {
+            inst->chooseBestCandidate(*segs, ranges[i]);
+        }
+    };
+
     /**
      * Find the best line segment to use as the next partition.
      *
+     * When there are many candidates they are split into consecutive ranges
+     * that are evaluated concurrently. The best candidate of each range is
+     * then compared in order, so that the first of equally good candidates
+     * is chosen just like when evaluating them one by one.
+     *
      * @param candidates  Candidate line segments to choose from.
      *
      * @return  The chosen line segment.
@@ -519,14 +572,13 @@ DENG2_PIMPL(Partitioner)
     {
         LOG_AS("Partitioner::choosePartition");
 
-        PartitionCost bestCost;
-        LineSegment::Side *best = 0;
-
         // Increment valid count so we can avoid testing the line segments
         // produced from a single line more than once per round of partition
         // selection.
         validCount++;
 
+        PartitionCandidates partCandidates;
+
         // Iterative pre-order traversal of SuperBlock.
         SuperBlock const *cur = &candidates;
         SuperBlock const *prev = 0;
@@ -534,7 +586,7 @@ DENG2_PIMPL(Partitioner)
         {
             while(cur)
             {
-                chooseNextPartitionFromSuperBlock(*cur, candidates, &best, bestCost);
+                collectPartitionCandidates(*cur, partCandidates);
 
                 if(prev == cur->parent())
                 {
@@ -564,6 +616,33 @@ DENG2_PIMPL(Partitioner)
             }
         }
 
+        int const count = partCandidates.count();
+        int const numRanges = de::max(1, de::min(count / MIN_CANDIDATES_PER_TASK,
+                                                 TaskPool::workerCount() + 1));
+
+        QVector<PartitionCandidateRange> ranges(numRanges);
+        for(int i = 0; i < numRanges; ++i)
+        {
+            LineSegment::Side *const *data = partCandidates.constData();
+            ranges[i] = PartitionCandidateRange(data + count * i / numRanges,
+                                                data + count * (i + 1) / numRanges);
+        }
+
+        // Each range is evaluated in its own batch; this thread takes the first.
+        TaskPool::parallelFor(0, numRanges,
+                              CandidateRangeEvaluator(*this, candidates, ranges.data()));
+
+        PartitionCost bestCost;
+        LineSegment::Side *best = 0;
+        foreach(PartitionCandidateRange const &range, ranges)
+        {
+            if(range.best && (!best || range.bestCost < bestCost))
+            {
+                best     = range.best;
+                bestCost = range.bestCost;
+            }
+        }
+
         /*if(best)
         {
             LOG_DEBUG("best %p score: %d.%02d.")
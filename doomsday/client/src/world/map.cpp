@@ -46,6 +46,7 @@
 #include "Segment"
 #include "Vertex"
 
+#include "world/bsp/bspcache.h"
 #include "world/bsp/partitioner.h"
 
 #include "world/blockmap.h"
@@ -85,6 +86,7 @@
 }
 
 static int bspSplitFactor = 7; // cvar
+static byte bspCache = true; // cvar
 
 namespace de {
 
@@ -142,6 +144,9 @@ DENG2_OBSERVES(bsp::Partitioner, UnclosedSectorFound)
     BspNodes bspNodes;
     BspLeafs bspLeafs;
 
+    /// Unclosed sectors found while building the BSP (for the BSP cache).
+    bsp::BspCache::UnclosedSectors bspUnclosedSectors;
+
     /// Map entities and element properties (things, line specials, etc...).
     EntityDatabase entityDatabase;
 
@@ -241,16 +246,27 @@ DENG2_OBSERVES(bsp::Partitioner, UnclosedSectorFound)
         }
     }
 
-    // Observes bsp::Partitioner UnclosedSectorFound.
-    void unclosedSectorFound(Sector &sector, Vector2d const &nearPoint)
+    /**
+     * Notify interested parties that an unclosed sector was found.
+     */
+    void notifyUnclosedSectorFound(Sector &sector, Vector2d const &nearPoint)
     {
-        // Notify interested parties that an unclosed sector was found.
         DENG2_FOR_PUBLIC_AUDIENCE(UnclosedSectorFound, i)
         {
             i->unclosedSectorFound(sector, nearPoint);
         }
     }
 
+    // Observes bsp::Partitioner UnclosedSectorFound.
+    void unclosedSectorFound(Sector &sector, Vector2d const &nearPoint)
+    {
+        // Remember for the BSP cache, so they can be reported again when the
+        // BSP is loaded from it.
+        bspUnclosedSectors.append(bsp::BspCache::UnclosedSector(&sector, nearPoint));
+
+        notifyUnclosedSectorFound(sector, nearPoint);
+    }
+
     /**
      * Notify interested parties of a "one-way window" in the map.
      *
@@ -466,6 +482,79 @@ DENG2_OBSERVES(bsp::Partitioner, UnclosedSectorFound)
         bspNodes.append(node);
     }
 
+    /**
+     * Attribute an index to any new vertexes, beginning with @a firstVertexOrd.
+     */
+    void indexNewVertexes(int firstVertexOrd)
+    {
+        for(int i = firstVertexOrd; i < mesh.vertexCount(); ++i)
+        {
+            Vertex *vtx = mesh.vertexes().at(i);
+            vtx->setMap(thisPublic);
+            vtx->setIndexInMap(i);
+        }
+    }
+
+    /**
+     * Attempt to reconstruct the BSP tree from @a cache.
+     *
+     * @return  @c true if the BSP was found in the cache.
+     */
+    bool loadBspFromCache(bsp::BspCache &cache, int nextVertexOrd)
+    {
+        bsp::BspCache::Elements elements;
+        try
+        {
+            if(!cache.read(elements))
+                return false;
+        }
+        catch(bsp::BspCache::ReadError const &er)
+        {
+            LOG_WARNING("Ignoring cached BSP: %s.") << er.asText();
+            return false;
+        }
+
+        indexNewVertexes(nextVertexOrd);
+
+        bspRoot = elements.root;
+
+#ifdef DENG2_QT_4_7_OR_NEWER
+        bspNodes.reserve(elements.nodes.count());
+        bspLeafs.reserve(elements.leafs.count());
+#endif
+
+        foreach(BspNode *node, elements.nodes)
+        {
+            node->setMap(thisPublic);
+            node->setIndexInMap(bspNodes.count());
+            bspNodes.append(node);
+        }
+
+        foreach(BspLeaf *leaf, elements.leafs)
+        {
+            leaf->setMap(thisPublic);
+            leaf->setIndexInMap(bspLeafs.count());
+            bspLeafs.append(leaf);
+
+            foreach(Segment *seg, leaf->allSegments())
+            {
+                seg->setMap(thisPublic);
+                seg->setIndexInMap(segments.count());
+                segments.append(seg);
+            }
+        }
+
+        foreach(bsp::BspCache::UnclosedSector const &unclosed, elements.unclosedSectors)
+        {
+            notifyUnclosedSectorFound(*unclosed.sector, unclosed.nearPoint);
+        }
+
+        LOG_INFO("BSP loaded from cache: %d Nodes, %d Leafs, %d Segments and %d Vertexes.")
+                << bspNodes.count() << bspLeafs.count() << segments.count()
+                << (mesh.vertexCount() - nextVertexOrd);
+        return true;
+    }
+
     /**
      * Build a BSP tree for the map.
      *
@@ -502,6 +591,18 @@ DENG2_OBSERVES(bsp::Partitioner, UnclosedSectorFound)
             linesToBuildBspFor.remove(line);
         }
 
+        // Perhaps we have already built a BSP for this geometry?
+        QScopedPointer<bsp::BspCache> cache;
+        if(bspCache)
+        {
+            cache.reset(new bsp::BspCache(mesh, lines, sectors, linesToBuildBspFor, bspSplitFactor));
+        }
+        if(cache && loadBspFromCache(*cache, nextVertexOrd))
+        {
+            LOG_INFO(String("BSP loaded in %1 seconds.").arg(begunAt.since(), 0, 'g', 2));
+            return true;
+        }
+
         try
         {
             // Configure a space partitioner.
@@ -519,12 +620,7 @@ DENG2_OBSERVES(bsp::Partitioner, UnclosedSectorFound)
                     << (rootNode->isLeaf()? 0 : rootNode->left().height());
 
             // Attribute an index to any new vertexes.
-            for(int i = nextVertexOrd; i < mesh.vertexCount(); ++i)
-            {
-                Vertex *vtx = mesh.vertexes().at(i);
-                vtx->setMap(thisPublic);
-                vtx->setIndexInMap(i);
-            }
+            indexNewVertexes(nextVertexOrd);
 
             /*
              * Take ownership of all the built map data elements.
@@ -587,6 +683,17 @@ DENG2_OBSERVES(bsp::Partitioner, UnclosedSectorFound)
         // How much time did we spend?
         LOG_INFO(String("BSP built in %1 seconds.").arg(begunAt.since(), 0, 'g', 2));
 
+        if(bspRoot && cache)
+        {
+            bsp::BspCache::Elements elements;
+            elements.root  = bspRoot;
+            elements.nodes = bspNodes;
+            elements.leafs = bspLeafs;
+            elements.unclosedSectors = bspUnclosedSectors;
+            cache->write(nextVertexOrd, elements);
+        }
+        bspUnclosedSectors.clear();
+
         return bspRoot != 0;
     }
 
@@ -1089,6 +1196,7 @@ Map::Map(Uri const &uri) : d(new Instance(this, uri))
 void Map::consoleRegister() // static
 {
     C_VAR_INT("bsp-factor", &bspSplitFactor, CVF_NO_MAX, 0, 0);
+    C_VAR_BYTE("bsp-cache", &bspCache, 0, 0, 1);
 }
 
 Mesh const &Map::mesh() const
@@ -32,6 +32,8 @@
 #include "world/maputil.h"
 #include "MaterialSnapshot"
 
+#include "render/r_framearena.h"
+
 #include "world/p_objlink.h"
 
 using namespace de;
@@ -47,7 +49,6 @@ END_PROF_TIMERS()
 struct objlink_t
 {
     objlink_t *nextInBlock; /// Next in the same obj block, or NULL.
-    objlink_t *nextUsed;
     objlink_t *next; /// Next in list of ALL objlinks.
     objtype_t type;
     void *obj;
@@ -78,7 +79,6 @@ struct contactfinderparams_t
 struct objcontact_t
 {
     objcontact_t *next; /// Next in the BSP leaf.
-    objcontact_t *nextUsed; /// Next used contact.
     void *obj;
 };
 
@@ -88,14 +88,10 @@ struct objcontactlist_t
 };
 
 static objlink_t *objlinks;
-static objlink_t *objlinkFirst, *objlinkCursor;
 
 // Each objlink type gets its own blockmap.
 static objlinkblockmap_t blockmaps[NUM_OBJ_TYPES];
 
-// List of unused and used contacts.
-static objcontact_t *contFirst, *contCursor;
-
 // List of contacts for each BSP leaf.
 static objcontactlist_t *bspLeafContacts;
 
@@ -181,45 +177,20 @@ static void linkContactToBspLeaf(objcontact_t *node, objtype_t type, uint index)
 }
 
 /**
- * Create a new objcontact. If there are none available in the list of
- * used objects a new one will be allocated and linked to the global list.
+ * Create a new objcontact. Contacts are allocated from the frame arena and
+ * are released en masse when the next frame begins.
  */
 static objcontact_t *allocObjContact()
 {
-    objcontact_t *con;
-    if(!contCursor)
-    {
-        con = (objcontact_t *) Z_Malloc(sizeof *con, PU_APPSTATIC, 0);
-
-        // Link to the list of objcontact nodes.
-        con->nextUsed = contFirst;
-        contFirst = con;
-    }
-    else
-    {
-        con = contCursor;
-        contCursor = contCursor->nextUsed;
-    }
+    objcontact_t *con = R_FrameAllocObject<objcontact_t>();
+    con->next = 0;
     con->obj = 0;
     return con;
 }
 
 static objlink_t *allocObjlink()
 {
-    objlink_t *link;
-    if(!objlinkCursor)
-    {
-        link = (objlink_t *) Z_Malloc(sizeof *link, PU_APPSTATIC, 0);
-
-        // Link the link to the global list.
-        link->nextUsed = objlinkFirst;
-        objlinkFirst = link;
-    }
-    else
-    {
-        link = objlinkCursor;
-        objlinkCursor = objlinkCursor->nextUsed;
-    }
+    objlink_t *link = R_FrameAllocObject<objlink_t>();
     link->nextInBlock = 0;
     link->obj = 0;
 
@@ -298,8 +269,7 @@ void R_ClearObjlinksForFrame()
         R_ClearObjlinkBlockmap(objtype_t(i));
     }
 
-    // Start reusing objlinks.
-    objlinkCursor = objlinkFirst;
+    // The objlinks themselves were released along with the frame arena.
     objlinks = 0;
 }
 
@@ -628,8 +598,7 @@ void R_InitForNewFrame()
     }
 #endif
 
-    // Start reusing nodes from the first one in the list.
-    contCursor = contFirst;
+    // The contacts themselves were released along with the frame arena.
     if(bspLeafContacts)
     {
         std::memset(bspLeafContacts, 0, App_World().map().bspLeafCount() * sizeof *bspLeafContacts);
@@ -27,6 +27,7 @@
 #include "de_audio.h"
 
 #include <de/String>
+#include <de/TaskPool>
 #include <de/Time>
 #include <de/fixedpoint.h>
 #include <de/memoryzone.h>
@@ -50,6 +51,9 @@ using namespace de;
 #define VECSUB(a,b)         ( a[VX] -= b[VX], a[VY] -= b[VY] )
 #define VECCPY(a,b)         ( a[VX] = b[VX], a[VY] = b[VY] )
 
+/// Minimum number of particles per batch when applying forces concurrently.
+#define FORCE_BATCH_SIZE    256
+
 BEGIN_PROF_TIMERS()
   PROF_PTCGEN_LINK
 END_PROF_TIMERS()
@@ -865,15 +869,14 @@ float P_GetParticleZ(particle_t const *pt)
     return FIX2FLT(pt->origin[VZ]);
 }
 
-static void P_SpinParticle(ptcgen_t *gen, particle_t *pt)
+/**
+ * @param index  Determines the direction of the spin.
+ */
+static void P_SpinParticle(ded_ptcstage_t const *stDef, particle_t *pt, uint index)
 {
     static int const yawSigns[4]   = { 1,  1, -1, -1 };
     static int const pitchSigns[4] = { 1, -1,  1, -1 };
 
-    ded_ptcstage_t const *stDef = &gen->def->stages[pt->stage];
-    Map &map = App_World().map(); /// @todo Do not assume generator is from the CURRENT map.
-    uint const index = pt - &gen->ptcs[map.generators().generatorId(gen) / 8];
-
     int yawSign   =   yawSigns[index % 4];
     int pitchSign = pitchSigns[index % 4];
 
@@ -891,106 +894,131 @@ static void P_SpinParticle(ptcgen_t *gen, particle_t *pt)
 }
 
 /**
- * The movement is done in two steps:
- * Z movement is done first. Skyflat kills the particle.
- * XY movement checks for hits with solid walls (no backsector).
- * This is supposed to be fast and simple (but not too simple).
+ * Applies spin and all forces to the momentum of the particles of a generator.
+ * Only the particle itself is modified, so batches of particles can be
+ * processed concurrently (see TaskPool::parallelFor()).
  */
-static void P_MoveParticle(ptcgen_t *gen, particle_t *pt)
+struct ParticleForces
 {
-    ptcstage_t *st = &gen->stages[pt->stage];
-    ded_ptcstage_t *stDef = &gen->def->stages[pt->stage];
-    bool zBounce = false, hitFloor = false;
-    vec2d_t point;
-    fixed_t x, y, z, hardRadius = st->radius / 2;
-
-    // Particle rotates according to spin speed.
-    P_SpinParticle(gen, pt);
+    ptcgen_t *gen;
+    fixed_t gravity;    ///< Gravity of the map.
+    uint spinBase;      ///< Offset for choosing the spin directions.
 
-    // Changes to momentum.
-    /// @todo Do not assume generator is from the CURRENT map.
-    pt->mov[VZ] -= FixedMul(FLT2FIX(App_World().map().gravity()), st->gravity);
+    ParticleForces(ptcgen_t *generator, fixed_t mapGravity, uint spinOffset)
+        : gen(generator), gravity(mapGravity), spinBase(spinOffset) {}
 
-    // Vector force.
-    if(stDef->vectorForce[VX] != 0 || stDef->vectorForce[VY] != 0 ||
-       stDef->vectorForce[VZ] != 0)
+    void operator () (int index) const
     {
-        for(int i = 0; i < 3; ++i)
-        {
-            pt->mov[i] += FLT2FIX(stDef->vectorForce[i]);
-        }
-    }
+        particle_t *pt = &gen->ptcs[index];
+        if(pt->stage < 0) return; // Not in use.
 
-    // Sphere force pull and turn.
-    // Only applicable to sourced or untriggered generators. For other
-    // types it's difficult to define the center coordinates.
-    if((st->flags & PTCF_SPHERE_FORCE) &&
-       (gen->source || gen->flags & PGF_UNTRIGGERED))
-    {
-        float delta[3];
+        ptcstage_t const *st = &gen->stages[pt->stage];
+        ded_ptcstage_t const *stDef = &gen->def->stages[pt->stage];
 
-        if(gen->source)
-        {
-            delta[VX] = FIX2FLT(pt->origin[VX]) - gen->source->origin[VX];
-            delta[VY] = FIX2FLT(pt->origin[VY]) - gen->source->origin[VY];
-            delta[VZ] = P_GetParticleZ(pt) - (gen->source->origin[VZ] +
-                FIX2FLT(gen->center[VZ]));
-        }
-        else
+        // Particle rotates according to spin speed.
+        P_SpinParticle(stDef, pt, uint(index) - spinBase);
+
+        // Changes to momentum.
+        pt->mov[VZ] -= FixedMul(gravity, st->gravity);
+
+        // Vector force.
+        if(stDef->vectorForce[VX] != 0 || stDef->vectorForce[VY] != 0 ||
+           stDef->vectorForce[VZ] != 0)
         {
             for(int i = 0; i < 3; ++i)
             {
-                delta[i] = FIX2FLT(pt->origin[i] - gen->center[i]);
+                pt->mov[i] += FLT2FIX(stDef->vectorForce[i]);
             }
         }
 
-        // Apply the offset (to source coords).
-        for(int i = 0; i < 3; ++i)
+        // Sphere force pull and turn.
+        // Only applicable to sourced or untriggered generators. For other
+        // types it's difficult to define the center coordinates.
+        if((st->flags & PTCF_SPHERE_FORCE) &&
+           (gen->source || gen->flags & PGF_UNTRIGGERED))
         {
-            delta[i] -= gen->def->forceOrigin[i];
-        }
-
-        // Counter the aspect ratio of old times.
-        delta[VZ] *= 1.2f;
-
-        float dist = M_ApproxDistancef(M_ApproxDistancef(delta[VX], delta[VY]), delta[VZ]);
+            float delta[3];
 
-        if(dist != 0)
-        {
-            // Radial force pushes the particles on the surface of a sphere.
-            if(gen->def->force)
+            if(gen->source)
+            {
+                delta[VX] = FIX2FLT(pt->origin[VX]) - gen->source->origin[VX];
+                delta[VY] = FIX2FLT(pt->origin[VY]) - gen->source->origin[VY];
+                delta[VZ] = P_GetParticleZ(pt) - (gen->source->origin[VZ] +
+                    FIX2FLT(gen->center[VZ]));
+            }
+            else
             {
-                // Normalize delta vector, multiply with (dist - forceRadius),
-                // multiply with radial force strength.
                 for(int i = 0; i < 3; ++i)
                 {
-                    pt->mov[i] -= FLT2FIX(
-                        ((delta[i] / dist) * (dist - gen->def->forceRadius)) * gen->def->force);
+                    delta[i] = FIX2FLT(pt->origin[i] - gen->center[i]);
                 }
             }
 
-            // Rotate!
-            if(gen->def->forceAxis[VX] || gen->def->forceAxis[VY] ||
-               gen->def->forceAxis[VZ])
+            // Apply the offset (to source coords).
+            for(int i = 0; i < 3; ++i)
             {
-                float cross[3];
-                V3f_CrossProduct(cross, gen->def->forceAxis, delta);
+                delta[i] -= gen->def->forceOrigin[i];
+            }
 
-                for(int i = 0; i < 3; ++i)
+            // Counter the aspect ratio of old times.
+            delta[VZ] *= 1.2f;
+
+            float dist = M_ApproxDistancef(M_ApproxDistancef(delta[VX], delta[VY]), delta[VZ]);
+
+            if(dist != 0)
+            {
+                // Radial force pushes the particles on the surface of a sphere.
+                if(gen->def->force)
+                {
+                    // Normalize delta vector, multiply with (dist - forceRadius),
+                    // multiply with radial force strength.
+                    for(int i = 0; i < 3; ++i)
+                    {
+                        pt->mov[i] -= FLT2FIX(
+                            ((delta[i] / dist) * (dist - gen->def->forceRadius)) * gen->def->force);
+                    }
+                }
+
+                // Rotate!
+                if(gen->def->forceAxis[VX] || gen->def->forceAxis[VY] ||
+                   gen->def->forceAxis[VZ])
                 {
-                    pt->mov[i] += FLT2FIX(cross[i]) >> 8;
+                    float cross[3];
+                    V3f_CrossProduct(cross, gen->def->forceAxis, delta);
+
+                    for(int i = 0; i < 3; ++i)
+                    {
+                        pt->mov[i] += FLT2FIX(cross[i]) >> 8;
+                    }
                 }
             }
         }
-    }
 
-    if(st->resistance != FRACUNIT)
-    {
-        for(int i = 0; i < 3; ++i)
+        if(st->resistance != FRACUNIT)
         {
-            pt->mov[i] = FixedMul(pt->mov[i], st->resistance);
+            for(int i = 0; i < 3; ++i)
+            {
+                pt->mov[i] = FixedMul(pt->mov[i], st->resistance);
+            }
         }
     }
+};
+
+/**
+ * The movement is done in two steps:
+ * Z movement is done first. Skyflat kills the particle.
+ * XY movement checks for hits with solid walls (no backsector).
+ * This is supposed to be fast and simple (but not too simple).
+ *
+ * @pre Forces have been applied to the momentum (see ParticleForces).
+ */
+static void P_MoveParticle(ptcgen_t *gen, particle_t *pt)
+{
+    ptcstage_t *st = &gen->stages[pt->stage];
+    ded_ptcstage_t *stDef = &gen->def->stages[pt->stage];
+    bool zBounce = false, hitFloor = false;
+    vec2d_t point;
+    fixed_t x, y, z, hardRadius = st->radius / 2;
 
     // The particle is 'soft': half of radius is ignored.
     // The exception is plane flat particles, which are rendered flat
@@ -1266,8 +1294,22 @@ void P_PtcGenThinker(ptcgen_t *gen)
             // Play a sound?
             P_ParticleSound(pt->origin, &def->stages[pt->stage].sound);
         }
+    }
+
+    // Apply forces to the momentum of the particles.
+    /// @todo Do not assume generator is from the CURRENT map.
+    Map &map = App_World().map();
+    TaskPool::parallelFor(0, gen->count,
+                          ParticleForces(gen, FLT2FIX(map.gravity()),
+                                         map.generators().generatorId(gen) / 8),
+                          FORCE_BATCH_SIZE);
+
+    // Try to move. Collisions are checked in order, one particle at a time.
+    pt = gen->ptcs;
+    for(int i = 0; i < gen->count; ++i, pt++)
+    {
+        if(pt->stage < 0) continue; // Not in use.
 
-        // Try to move.
         P_MoveParticle(gen, pt);
     }
 }
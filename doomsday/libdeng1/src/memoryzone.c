@@ -31,6 +31,22 @@
  * all of them efficiently. This is possible because no block inside the
  * sequence could be purged by Z_Malloc() anyway.
  *
+ * @par Tag Lists
+ * Every allocated block is also linked into a list of blocks sharing the same
+ * purge tag. Z_FreeTags() walks only the lists of the requested tags, so for
+ * instance freeing all PU_MAP data does not require visiting every block in
+ * every volume.
+ *
+ * @par Block Caches
+ * Small anonymous (user-less) blocks with a common long-lived tag are not
+ * returned to the volume when freed. Instead, they are parked in a cache
+ * selected by the calling thread and handed out again by the next Z_Malloc()
+ * of the same size class and tag from that thread. The caches have their own
+ * locks, so the frequent small allocations made by different threads neither
+ * contend on the zone mutex nor need to walk the rover. Parked blocks still
+ * count as allocated from the volume's point of view; all caches are flushed
+ * back to the volumes whenever tags are purged with Z_FreeTags().
+ *
  * @author Copyright &copy; 1999-2013 Jaakko Keränen <jaakko.keranen@iki.fi>
  * @author Copyright &copy; 2006-2013 Daniel Swanson <danij@dengine.net>
  * @author Copyright &copy; 2006 Jamie Jones <jamie_jones_au@yahoo.com.au>
@@ -68,6 +84,22 @@
 /// Special user pointer for blocks that are in use but have no single owner.
 #define MEMBLOCK_USER_ANONYMOUS    ((void *) 2)
 
+/// Special user pointer for freed blocks that are parked in a block cache.
+#define MEMBLOCK_USER_PARKED       ((void *) 3)
+
+/// Number of block caches. Threads are mapped to the caches by their ID.
+#define BLOCKCACHE_COUNT           16
+
+/// Maximum number of parked blocks in a single size class of a cache.
+#define BLOCKCACHE_MAX_PARKED      32
+
+/// Number of purge tags whose blocks can be parked (see cacheTagIndex()).
+#define BLOCKCACHE_TAG_COUNT       3
+
+/// Allocation sizes served by the block caches.
+static size_t const cacheClassSizes[] = { 16, 32, 48, 64, 96, 128, 192, 256 };
+#define BLOCKCACHE_CLASS_COUNT     (sizeof(cacheClassSizes) / sizeof(cacheClassSizes[0]))
+
 // Used for block allocation of memory from the zone.
 typedef struct zblockset_block_s {
     /// Maximum number of elements.
@@ -83,11 +115,32 @@ typedef struct zblockset_block_s {
     void *elements;
 } zblockset_block_t;
 
+/**
+ * Cache of freed small blocks (see "Block Caches" above). Parked blocks are
+ * linked through the first pointer of their data area.
+ */
+typedef struct blockcache_s {
+    mutex_t mutex;
+    memblock_t *parked[BLOCKCACHE_TAG_COUNT][BLOCKCACHE_CLASS_COUNT];
+    int parkedCount[BLOCKCACHE_TAG_COUNT][BLOCKCACHE_CLASS_COUNT];
+    uint hits;      ///< Allocations served from this cache.
+    uint misses;    ///< Cacheable allocations that had to use the zone.
+} blockcache_t;
+
 static memvolume_t *volumeRoot;
 static memvolume_t *volumeLast;
 
 static mutex_t zoneMutex = 0;
 
+/// Heads of the per-tag lists of allocated blocks. Tags above PU_PURGELEVEL
+/// share the last list.
+static memblock_t *tagLists[PU_PURGELEVEL + 1];
+
+static blockcache_t blockCaches[BLOCKCACHE_COUNT];
+
+/// Number of blocks visited by the rovers while looking for free space.
+static uint roverSteps;
+
 static size_t Z_AllocatedMemory(void);
 static size_t allocatedMemoryInVolume(memvolume_t *volume);
 
@@ -102,6 +155,49 @@ static __inline void unlockZone(void)
     Sys_Unlock(zoneMutex);
 }
 
+static __inline void *blockData(memblock_t *block)
+{
+#ifdef LIBDENG_FAKE_MEMORY_ZONE
+    return block->area;
+#else
+    return (byte *) block + sizeof(memblock_t);
+#endif
+}
+
+static __inline int tagListIndex(int tag)
+{
+    return MINMAX_OF(0, tag, PU_PURGELEVEL);
+}
+
+/**
+ * Links an allocated block into the list of its tag. Zone must be locked.
+ */
+static void linkToTagList(memblock_t *block)
+{
+    memblock_t **head = &tagLists[tagListIndex(block->tag)];
+
+    block->tagPrev = NULL;
+    block->tagNext = *head;
+    if(*head) (*head)->tagPrev = block;
+    *head = block;
+}
+
+/**
+ * Unlinks an allocated block from the list of its tag. Zone must be locked.
+ */
+static void unlinkFromTagList(memblock_t *block)
+{
+    if(block->tagPrev)
+        block->tagPrev->tagNext = block->tagNext;
+    else
+        tagLists[tagListIndex(block->tag)] = block->tagNext;
+
+    if(block->tagNext)
+        block->tagNext->tagPrev = block->tagPrev;
+
+    block->tagNext = block->tagPrev = NULL;
+}
+
 /**
  * Conversion from string to long, with the "k" and "m" suffixes.
  */
@@ -178,8 +274,18 @@ boolean Z_IsInited(void)
 
 int Z_Init(void)
 {
+    int i;
+
     zoneMutex = Sys_CreateMutex("ZONE_MUTEX");
 
+    memset(tagLists, 0, sizeof(tagLists));
+    memset(blockCaches, 0, sizeof(blockCaches));
+    for(i = 0; i < BLOCKCACHE_COUNT; ++i)
+    {
+        blockCaches[i].mutex = Sys_CreateMutex("ZONE_CACHE_MUTEX");
+    }
+    roverSteps = 0;
+
     // Create the first volume.
     createVolume(MEMORY_VOLUME_SIZE);
     return true;
@@ -211,6 +317,15 @@ void Z_Shutdown(void)
     LogBuffer_Printf(DE2_LOG_INFO,
             "Z_Shutdown: Used %i volumes, total %u bytes.\n", numVolumes, totalMemory);
 
+    { int i;
+    for(i = 0; i < BLOCKCACHE_COUNT; ++i)
+    {
+        Sys_DestroyMutex(blockCaches[i].mutex);
+    }
+    memset(blockCaches, 0, sizeof(blockCaches));
+    }
+    memset(tagLists, 0, sizeof(tagLists));
+
     Sys_DestroyMutex(zoneMutex);
     zoneMutex = 0;
 }
@@ -267,6 +382,8 @@ static void freeBlock(void *ptr, memblock_t **tracked)
     // The block was allocated from this volume.
     volume = block->volume;
 
+    unlinkFromTagList(block);
+
     if(block->user > (void **) 0x100) // Smaller values are not pointers.
         *block->user = 0; // Clear the user's mark.
     block->user = NULL; // Mark as free.
@@ -342,8 +459,170 @@ static void freeBlock(void *ptr, memblock_t **tracked)
     unlockZone();
 }
 
+#ifndef LIBDENG_FAKE_MEMORY_ZONE
+
+/**
+ * Returns the index of the block cache lists used for blocks with purge tag
+ * @a tag, or -1 if blocks with the tag are never parked.
+ */
+static int cacheTagIndex(int tag)
+{
+    switch(tag)
+    {
+    case PU_APPSTATIC:  return 0;
+    case PU_GAMESTATIC: return 1;
+    case PU_MAP:        return 2;
+    default:            return -1;
+    }
+}
+
+/**
+ * Returns the smallest size class that can hold @a size bytes, or -1.
+ */
+static int cacheClassForRequest(size_t size)
+{
+    int i;
+    for(i = 0; i < (int) BLOCKCACHE_CLASS_COUNT; ++i)
+    {
+        if(size <= cacheClassSizes[i]) return i;
+    }
+    return -1;
+}
+
+/**
+ * Returns the largest size class that fits in a data area of @a dataSize
+ * bytes, or -1 if the block is not suitable for parking.
+ */
+static int cacheClassForBlock(size_t dataSize)
+{
+    int i;
+    if(dataSize > cacheClassSizes[BLOCKCACHE_CLASS_COUNT - 1] + MINFRAGMENT)
+        return -1;
+
+    for(i = BLOCKCACHE_CLASS_COUNT - 1; i >= 0; --i)
+    {
+        if(dataSize >= cacheClassSizes[i]) return i;
+    }
+    return -1;
+}
+
+/**
+ * Returns the block cache of the calling thread.
+ */
+static __inline blockcache_t *currentBlockCache(void)
+{
+    uint32_t id = Sys_CurrentThreadId();
+    return &blockCaches[((id >> 4) ^ (id >> 12)) % BLOCKCACHE_COUNT];
+}
+
+/**
+ * Attempts to reuse a parked block for a new anonymous allocation.
+ *
+ * @return  Data area of the reused block, or @c NULL if there was nothing
+ * suitable in the calling thread's cache.
+ */
+static void *allocateFromCache(int tagIndex, int sizeClass)
+{
+    blockcache_t *cache = currentBlockCache();
+    memblock_t *block;
+
+    Sys_Lock(cache->mutex);
+    block = cache->parked[tagIndex][sizeClass];
+    if(block)
+    {
+        cache->parked[tagIndex][sizeClass] = *(memblock_t **) blockData(block);
+        cache->parkedCount[tagIndex][sizeClass]--;
+        block->user = MEMBLOCK_USER_ANONYMOUS;
+        cache->hits++;
+    }
+    else
+    {
+        cache->misses++;
+    }
+    Sys_Unlock(cache->mutex);
+
+    return block? blockData(block) : NULL;
+}
+
+/**
+ * Attempts to park a block that is being freed in the calling thread's cache.
+ *
+ * @return  @c true if the block was parked. Otherwise the block must be
+ * returned to its volume.
+ */
+static boolean parkBlock(memblock_t *block)
+{
+    blockcache_t *cache;
+    int tagIndex, sizeClass;
+    boolean parked = false;
+
+    if(block->user != MEMBLOCK_USER_ANONYMOUS || block->seqFirst) return false;
+    if((tagIndex = cacheTagIndex(block->tag)) < 0) return false;
+    if((sizeClass = cacheClassForBlock(block->size - sizeof(memblock_t))) < 0) return false;
+
+    cache = currentBlockCache();
+    Sys_Lock(cache->mutex);
+    if(cache->parkedCount[tagIndex][sizeClass] < BLOCKCACHE_MAX_PARKED)
+    {
+        block->user = MEMBLOCK_USER_PARKED;
+        *(memblock_t **) blockData(block) = cache->parked[tagIndex][sizeClass];
+        cache->parked[tagIndex][sizeClass] = block;
+        cache->parkedCount[tagIndex][sizeClass]++;
+        parked = true;
+    }
+    Sys_Unlock(cache->mutex);
+
+    return parked;
+}
+
+/**
+ * Returns all parked blocks back to their volumes. The zone must be locked.
+ */
+static void flushBlockCaches(void)
+{
+    int i, t, c;
+
+    for(i = 0; i < BLOCKCACHE_COUNT; ++i)
+    {
+        blockcache_t *cache = &blockCaches[i];
+
+        Sys_Lock(cache->mutex);
+        for(t = 0; t < BLOCKCACHE_TAG_COUNT; ++t)
+        for(c = 0; c < (int) BLOCKCACHE_CLASS_COUNT; ++c)
+        {
+            while(cache->parked[t][c])
+            {
+                memblock_t *block = cache->parked[t][c];
+                cache->parked[t][c] = *(memblock_t **) blockData(block);
+                freeBlock(blockData(block), 0);
+            }
+            cache->parkedCount[t][c] = 0;
+        }
+        Sys_Unlock(cache->mutex);
+    }
+}
+
+#endif // !LIBDENG_FAKE_MEMORY_ZONE
+
 void Z_Free(void *ptr)
 {
+#ifndef LIBDENG_FAKE_MEMORY_ZONE
+    if(ptr)
+    {
+        memblock_t *block = Z_GetBlock(ptr);
+        if(block->id == LIBDENG_ZONEID)
+        {
+            if(block->user == MEMBLOCK_USER_PARKED)
+            {
+                DENG_ASSERT(!"Z_Free: double free");
+                LogBuffer_Printf(DE2_LOG_WARNING,
+                        "Attempted to free an already freed block.\n");
+                return;
+            }
+            if(parkBlock(block)) return;
+        }
+    }
+#endif
     freeBlock(ptr, 0);
 }
 
@@ -454,6 +733,22 @@ void *Z_Malloc(size_t size, int tag, void *user)
         return NULL;
     }
 
+#ifndef LIBDENG_FAKE_MEMORY_ZONE
+    if(!user)
+    {
+        int const tagIndex  = cacheTagIndex(tag);
+        int const sizeClass = cacheClassForRequest(size);
+        if(tagIndex >= 0 && sizeClass >= 0)
+        {
+            void *ptr = allocateFromCache(tagIndex, sizeClass);
+            if(ptr) return ptr;
+
+            // Allocate the full size class so the block can be parked later.
+            size = cacheClassSizes[sizeClass];
+        }
+    }
+#endif
+
     lockZone();
 
     // Align to pointer size.
@@ -564,6 +859,8 @@ void *Z_Malloc(size_t size, int tag, void *user)
             }
         }
 
+        roverSteps += numChecked;
+
         // At this point we've found/created a big enough block or we are
         // skipping this volume entirely.
 
@@ -597,6 +894,7 @@ void *Z_Malloc(size_t size, int tag, void *user)
             iter->user = MEMBLOCK_USER_ANONYMOUS; // mark as in use, but unowned
         }
         iter->tag = tag;
+        linkToTagList(iter);
 
         if(tag == PU_MAPSTATIC)
         {
@@ -673,29 +971,32 @@ void *Z_Realloc(void *ptr, size_t n, int mallocTag)
 
 void Z_FreeTags(int lowTag, int highTag)
 {
-    memvolume_t *volume;
-    memblock_t *block, *next;
+    int i;
 
     LogBuffer_Printf(DE2_LOG_DEBUG,
             "MemoryZone: Free'ing all blocks in tag range:[%i, %i)\n",
             lowTag, highTag+1);
 
-    for(volume = volumeRoot; volume; volume = volume->next)
+    lockZone();
+
+#ifndef LIBDENG_FAKE_MEMORY_ZONE
+    // Parked blocks are returned to the volumes so that none of them are left
+    // referencing memory that is about to be freed.
+    flushBlockCaches();
+#endif
+
+    // Only the lists of the affected tags need to be visited.
+    for(i = tagListIndex(lowTag); i <= tagListIndex(highTag); ++i)
     {
-        for(block = volume->zone->blockList.next;
-            block != &volume->zone->blockList;
-            block = next)
+        memblock_t *block, *next;
+        for(block = tagLists[i]; block; block = next)
         {
-            next = block->next;
+            next = block->tagNext;
 
-            if(block->user) // An allocated block?
+            // The last list is shared by all tags above PU_PURGELEVEL.
+            if(block->tag >= lowTag && block->tag <= highTag)
             {
-                if(block->tag >= lowTag && block->tag <= highTag)
-#ifdef LIBDENG_FAKE_MEMORY_ZONE
-                    Z_Free(block->area);
-#else
-                    Z_Free((byte *) block + sizeof(memblock_t));
-#endif
+                freeBlock(blockData(block), 0);
             }
         }
     }
@@ -703,6 +1004,8 @@ void Z_FreeTags(int lowTag, int highTag)
     // Now that there's plenty of new free space, let's keep the static
     // rover near the beginning of the volume.
     rewindStaticRovers();
+
+    unlockZone();
 }
 
 void Z_CheckHeap(void)
@@ -825,7 +1128,9 @@ void Z_ChangeTag2(void *ptr, int tag)
         }
         else
         {
+            unlinkFromTagList(block);
             block->tag = tag;
+            linkToTagList(block);
         }
     }
     unlockZone();
@@ -1041,6 +1346,21 @@ void Z_PrintStatus(void)
     LogBuffer_Printf(DE2_LOG_DEBUG,
             "Memory zone status: %u volumes, %u bytes allocated, %u bytes free (%f%% in use)\n",
             Z_VolumeCount(), (uint)allocated, (uint)wasted, (float)allocated/(float)(allocated+wasted)*100.f);
+
+#ifndef LIBDENG_FAKE_MEMORY_ZONE
+    {
+        uint hits = 0, misses = 0;
+        int i;
+        for(i = 0; i < BLOCKCACHE_COUNT; ++i)
+        {
+            hits   += blockCaches[i].hits;
+            misses += blockCaches[i].misses;
+        }
+        LogBuffer_Printf(DE2_LOG_DEBUG,
+                "Memory zone block caches: %u hits, %u misses; %u rover steps\n",
+                hits, misses, roverSteps);
+    }
+#endif
 }
 
 /**
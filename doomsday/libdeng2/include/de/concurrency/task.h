@@ -38,6 +38,11 @@ public:
     virtual ~Task() {}
 
     TaskPool &pool() const;
+
+    /**
+     * Runs the task. Exceptions thrown by runTask() are caught and logged.
+     * Called by the TaskPool's scheduler.
+     */
     void run();
 
     /**
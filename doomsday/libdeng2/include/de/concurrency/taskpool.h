@@ -22,14 +22,50 @@
 #include <QObject>
 
 #include "../libdeng2.h"
+#include "../math.h"
+#include "task.h"
 
 namespace de {
 
-class Task;
+namespace internal {
+
+class TaskScheduler;
+
+/// Task that calls a function object for a range of indices (see TaskPool::parallelFor()).
+template <typename Func>
+class RangeTask : public Task
+{
+public:
+    RangeTask(Func const &func, int begin, int end)
+        : _func(func), _begin(begin), _end(end) {}
+
+    void runTask() {
+        for(int i = _begin; i < _end; ++i) _func(i);
+    }
+
+private:
+    Func _func;
+    int _begin;
+    int _end;
+};
+
+} // namespace internal
 
 /**
  * Pool of concurrent tasks.
  *
+ * All pools share one work-stealing scheduler. It has a fixed set of worker
+ * threads, and each worker has its own task deques for each priority level.
+ * A worker runs the newest task from its own deque first. When that is empty,
+ * it takes the oldest queued task of the highest available priority from
+ * another worker. Tasks started from a worker thread (i.e., from within
+ * another task) go into that worker's deque. Tasks started from other threads
+ * are queued in a shared injection queue.
+ *
+ * A TaskPool also acts as a task group: waitForDone() waits only for the
+ * tasks started via this pool. The waiting thread does not sit idle; it runs
+ * the pool's queued tasks itself until none remain.
+ *
  * While TaskPool allows the user to monitor whether all tasks are done and
  * block until that time arrives (TaskPool::waitForDone()), no facilities are
  * provided for interrupting any of the started tasks. If that is required, the
@@ -48,6 +84,18 @@ public:
         HighPriority   = 2
     };
 
+    /**
+     * Statistics of the shared scheduler.
+     */
+    struct Counters
+    {
+        int workerCount;    ///< Number of worker threads.
+        int queuedTasks;    ///< Tasks waiting to be run (queue depth).
+        int runningTasks;   ///< Tasks currently being run.
+        duint64 tasksRun;   ///< Total number of tasks run so far.
+        duint64 tasksStolen;///< Tasks taken from another worker's deque.
+    };
+
 public:
     TaskPool();
 
@@ -63,7 +111,9 @@ public:
     void start(Task *task, Priority priority = LowPriority);
 
     /**
-     * Blocks execution until all running tasks have finished.
+     * Blocks execution until all tasks started in this pool have finished.
+     * Meanwhile, the calling thread runs any of the pool's tasks that are
+     * still queued.
      */
     void waitForDone();
 
@@ -72,12 +122,64 @@ public:
      */
     bool isDone() const;
 
+    /**
+     * Calls @a func for each index in the range [@a begin, @a end) using
+     * all the worker threads and the calling thread. Returns when all the
+     * calls have returned. @a func is copied for each batch of indices, and
+     * the copies may be called concurrently.
+     *
+     * @param begin      First index.
+     * @param end        End of the range (not included).
+     * @param func       Function object: void operator () (int index).
+     * @param grainSize  Minimum number of indices per batch.
+     */
+    template <typename Func>
+    static void parallelFor(int begin, int end, Func const &func, int grainSize = 1)
+    {
+        if(end <= begin) return;
+
+        int const count = end - begin;
+        int batches = de::min(count / de::max(grainSize, 1), workerCount() * 4);
+        if(batches <= 1)
+        {
+            for(int i = begin; i < end; ++i) func(i);
+            return;
+        }
+
+        TaskPool group;
+        for(int b = 1; b < batches; ++b)
+        {
+            group.start(new internal::RangeTask<Func>(func, begin + int(dint64(count) * b / batches),
+                                                      begin + int(dint64(count) * (b + 1) / batches)),
+                        HighPriority);
+        }
+
+        // The first batch is ours.
+        internal::RangeTask<Func>(func, begin, begin + count / batches).runTask();
+
+        group.waitForDone();
+    }
+
+    /**
+     * Returns the number of worker threads in the shared scheduler.
+     */
+    static int workerCount();
+
+    /**
+     * Returns the current statistics of the shared scheduler.
+     */
+    static Counters counters();
+
 signals:
+    /**
+     * Emitted when the last started task has finished, in the thread that ran
+     * it. This may be a worker thread or a thread inside waitForDone().
+     */
     void allTasksDone();
 
 private:
-    friend class Task;
-    void taskFinished(Task &task);
+    friend class internal::TaskScheduler;
+    void taskFinished();
 
     DENG2_PRIVATE(d)
 };
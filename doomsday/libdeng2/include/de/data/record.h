@@ -58,6 +58,7 @@ public:
     DENG2_ERROR(UnnamedError);
 
     typedef QMap<String, Variable *> Members;
+    typedef duint32 Key;
     typedef QMap<String, Record *> Subrecords;
     typedef std::pair<String, String> KeyValue;
     typedef QList<KeyValue> List;
@@ -293,6 +294,31 @@ public:
      */
     Record const &subrecord(String const &name) const;
 
+    /**
+     * Looks up a member variable of the record by its interned name. Unlike
+     * operator [], this does not look into subrecords.
+     *
+     * The record indexes the keys it is asked about as they are looked up, and
+     * drops the index when members are added or removed. Adding and removing
+     * members therefore costs nothing extra, but the lookup modifies the
+     * record's internal state.
+     *
+     * @param memberKey  Key of the member's name (see key()).
+     * @param name       Name of the member. Only used when @a memberKey has
+     *                   not been looked up since the membership last changed.
+     *
+     * @return  Variable, or @c NULL if there is no such member.
+     */
+    Variable *findMember(Key memberKey, String const &name);
+
+    /**
+     * Returns a number that changes every time a member is added to or
+     * removed from the record. The numbers are never reused by any other
+     * record, so a (record, stamp) pair can be used for validating cached
+     * results of member lookups.
+     */
+    duint32 membershipStamp() const;
+
     /**
      * Returns a non-modifiable map of the members.
      */
@@ -348,6 +374,26 @@ public:
     // Observes Variable deletion.
     void variableBeingDeleted(Variable &variable);
 
+    /**
+     * Interns a member name. Names are case sensitive and the keys are shared
+     * by all records, so a key can be looked up once and then used with
+     * findMember() in any record. Each call must be balanced by a call to
+     * releaseKey(). Keys are never reused for other names. Thread-safe.
+     *
+     * @param name  Member name (not a path).
+     *
+     * @return  Key of the name; never zero.
+     */
+    static Key key(String const &name);
+
+    /**
+     * Releases a key acquired with key(). The name is removed from the pool
+     * of interned names when it has no more keys in use. Thread-safe.
+     *
+     * @param name  Member name.
+     */
+    static void releaseKey(String const &name);
+
 private:
     DENG2_PRIVATE(d)
 };
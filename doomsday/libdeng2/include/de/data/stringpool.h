@@ -30,7 +30,8 @@
 namespace de {
 
 /**
- * Container data structure for a set of unique case-insensitive strings.
+ * Container data structure for a set of unique strings. The strings are
+ * case-insensitive unless the pool is constructed as case-sensitive.
  * Comparable to a @c std::set with unique IDs assigned to each contained string.
  *
  * The term "intern" is used here to refer to the act of inserting a string to
@@ -39,7 +40,7 @@ namespace de {
  *
  * Each string that actually gets added to the pool is assigned a unique
  * identifier. If one tries to intern a string that already exists in the pool
- * (case insensitively speaking), no new internal copy is created and no new
+ * (case insensitively speaking, by default), no new internal copy is created and no new
  * identifier is assigned. Instead, the existing id of the previously interned
  * string is returned. The string identifiers are not unique over the lifetime
  * of the container: if a string is removed from the pool, its id is free to be
@@ -51,8 +52,6 @@ namespace de {
  * The implementation has, at worst, O(log n) complexity for addition, removal,
  * string lookup, and user value/pointer set/get.
  *
- * @todo Add case-sensitive mode.
- *
  * @ingroup data
  */
 class DENG2_PUBLIC StringPool : public ISerializable
@@ -71,8 +70,11 @@ public:
 public:
     /**
      * Constructs an empty StringPool.
+     *
+     * @param sensitivity  Whether strings differing only by case are
+     *                     considered different strings.
      */
-    StringPool();
+    explicit StringPool(Qt::CaseSensitivity sensitivity = Qt::CaseInsensitive);
 
     /**
      * Constructs an empty StringPool and interns a number of strings.
@@ -23,6 +23,7 @@
 #include "../libdeng2.h"
 #include "../IByteArray"
 #include "../Address"
+#include "../Block"
 #include "../Transmitter"
 
 #include <QTcpSocket>
@@ -36,6 +37,7 @@
 namespace de {
 
 class Message;
+class EncodedMessage;
 
 /**
  * TCP/IP network socket.
@@ -142,6 +144,14 @@ public:
      */
     Socket &operator << (IByteArray const &data);
 
+    /**
+     * Sends a message that has already been encoded. Use this when the same
+     * message is sent to multiple sockets, so that it is compressed only once.
+     *
+     * @param message  Encoded message.
+     */
+    void send(EncodedMessage const &message);
+
     /**
      * Returns the next received message. If nothing has been received,
      * returns @c NULL.
@@ -246,6 +256,45 @@ private:
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Socket::HeaderFlags)
 
+/**
+ * Message that has been compressed and prefixed with its header, ready to be
+ * written to any number of Sockets as is.
+ *
+ * Compressing the payload is the most expensive part of sending a message.
+ * When the same message is sent to multiple recipients (e.g., a broadcast),
+ * it should be encoded once and the EncodedMessage sent via each Socket.
+ * The encoded bytes are immutable and implicitly shared, so copying an
+ * EncodedMessage is cheap.
+ */
+class DENG2_PUBLIC EncodedMessage
+{
+public:
+    EncodedMessage();
+
+    /**
+     * Encodes a message.
+     *
+     * @param packet  Message payload.
+     *
+     * @throws Socket::ProtocolError  The payload could not be compressed or
+     *                                is too large.
+     */
+    EncodedMessage(IByteArray const &packet);
+
+    /// Determines if the message is empty (nothing has been encoded).
+    bool isEmpty() const;
+
+    /// Returns the size of the encoded message, including the header.
+    dsize size() const;
+
+    /// Returns the encoded message, including the header.
+    Block const &bytes() const;
+
+private:
+    Block _bytes;
+};
+
+
 } // namespace de
 
 #endif // LIBDENG2_SOCKET_H
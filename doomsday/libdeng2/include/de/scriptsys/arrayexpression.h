@@ -54,6 +54,8 @@ public:
 
     void push(Evaluator &evaluator, Record *names = 0) const;
 
+    void flatten(ExpressionSequence &seq, int scope = -1) const;
+
     /**
      * Returns one of the expressions in the array.
      *
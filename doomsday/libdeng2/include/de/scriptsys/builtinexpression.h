@@ -67,6 +67,8 @@ public:
 
     void push(Evaluator &evaluator, Record *names = 0) const;
 
+    void flatten(ExpressionSequence &seq, int scope = -1) const;
+
     Value *evaluate(Evaluator &evaluator) const;
 
     // Implements ISerializable.
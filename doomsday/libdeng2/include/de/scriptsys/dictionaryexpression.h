@@ -50,6 +50,8 @@ public:
 
     void push(Evaluator &evaluator, Record *names = 0) const;
 
+    void flatten(ExpressionSequence &seq, int scope = -1) const;
+
     /**
      * Collects the result keys and values of the arguments and puts them
      * into a dictionary.
@@ -71,7 +71,8 @@ public:
 
     /**
      * Fully evaluate the given expression. The result value will remain
-     * in the results stack.
+     * in the results stack. A prepared expression is evaluated in the
+     * order of its evaluation sequence (see Expression::sequence()).
      *
      * @return  Result of the evaluation.
      */
@@ -163,6 +164,7 @@ public:
     Value &result();
 
 private:
+    void evaluateStack();
     void clearNames();
     void clearResults();
     void clearStack();
@@ -187,6 +189,9 @@ private:
     Expressions _stack;
     Results _results;
 
+    /// Namespaces of the scope slots of the current evaluation sequence.
+    std::vector<Record *> _scopes;
+
     /// Returned when there is no result to give.
     NoneValue _noResult;
 };
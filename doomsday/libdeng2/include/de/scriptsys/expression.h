@@ -29,6 +29,7 @@ namespace de {
 class Evaluator;
 class Value;
 class Record;
+class ExpressionSequence;
 
 /**
  * Base class for expressions.
@@ -86,10 +87,35 @@ public:
     Q_DECLARE_FLAGS(Flags, Flag)
 
 public:
+    Expression();
+
     virtual ~Expression();
 
     virtual void push(Evaluator &evaluator, Record *names = 0) const;
 
+    /**
+     * Appends the steps that evaluate the expression to @a seq. The
+     * subexpressions are evaluated in the same order as when pushed with push().
+     *
+     * @param seq    Steps are appended here.
+     * @param scope  Scope slot of the namespace given to push(), or -1.
+     */
+    virtual void flatten(ExpressionSequence &seq, int scope = -1) const;
+
+    /**
+     * Flattens the expression into its evaluation sequence. The statement
+     * that owns the expression does this once the expression tree has been
+     * built or deserialized. Must be done again if the tree is modified.
+     */
+    void prepare();
+
+    /**
+     * Returns the evaluation sequence of the expression, or @c NULL if the
+     * expression has not been prepared. Evaluator walks the tree of an
+     * unprepared expression instead.
+     */
+    ExpressionSequence const *sequence() const;
+
     virtual Value *evaluate(Evaluator &evaluator) const = 0;
 
     /**
@@ -139,6 +165,9 @@ protected:
 
 private:
     Flags _flags;
+
+    /// Evaluation sequence (owned), or @c NULL.
+    ExpressionSequence *_sequence;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Expression::Flags)
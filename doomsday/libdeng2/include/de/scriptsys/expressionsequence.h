@@ -0,0 +1,108 @@
+/** @file expressionsequence.h  Evaluation order of an expression tree.
+ *
+ * @authors Copyright (c) 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#ifndef LIBDENG2_EXPRESSIONSEQUENCE_H
+#define LIBDENG2_EXPRESSIONSEQUENCE_H
+
+#include "../libdeng2.h"
+
+#include <vector>
+
+namespace de {
+
+class Expression;
+
+/**
+ * Expression tree flattened into the order in which its subexpressions are
+ * evaluated (postfix order).
+ *
+ * Evaluator executes the steps in order. The operands of each evaluated
+ * expression have already been placed in the result stack by the preceding
+ * steps, so the tree does not need to be walked and pushed on the evaluation
+ * stack every time the expression is evaluated. The expressions themselves
+ * still do the evaluating; names, for instance, are looked up when they are
+ * evaluated because script namespaces can change at any time.
+ *
+ * The namespace of a member reference (e.g., "a.b") is only known once the
+ * left side has been evaluated. It is kept in a numbered scope slot that is
+ * assigned by a Scope step and used by the Evaluate step of the expression
+ * that was pushed with the namespace.
+ *
+ * @ingroup script
+ */
+class DENG2_PUBLIC ExpressionSequence
+{
+public:
+    enum StepType {
+        /// Evaluate an expression whose operands are in the result stack.
+        Evaluate,
+
+        /// Pop a record value from the result stack and assign it to a scope slot.
+        Scope
+    };
+
+    struct Step {
+        StepType type;
+        Expression const *expression;
+        int scope; ///< Scope slot used (Evaluate) or assigned (Scope); -1 if none.
+
+        Step(StepType t, Expression const *expr, int s)
+            : type(t), expression(expr), scope(s) {}
+    };
+    typedef std::vector<Step> Steps;
+
+public:
+    ExpressionSequence();
+
+    void clear();
+
+    /**
+     * Appends a step that evaluates @a expression.
+     *
+     * @param expression  Expression to evaluate.
+     * @param scope       Scope slot for the namespace of the expression, or -1
+     *                    if the default namespaces are used.
+     */
+    void addEvaluate(Expression const *expression, int scope = -1);
+
+    /**
+     * Allocates a new scope slot and appends a step that assigns the record
+     * in the result stack to it.
+     *
+     * @param expression  Member operator expression whose left side defines
+     *                    the scope.
+     *
+     * @return  Scope slot.
+     */
+    int addScope(Expression const *expression);
+
+    Steps const &steps() const { return _steps; }
+
+    /**
+     * Returns the number of scope slots used by the steps.
+     */
+    int scopeCount() const { return _scopeCount; }
+
+private:
+    Steps _steps;
+    int _scopeCount;
+};
+
+} // namespace de
+
+#endif // LIBDENG2_EXPRESSIONSEQUENCE_H
@@ -40,7 +40,7 @@ public:
      *
      * @param expression  Statement gets ownership.
      */
-    ExpressionStatement(Expression *expression = 0) : _expression(expression) {}
+    ExpressionStatement(Expression *expression = 0);
 
     ~ExpressionStatement();
 
@@ -40,8 +40,7 @@ class ForStatement : public Statement
 public:
     ForStatement();
 
-    ForStatement(Expression *iter, Expression *iteration)
-        : _iterator(iter), _iteration(iteration) {}
+    ForStatement(Expression *iter, Expression *iteration);
 
     ~ForStatement();
 
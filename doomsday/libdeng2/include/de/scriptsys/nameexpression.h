@@ -22,8 +22,10 @@
 
 #include "../Expression"
 #include "../String"
+#include "../Record"
 
 #include <QFlags>
+#include <QAtomicInt>
 
 namespace de {
 
@@ -59,8 +61,29 @@ public:
     void operator >> (Writer &to) const;
     void operator << (Reader &from);
 
+private:
+    void setIdentifier(String const &identifier);
+
 private:
     String _identifier;
+    Record::Key _key;
+
+    /**
+     * Result of the previous namespace search. Valid as long as the same
+     * namespaces are searched and their memberships have not changed. Only
+     * the evaluation that has set @a _cacheBusy may access it.
+     */
+    struct LookupCache {
+        enum { MAX_SPACES = 4 };
+        int count;                  ///< Namespaces searched; zero if empty.
+        Record *spaces[MAX_SPACES];
+        duint32 stamps[MAX_SPACES];
+        Variable *variable;         ///< Found in the last searched namespace.
+
+        LookupCache() : count(0), variable(0) {}
+    };
+    mutable LookupCache _cache;
+    mutable QAtomicInt _cacheBusy;
 };
 
 } // namespace de
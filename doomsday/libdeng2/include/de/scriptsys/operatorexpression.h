@@ -78,6 +78,8 @@ public:
 
     void push(Evaluator &evaluator, Record *names = 0) const;
 
+    void flatten(ExpressionSequence &seq, int scope = -1) const;
+
     Value *evaluate(Evaluator &evaluator) const;
 
     /**
@@ -88,6 +90,16 @@ public:
      */
     static void verifyAssignable(Value *value);
 
+    /**
+     * Determines the namespace where the right operand of a MEMBER operator
+     * is evaluated.
+     *
+     * @param leftValue  Result of the left operand.
+     *
+     * @return  Scope for the right operand.
+     */
+    static Record *memberScope(Value const &leftValue);
+
     // Implements ISerializable.
     void operator >> (Writer &to) const;
     void operator << (Reader &from);
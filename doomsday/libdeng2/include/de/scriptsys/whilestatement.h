@@ -38,9 +38,7 @@ public:
     WhileStatement() : _loopCondition(0) {}
     ~WhileStatement();
 
-    void setCondition(Expression *condition) {
-        _loopCondition = condition;
-    }
+    void setCondition(Expression *condition);
 
     Compound &compound() {
         return _compound;
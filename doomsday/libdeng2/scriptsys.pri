@@ -10,6 +10,7 @@ HEADERS += \
     include/de/DictionaryExpression \
     include/de/Evaluator \
     include/de/Expression \
+    include/de/ExpressionSequence \
     include/de/ExpressionStatement \
     include/de/FlowStatement \
     include/de/ForStatement \
@@ -48,6 +49,7 @@ HEADERS += \
     include/de/scriptsys/dictionaryexpression.h \
     include/de/scriptsys/evaluator.h \
     include/de/scriptsys/expression.h \
+    include/de/scriptsys/expressionsequence.h \
     include/de/scriptsys/expressionstatement.h \
     include/de/scriptsys/flowstatement.h \
     include/de/scriptsys/forstatement.h \
@@ -86,6 +88,7 @@ SOURCES += \
     src/scriptsys/dictionaryexpression.cpp \
     src/scriptsys/evaluator.cpp \
     src/scriptsys/expression.cpp \
+    src/scriptsys/expressionsequence.cpp \
     src/scriptsys/expressionstatement.cpp \
     src/scriptsys/flowstatement.cpp \
     src/scriptsys/forstatement.cpp \
@@ -42,10 +42,6 @@ void Task::run()
         LOG_AS("Task");
         LOG_WARNING("Aborted due to exception: ") << er.asText();
     }
-
-    // Cleanup.
-    pool().taskFinished(*this);
-    Log::disposeThreadLog();
 }
 
 } // namespace de
@@ -13,104 +13,405 @@
  * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
  * Public License for more details. You should have received a copy of the GNU
  * General Public License along with this program; if not, see:
- * http://www.gnu.org/licenses</small> 
+ * http://www.gnu.org/licenses</small>
  */
 
 #include "de/TaskPool"
 #include "de/Task"
 #include "de/Guard"
+#include "de/Log"
 
-#include <QThreadPool>
-#include <QSet>
+#include <QCoreApplication>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QThreadStorage>
+#include <QVector>
+#include <QWaitCondition>
 #include <de/Lockable>
-#include <de/Waitable>
 
 namespace de {
 
-DENG2_PIMPL(TaskPool), public Lockable, public Waitable
+DENG2_PIMPL(TaskPool)
 {
-    // Set of running tasks.
-    typedef QSet<Task *> Tasks;
-    Tasks tasks;
+    QMutex mutex;
+    QWaitCondition changed;
+    int count;      ///< Started tasks that have not finished.
+    int queued;     ///< Started tasks that have not begun running.
+    int notifying;  ///< Threads currently emitting allTasksDone().
 
-    Instance(Public *i) : Base(i)
+    Instance(Public *i) : Base(i), count(0), queued(0), notifying(0)
+    {}
+
+    void add(Task *t)
     {
-        // When empty, the semaphore is available.
-        post();
+        t->_pool = &self;
+
+        QMutexLocker lock(&mutex);
+        count++;
+        queued++;
+        changed.wakeAll();
     }
 
-    ~Instance()
+    void taskTaken()
     {
-        waitForEmpty();
+        QMutexLocker lock(&mutex);
+        queued--;
     }
 
-    void add(Task *t)
+    bool isDone()
     {
-        DENG2_GUARD(this);
-        t->_pool = &self;
-        if(tasks.isEmpty())
+        QMutexLocker lock(&mutex);
+        return !count && !notifying;
+    }
+};
+
+namespace internal {
+
+/// Number of priority levels (see TaskPool::Priority).
+static int const NUM_PRIORITIES = 3;
+
+/**
+ * Queues of tasks, one for each priority level.
+ */
+struct TaskQueues : public Lockable
+{
+    QList<Task *> tasks[NUM_PRIORITIES];
+};
+
+/**
+ * Work-stealing scheduler shared by all TaskPools.
+ */
+class TaskScheduler
+{
+public:
+    class Worker : public QThread
+    {
+    public:
+        Worker(TaskScheduler &owner, int index) : _owner(owner), _index(index) {}
+
+        void run()
         {
-            wait(); // Semaphore now unavailable.
+            _owner.workerMain(_index);
+            Log::disposeThreadLog();
         }
-        tasks.insert(t);
+
+    private:
+        TaskScheduler &_owner;
+        int _index;
+    };
+
+    /// Shared queue for tasks started outside the worker threads.
+    TaskQueues injected;
+
+    /// Per-worker deques.
+    QVector<TaskQueues *> local;
+
+    QList<Worker *> workers;
+
+    /// Idle workers sleep here.
+    QMutex sleepMutex;
+    QWaitCondition wakeup;
+    bool stopping;
+
+    /// Counters.
+    QAtomicInt queuedCount;
+    QAtomicInt runningCount;
+    struct Stats : public Lockable {
+        duint64 tasksRun;
+        duint64 tasksStolen;
+        Stats() : tasksRun(0), tasksStolen(0) {}
+    } stats;
+
+    /// Index of the worker in the current thread, plus one.
+    QThreadStorage<int> currentWorker;
+
+    TaskScheduler() : stopping(false)
+    {
+        // Threads waiting for their pools run tasks, too, so one core is
+        // left for them.
+        int const count = de::max(1, QThread::idealThreadCount() - 1);
+        for(int i = 0; i < count; ++i)
+        {
+            local.append(new TaskQueues);
+        }
+        for(int i = 0; i < count; ++i)
+        {
+            workers.append(new Worker(*this, i));
+            workers.last()->start();
+        }
+    }
+
+    ~TaskScheduler()
+    {
+        {
+            QMutexLocker lock(&sleepMutex);
+            stopping = true;
+            wakeup.wakeAll();
+        }
+        foreach(Worker *worker, workers)
+        {
+            worker->wait();
+        }
+        qDeleteAll(workers);
+        qDeleteAll(local);
+    }
+
+    static inline int atomicValue(QAtomicInt &value)
+    {
+        return value.fetchAndAddRelaxed(0);
+    }
+
+    /// Returns the index of the calling worker thread, or -1 if the caller is
+    /// not one of the workers.
+    int workerIndex()
+    {
+        return currentWorker.hasLocalData()? currentWorker.localData() - 1 : -1;
     }
 
-    void remove(Task *t)
+    void push(Task *task, int priority)
     {
-        DENG2_GUARD(this);
-        tasks.remove(t);
-        if(tasks.isEmpty())
+        int const self = workerIndex();
+        TaskQueues &queues = (self >= 0? *local[self] : injected);
+
+        // Counted before the task is visible so that workers cannot go to
+        // sleep while it is queued.
+        queuedCount.ref();
         {
-            post();
+            DENG2_GUARD(queues);
+            queues.tasks[priority].append(task);
         }
+
+        QMutexLocker lock(&sleepMutex);
+        wakeup.wakeOne();
     }
 
-    void waitForEmpty() const
+    static Task *takeFrom(QList<Task *> &list, bool newest, TaskPool const *onlyFrom)
     {
-        wait();
-        DENG2_GUARD(this);
-        DENG2_ASSERT(tasks.isEmpty());
-        post();
+        if(list.isEmpty()) return 0;
+        if(!onlyFrom)
+        {
+            return newest? list.takeLast() : list.takeFirst();
+        }
+        for(int i = 0; i < list.size(); ++i)
+        {
+            int const at = newest? list.size() - 1 - i : i;
+            if(&list[at]->pool() == onlyFrom)
+            {
+                return list.takeAt(at);
+            }
+        }
+        return 0;
     }
 
-    bool isEmpty() const
+    /**
+     * Find the next task to run.
+     *
+     * @param self      Index of the calling worker, or -1.
+     * @param onlyFrom  Only consider tasks of this pool (if not @c 0). Used
+     *                  by threads helping in waitForDone(); their tasks are
+     *                  not counted as stolen.
+     */
+    Task *take(int self, TaskPool const *onlyFrom = 0)
     {
-        DENG2_GUARD(this);
-        return tasks.isEmpty();
+        for(int prio = NUM_PRIORITIES - 1; prio >= 0; --prio)
+        {
+            // Our own deque first, newest task first.
+            if(self >= 0)
+            {
+                TaskQueues &own = *local[self];
+                DENG2_GUARD(own);
+                if(Task *task = takeFrom(own.tasks[prio], true, onlyFrom))
+                    return taken(task);
+            }
+
+            // Tasks started outside the workers.
+            {
+                DENG2_GUARD(injected);
+                if(Task *task = takeFrom(injected.tasks[prio], false, onlyFrom))
+                    return taken(task);
+            }
+
+            // Steal the oldest task from another worker.
+            for(int i = 1; i <= local.size(); ++i)
+            {
+                int const victim = (de::max(self, 0) + i) % local.size();
+                if(victim == self) continue;
+
+                TaskQueues &other = *local[victim];
+                DENG2_GUARD(other);
+                if(Task *task = takeFrom(other.tasks[prio], false, onlyFrom))
+                {
+                    if(!onlyFrom)
+                    {
+                        DENG2_GUARD(stats);
+                        stats.tasksStolen++;
+                    }
+                    return taken(task);
+                }
+            }
+        }
+        return 0;
+    }
+
+    inline Task *taken(Task *task)
+    {
+        queuedCount.deref();
+        task->pool().d->taskTaken();
+        return task;
+    }
+
+    void execute(Task *task)
+    {
+        TaskPool &pool = task->pool();
+
+        runningCount.ref();
+        bool const autoDelete = task->autoDelete();
+        task->run();
+        if(autoDelete) delete task;
+        runningCount.deref();
+
+        {
+            DENG2_GUARD(stats);
+            stats.tasksRun++;
+        }
+
+        // The pool may be deleted as soon as this returns.
+        pool.taskFinished();
+    }
+
+    void workerMain(int index)
+    {
+        currentWorker.setLocalData(index + 1);
+
+        forever
+        {
+            if(Task *task = take(index))
+            {
+                execute(task);
+                continue;
+            }
+
+            QMutexLocker lock(&sleepMutex);
+            if(stopping) break;
+            if(atomicValue(queuedCount) > 0) continue;
+            wakeup.wait(&sleepMutex);
+        }
+    }
+
+    TaskPool::Counters counters()
+    {
+        TaskPool::Counters c;
+        c.workerCount  = workers.size();
+        c.queuedTasks  = atomicValue(queuedCount);
+        c.runningTasks = atomicValue(runningCount);
+        DENG2_GUARD(stats);
+        c.tasksRun     = stats.tasksRun;
+        c.tasksStolen  = stats.tasksStolen;
+        return c;
     }
 };
 
+static TaskScheduler *theScheduler = 0;
+
+static void stopScheduler()
+{
+    delete theScheduler;
+    theScheduler = 0;
+}
+
+static TaskScheduler &scheduler()
+{
+    static QMutex creation;
+    QMutexLocker lock(&creation);
+    if(!theScheduler)
+    {
+        theScheduler = new TaskScheduler;
+
+        // Worker threads must be stopped before the application goes away.
+        qAddPostRoutine(stopScheduler);
+    }
+    return *theScheduler;
+}
+
+} // namespace internal
+
+using namespace internal;
 TaskPool::TaskPool() : d(new Instance(this))
 {}
 
 TaskPool::~TaskPool()
-{}
+{
+    waitForDone();
+}
 
 void TaskPool::start(Task *task, Priority priority)
 {
     d->add(task);
-    QThreadPool::globalInstance()->start(task, int(priority));
+    scheduler().push(task, int(priority));
 }
 
 void TaskPool::waitForDone()
 {
-    d->waitForEmpty();
+    if(d->isDone()) return;
+
+    TaskScheduler &sched = scheduler();
+    int const self = sched.workerIndex();
+
+    forever
+    {
+        {
+            QMutexLocker lock(&d->mutex);
+            while((d->count || d->notifying) && !d->queued)
+            {
+                // Everything has been started; wait for the tasks to finish.
+                d->changed.wait(&d->mutex);
+            }
+            if(!d->count && !d->notifying) return;
+        }
+
+        // Help out by running one of our own tasks.
+        if(Task *task = sched.take(self, this))
+        {
+            sched.execute(task);
+        }
+        else
+        {
+            // Another thread took it; wait.
+            QThread::yieldCurrentThread();
+        }
+    }
 }
 
 bool TaskPool::isDone() const
 {
-    return d->isEmpty();
+    return d->isDone();
 }
 
-void TaskPool::taskFinished(Task &task)
+int TaskPool::workerCount()
 {
-    d->remove(&task);
+    return scheduler().workers.size();
+}
 
-    if(d->isEmpty())
-    {
-        allTasksDone();
-    }
+TaskPool::Counters TaskPool::counters()
+{
+    return scheduler().counters();
 }
 
-} // namespace de
+void TaskPool::taskFinished()
+{
+    QMutexLocker lock(&d->mutex);
+    if(--d->count > 0) return;
+
+    // Waiters may not return before we are done with the pool.
+    d->notifying++;
+    lock.unlock();
+
+    allTasksDone();
 
+    lock.relock();
+    d->notifying--;
+    d->changed.wakeAll();
+}
+
+} // namespace de
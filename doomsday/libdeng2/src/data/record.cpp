@@ -31,8 +31,14 @@
 #include "de/TimeValue"
 #include "de/Vector"
 #include "de/String"
+#include "de/StringPool"
+#include "de/Lockable"
+#include "de/Guard"
 
 #include <QTextStream>
+#include <QHash>
+#include <QVector>
+#include <QAtomicInt>
 
 namespace de {
 
@@ -42,17 +48,75 @@ namespace de {
  */
 static duint32 recordIdCounter = 0;
 
+/**
+ * Source of membership stamps. Shared by all records so that a stamp is
+ * never valid for more than one record.
+ */
+static QAtomicInt membershipCounter;
+
+/**
+ * Interned member names of all records.
+ */
+struct MemberKeys : public Lockable
+{
+    StringPool names;          ///< User value of each name is its reference count.
+    QVector<Record::Key> keys; ///< Key of each interned name, by pool id.
+    Record::Key lastKey;
+
+    MemberKeys() : names(Qt::CaseSensitive), lastKey(0) {}
+};
+
+static MemberKeys &memberKeys()
+{
+    static MemberKeys keys;
+    return keys;
+}
+
 DENG2_PIMPL(Record)
 {
+    typedef QHash<Record::Key, Variable *> MembersByKey;
+
     Record::Members members;
+    MembersByKey membersByKey; ///< Keys looked up since the last membership change.
+    duint32 stamp;    ///< Changed whenever members are added or removed.
     duint32 uniqueId; ///< Identifier to track serialized references.
     duint32 oldUniqueId;
 
     typedef QMap<duint32, Record *> RefMap;
 
-    Instance(Public &r) : Base(r), uniqueId(++recordIdCounter), oldUniqueId(0)
+    Instance(Public &r)
+        : Base(r), stamp(nextStamp()), uniqueId(++recordIdCounter), oldUniqueId(0)
     {}
 
+    static duint32 nextStamp()
+    {
+        return duint32(membershipCounter.fetchAndAddRelaxed(1) + 1);
+    }
+
+    void membershipChanged()
+    {
+        if(!membersByKey.isEmpty()) membersByKey.clear();
+        stamp = nextStamp();
+    }
+
+    void insertMember(String const &name, Variable *var)
+    {
+        members[name] = var;
+        membershipChanged();
+    }
+
+    void removeMember(String const &name)
+    {
+        members.remove(name);
+        membershipChanged();
+    }
+
+    void clearMembers()
+    {
+        members.clear();
+        membershipChanged();
+    }
+
     bool isSubrecord(Variable const &var) const
     {
         RecordValue const *value = dynamic_cast<RecordValue const *>(&var.value());
@@ -197,7 +261,7 @@ void Record::clear()
             i.value()->audienceForDeletion -= this;
             delete i.value();
         }
-        d->members.clear();
+        d->clearMembers();
     }
 }
 
@@ -210,7 +274,7 @@ void Record::copyMembersFrom(Record const &other, CopyBehavior behavior)
 
         Variable *var = new Variable(*i.value());
         var->audienceForDeletion += this;
-        d->members[i.key()] = var;
+        d->insertMember(i.key(), var);
     }
 }
 
@@ -255,14 +319,14 @@ Variable &Record::add(Variable *variable)
         delete d->members[variable->name()];
     }
     var->audienceForDeletion += this;
-    d->members[variable->name()] = var.release();
+    d->insertMember(variable->name(), var.release());
     return *variable;
 }
 
 Variable *Record::remove(Variable &variable)
 {
     variable.audienceForDeletion -= this;
-    d->members.remove(variable.name());
+    d->removeMember(variable.name());
     return &variable;
 }
 
@@ -395,6 +459,25 @@ Record const &Record::subrecord(String const &name) const
     throw NotFoundError("Record::subrecord", "Subrecord '" + name + "' not found");
 }
 
+Variable *Record::findMember(Key memberKey, String const &name)
+{
+    Instance::MembersByKey::const_iterator found = d->membersByKey.constFind(memberKey);
+    if(found != d->membersByKey.constEnd())
+    {
+        return found.value();
+    }
+
+    // Absent members are indexed, too.
+    Variable *var = d->members.value(name);
+    d->membersByKey.insert(memberKey, var);
+    return var;
+}
+
+duint32 Record::membershipStamp() const
+{
+    return d->stamp;
+}
+
 Record::Members const &Record::members() const
 {
     return d->members;
@@ -530,7 +613,44 @@ void Record::variableBeingDeleted(Variable &variable)
     LOG_DEV_TRACE("Variable %p deleted, removing from Record %p", &variable << this);
 
     // Remove from our index.
-    d->members.remove(variable.name());
+    d->removeMember(variable.name());
+}
+
+Record::Key Record::key(String const &name)
+{
+    MemberKeys &mk = memberKeys();
+    DENG2_GUARD(mk);
+
+    StringPool::Id const id = mk.names.intern(name);
+    uint const refs = mk.names.userValue(id);
+    if(!refs)
+    {
+        // A new key is given even if the id is reused, so that the key of a
+        // released name cannot match another name in a record's index.
+        if(mk.keys.size() <= int(id)) mk.keys.resize(id + 1);
+        mk.keys[id] = ++mk.lastKey;
+    }
+    mk.names.setUserValue(id, refs + 1);
+    return mk.keys[id];
+}
+
+void Record::releaseKey(String const &name)
+{
+    MemberKeys &mk = memberKeys();
+    DENG2_GUARD(mk);
+
+    StringPool::Id const id = mk.names.isInterned(name);
+    if(!id) return;
+
+    uint const refs = mk.names.userValue(id);
+    if(refs > 1)
+    {
+        mk.names.setUserValue(id, refs - 1);
+    }
+    else
+    {
+        mk.names.removeById(id);
+    }
 }
 
 QTextStream &operator << (QTextStream &os, Record const &record)
@@ -78,6 +78,9 @@ public:
     bool operator == (CaselessString const &other) const {
         return !_str.compare(other, Qt::CaseInsensitive);
     }
+    int compare(CaselessString const &other, Qt::CaseSensitivity sensitivity) const {
+        return _str.compare(other, sensitivity);
+    }
     InternalId id() const {
         return _id;
     }
@@ -145,7 +148,21 @@ private:
     CaselessString const *_str;
 };
 
-typedef std::set<CaselessStringRef> Interns;
+/**
+ * Orders the interned strings, either case-sensitively or case-insensitively.
+ */
+class InternCompare {
+public:
+    InternCompare(Qt::CaseSensitivity sensitivity = Qt::CaseInsensitive)
+        : _sensitivity(sensitivity) {}
+    bool operator () (CaselessStringRef const &a, CaselessStringRef const &b) const {
+        return a.toStr()->compare(*b.toStr(), _sensitivity) < 0;
+    }
+private:
+    Qt::CaseSensitivity _sensitivity;
+};
+
+typedef std::set<CaselessStringRef, InternCompare> Interns;
 typedef std::vector<CaselessString *> IdMap;
 typedef std::list<InternalId> AvailableIds;
 
@@ -163,7 +180,8 @@ DENG2_PIMPL_NOREF(StringPool)
     /// List of currently unused ids in idMap.
     AvailableIds available;
 
-    Instance() : count(0)
+    Instance(Qt::CaseSensitivity sensitivity)
+        : interns(InternCompare(sensitivity)), count(0)
     {}
 
     ~Instance()
@@ -278,11 +296,11 @@ DENG2_PIMPL_NOREF(StringPool)
     }
 };
 
-StringPool::StringPool() : d(new Instance)
+StringPool::StringPool(Qt::CaseSensitivity sensitivity) : d(new Instance(sensitivity))
 {
 }
 
-StringPool::StringPool(String const *strings, uint count) : d(new Instance)
+StringPool::StringPool(String const *strings, uint count) : d(new Instance(Qt::CaseInsensitive))
 {
     for(uint i = 0; strings && i < count; ++i)
     {
@@ -178,6 +178,70 @@ struct MessageHeader : public ISerializable
     }
 };
 
+/**
+ * Compresses @a packet and prefixes it with a message header.
+ */
+static Block encodeMessage(IByteArray const &packet)
+{
+    Block payload(packet);
+    Block huffData;
+    MessageHeader header;
+
+    // Let's find the appropriate compression method of the payload. First see
+    // if the encoded contents are under 128 bytes as Huffman codes.
+    if(payload.size() <= MAX_HUFFMAN_INPUT_SIZE) // Potentially short enough.
+    {
+        huffData = codec::huffmanEncode(payload);
+        if(int(huffData.size()) <= MAX_SIZE_SMALL)
+        {
+            // We'll use this.
+            header.isHuffmanCoded = true;
+            header.size = huffData.size();
+            payload = huffData;
+        }
+        // Even if that didn't seem suitable, we'll keep it to compare against
+        // the deflated payload.
+    }
+
+    if(!header.size) // Try deflate.
+    {
+        int const level = (payload.size() < 2*MAX_SIZE_MEDIUM? 6 /*default*/ : 9 /*best*/);
+        QByteArray deflated = qCompress(payload, level);
+
+        if(!deflated.size())
+        {
+            throw Socket::ProtocolError("Socket::send:", "Failed to deflate message payload");
+        }
+        if(deflated.size() > MAX_SIZE_LARGE)
+        {
+            throw Socket::ProtocolError("Socket::send",
+                                        QString("Compressed payload is too large (%1 bytes)").arg(deflated.size()));
+        }
+
+        // Choose the smallest compression.
+        if(huffData.size() && int(huffData.size()) <= deflated.size() && int(huffData.size()) <= MAX_SIZE_MEDIUM)
+        {
+            // Huffman yielded smaller payload.
+            header.isHuffmanCoded = true;
+            header.size = huffData.size();
+            payload = huffData;
+        }
+        else
+        {
+            // Use the deflated payload.
+            header.isDeflated = true;
+            header.size = deflated.size();
+            payload = deflated;
+        }
+    }
+
+    // The message header is followed by the payload.
+    Block dest;
+    Writer(dest) << header;
+    dest += payload;
+    return dest;
+}
+
 } // namespace internal
 
 using namespace internal;
@@ -225,75 +289,13 @@ DENG2_PIMPL_NOREF(Socket)
         foreach(Message *msg, receivedMessages) delete msg;
     }
 
-    void serializeAndSendMessage(IByteArray const &packet)
+    void sendEncodedMessage(Block const &bytes)
     {
-        Block payload(packet);
-        Block huffData;
-        MessageHeader header;
-
-        // Let's find the appropriate compression method of the payload. First see
-        // if the encoded contents are under 128 bytes as Huffman codes.
-        if(payload.size() <= MAX_HUFFMAN_INPUT_SIZE) // Potentially short enough.
-        {
-            huffData = codec::huffmanEncode(payload);
-            if(int(huffData.size()) <= MAX_SIZE_SMALL)
-            {
-                // We'll use this.
-                header.isHuffmanCoded = true;
-                header.size = huffData.size();
-                payload = huffData;
-            }
-            // Even if that didn't seem suitable, we'll keep it to compare against
-            // the deflated payload.
-        }
-
-        /// @todo Messages broadcasted to multiple recipients are separately
-        /// compressed for each TCP send -- should do only one compression per
-        /// message.
-
-        if(!header.size) // Try deflate.
-        {
-            int const level = (payload.size() < 2*MAX_SIZE_MEDIUM? 6 /*default*/ : 9 /*best*/);
-            QByteArray deflated = qCompress(payload, level);
-
-            if(!deflated.size())
-            {
-                throw ProtocolError("Socket::send:", "Failed to deflate message payload");
-            }
-            if(deflated.size() > MAX_SIZE_LARGE)
-            {
-                throw ProtocolError("Socket::send",
-                                    QString("Compressed payload is too large (%1 bytes)").arg(deflated.size()));
-            }
-
-            // Choose the smallest compression.
-            if(huffData.size() && int(huffData.size()) <= deflated.size() && int(huffData.size()) <= MAX_SIZE_MEDIUM)
-            {
-                // Huffman yielded smaller payload.
-                header.isHuffmanCoded = true;
-                header.size = huffData.size();
-                payload = huffData;
-            }
-            else
-            {
-                // Use the deflated payload.
-                header.isDeflated = true;
-                header.size = deflated.size();
-                payload = deflated;
-            }
-        }
-
-        // Write the message header.
-        Block dest;
-        Writer(dest) << header;
-        socket->write(dest);
-
         // Update totals (for statistics).
-        dsize total = dest.size() + payload.size();
-        bytesToBeWritten += total;
-        totalBytesWritten += total;
+        bytesToBeWritten += bytes.size();
+        totalBytesWritten += bytes.size();
 
-        socket->write(payload);
+        socket->write(bytes);
     }
 
     /**
@@ -541,7 +543,18 @@ void Socket::send(IByteArray const &packet, duint /*channel*/)
         throw DisconnectedError("Socket::send", "Socket is unavailable");
     }
 
-    d->serializeAndSendMessage(packet);
+    d->sendEncodedMessage(encodeMessage(packet));
+}
+
+void Socket::send(EncodedMessage const &message)
+{
+    if(!d->socket)
+    {
+        /// @throw DisconnectedError Sending is not possible because the socket has been closed.
+        throw DisconnectedError("Socket::send", "Socket is unavailable");
+    }
+
+    d->sendEncodedMessage(message.bytes());
 }
 
 void Socket::readIncomingBytes()
@@ -657,4 +670,26 @@ void Socket::bytesWereWritten(qint64 bytes)
     DENG2_ASSERT(d->bytesToBeWritten >= 0);
 }
 
+EncodedMessage::EncodedMessage()
+{}
+
+EncodedMessage::EncodedMessage(IByteArray const &packet)
+    : _bytes(encodeMessage(packet))
+{}
+
+bool EncodedMessage::isEmpty() const
+{
+    return _bytes.isEmpty();
+}
+
+dsize EncodedMessage::size() const
+{
+    return _bytes.size();
+}
+
+Block const &EncodedMessage::bytes() const
+{
+    return _bytes;
+}
+
 } // namespace de
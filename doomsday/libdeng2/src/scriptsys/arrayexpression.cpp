@@ -21,6 +21,7 @@
 #include "de/Evaluator"
 #include "de/Expression"
 #include "de/ArrayValue"
+#include "de/ExpressionSequence"
 #include "de/Writer"
 #include "de/Reader"
 
@@ -59,6 +60,15 @@ void ArrayExpression::push(Evaluator &evaluator, Record *names) const
     }
 }
 
+void ArrayExpression::flatten(ExpressionSequence &seq, int scope) const
+{
+    DENG2_FOR_EACH_CONST(Arguments, i, _arguments)
+    {
+        (*i)->flatten(seq);
+    }
+    seq.addEvaluate(this, scope);
+}
+
 Expression const &ArrayExpression::at(dint pos) const
 {
     return *_arguments.at(pos);
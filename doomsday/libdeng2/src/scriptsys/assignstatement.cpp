@@ -41,6 +41,7 @@ AssignStatement::AssignStatement(Expression *target, Indices const &indices, Exp
         _args.add(*i);
     }
     _args.add(target);
+    _args.prepare();
 }
 
 AssignStatement::~AssignStatement()
@@ -123,4 +124,5 @@ void AssignStatement::operator << (Reader &from)
     _indexCount = count;
     
     from >> _args;
+    _args.prepare();
 }
@@ -26,6 +26,7 @@
 #include "de/RefValue"
 #include "de/RecordValue"
 #include "de/BlockValue"
+#include "de/ExpressionSequence"
 #include "de/TimeValue"
 #include "de/Writer"
 #include "de/Reader"
@@ -53,6 +54,12 @@ void BuiltInExpression::push(Evaluator &evaluator, Record *) const
     _arg->push(evaluator);
 }
 
+void BuiltInExpression::flatten(ExpressionSequence &seq, int) const
+{
+    _arg->flatten(seq);
+    seq.addEvaluate(this);
+}
+
 Value *BuiltInExpression::evaluate(Evaluator &evaluator) const
 {
     std::auto_ptr<Value> value(evaluator.popResult());
@@ -30,7 +30,9 @@ DeleteStatement::DeleteStatement() : _targets(new ArrayExpression)
 {}
 
 DeleteStatement::DeleteStatement(ArrayExpression *targets) : _targets(targets)
-{}
+{
+    _targets->prepare();
+}
 
 DeleteStatement::~DeleteStatement()
 {
@@ -74,4 +76,5 @@ void DeleteStatement::operator << (Reader &from)
         throw DeserializationError("DeleteStatement::operator <<", "Invalid ID");
     }
     from >> *_targets;
+    _targets->prepare();
 }
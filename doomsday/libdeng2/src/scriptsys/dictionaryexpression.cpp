@@ -20,6 +20,7 @@
 #include "de/DictionaryExpression"
 #include "de/DictionaryValue"
 #include "de/Evaluator"
+#include "de/ExpressionSequence"
 #include "de/Writer"
 #include "de/Reader"
 
@@ -66,6 +67,16 @@ void DictionaryExpression::push(Evaluator &evaluator, Record *names) const
     }    
 }
 
+void DictionaryExpression::flatten(ExpressionSequence &seq, int scope) const
+{
+    DENG2_FOR_EACH_CONST(Arguments, i, _arguments)
+    {
+        i->first->flatten(seq);
+        i->second->flatten(seq);
+    }
+    seq.addEvaluate(this, scope);
+}
+
 Value *DictionaryExpression::evaluate(Evaluator &evaluator) const
 {
     std::auto_ptr<DictionaryValue> dict(new DictionaryValue);
@@ -19,6 +19,8 @@
 
 #include "de/Evaluator"
 #include "de/Expression"
+#include "de/OperatorExpression"
+#include "de/ExpressionSequence"
 #include "de/Value"
 #include "de/Context"
 #include "de/Process"
@@ -59,19 +61,42 @@ Value &Evaluator::evaluate(Expression const *expression)
         
     // Begin a new evaluation operation.
     _current = expression;
-    expression->push(*this);
+    ExpressionSequence const *seq = expression->sequence();
+    if(!seq)
+    {
+        // Walk the expression tree.
+        expression->push(*this);
+    }
 
     // Clear the result stack.
     clearResults();
 
-    while(!_stack.empty())
+    if(seq)
     {
-        // Continue by processing the next step in the evaluation.
-        ScopedExpression top = _stack.back();
-        _stack.pop_back();
-        clearNames();
-        _names = top.names;
-        pushResult(top.expression->evaluate(*this));
+        _scopes.resize(seq->scopeCount());
+
+        DENG2_FOR_EACH_CONST(ExpressionSequence::Steps, i, seq->steps())
+        {
+            if(i->type == ExpressionSequence::Evaluate)
+            {
+                clearNames();
+                _names = (i->scope >= 0? _scopes[i->scope] : 0);
+                pushResult(i->expression->evaluate(*this));
+            }
+            else
+            {
+                DENG2_ASSERT(i->type == ExpressionSequence::Scope);
+                std::auto_ptr<Value> scope(popResult());
+                _scopes[i->scope] = OperatorExpression::memberScope(*scope);
+            }
+
+            // Expressions may still push further steps of their own.
+            evaluateStack();
+        }
+    }
+    else
+    {
+        evaluateStack();
     }
 
     // During function call evaluation the process's context changes. We should
@@ -87,6 +112,19 @@ Value &Evaluator::evaluate(Expression const *expression)
     return result();
 }
 
+void Evaluator::evaluateStack()
+{
+    while(!_stack.empty())
+    {
+        // Continue by processing the next step in the evaluation.
+        ScopedExpression top = _stack.back();
+        _stack.pop_back();
+        clearNames();
+        _names = top.names;
+        pushResult(top.expression->evaluate(*this));
+    }
+}
+
 void Evaluator::namespaces(Namespaces &spaces) const
 {
     if(_names)
@@ -25,19 +25,45 @@
 #include "de/DictionaryExpression"
 #include "de/NameExpression"
 #include "de/OperatorExpression"
+#include "de/ExpressionSequence"
 #include "de/Writer"
 #include "de/Reader"
 
 using namespace de;
 
-Expression::~Expression()
+Expression::Expression() : _sequence(0)
 {}
 
+Expression::~Expression()
+{
+    delete _sequence;
+}
+
 void Expression::push(Evaluator &evaluator, Record *names) const
 {
     evaluator.push(this, names);
 }
 
+void Expression::flatten(ExpressionSequence &seq, int scope) const
+{
+    seq.addEvaluate(this, scope);
+}
+
+void Expression::prepare()
+{
+    if(!_sequence)
+    {
+        _sequence = new ExpressionSequence;
+    }
+    _sequence->clear();
+    flatten(*_sequence);
+}
+
+ExpressionSequence const *Expression::sequence() const
+{
+    return _sequence;
+}
+
 Expression *Expression::constructFrom(Reader &reader)
 {
     SerialId id;
@@ -101,6 +127,10 @@ void Expression::operator >> (Writer &to) const
 
 void Expression::operator << (Reader &from)
 {
+    // The subexpressions are about to be replaced.
+    delete _sequence;
+    _sequence = 0;
+
     // Restore the flags.
     duint16 f;
     from >> f;
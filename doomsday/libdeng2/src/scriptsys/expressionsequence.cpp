@@ -0,0 +1,44 @@
+/** @file expressionsequence.cpp  Evaluation order of an expression tree.
+ *
+ * @authors Copyright (c) 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * @par License
+ * GPL: http://www.gnu.org/licenses/gpl.html
+ *
+ * <small>This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version. This program is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details. You should have received a copy of the GNU
+ * General Public License along with this program; if not, see:
+ * http://www.gnu.org/licenses</small>
+ */
+
+#include "de/ExpressionSequence"
+
+namespace de {
+
+ExpressionSequence::ExpressionSequence() : _scopeCount(0)
+{}
+
+void ExpressionSequence::clear()
+{
+    _steps.clear();
+    _scopeCount = 0;
+}
+
+void ExpressionSequence::addEvaluate(Expression const *expression, int scope)
+{
+    _steps.push_back(Step(Evaluate, expression, scope));
+}
+
+int ExpressionSequence::addScope(Expression const *expression)
+{
+    int const slot = _scopeCount++;
+    _steps.push_back(Step(Scope, expression, slot));
+    return slot;
+}
+
+} // namespace de
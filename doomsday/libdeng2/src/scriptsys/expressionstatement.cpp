@@ -28,6 +28,11 @@
 
 using namespace de;
 
+ExpressionStatement::ExpressionStatement(Expression *expression) : _expression(expression)
+{
+    if(_expression) _expression->prepare();
+}
+
 ExpressionStatement::~ExpressionStatement()
 {
     delete _expression;
@@ -59,4 +64,5 @@ void ExpressionStatement::operator << (Reader &from)
     delete _expression;
     _expression = 0;
     _expression = Expression::constructFrom(from);
+    _expression->prepare();
 }
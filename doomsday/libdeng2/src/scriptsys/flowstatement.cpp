@@ -36,7 +36,9 @@ FlowStatement::FlowStatement() : _type(PASS), _arg(0)
  
 FlowStatement::FlowStatement(Type type, Expression *countArgument) 
     : _type(type), _arg(countArgument) 
-{}
+{
+    if(_arg) _arg->prepare();
+}
  
 FlowStatement::~FlowStatement()
 {
@@ -126,5 +128,6 @@ void FlowStatement::operator << (Reader &from)
         delete _arg;
         _arg = 0;
         _arg = Expression::constructFrom(from);
+        _arg->prepare();
     }
 }
@@ -33,6 +33,13 @@ using namespace de;
 ForStatement::ForStatement() : _iterator(0), _iteration(0)
 {}
 
+ForStatement::ForStatement(Expression *iter, Expression *iteration)
+    : _iterator(iter), _iteration(iteration)
+{
+    _iterator->prepare();
+    _iteration->prepare();
+}
+
 ForStatement::~ForStatement()
 {
     delete _iterator;
@@ -89,6 +96,8 @@ void ForStatement::operator << (Reader &from)
     
     _iterator = Expression::constructFrom(from);
     _iteration = Expression::constructFrom(from);
+    _iterator->prepare();
+    _iteration->prepare();
     
     from >> _compound;
 }
@@ -37,6 +37,8 @@ FunctionStatement::FunctionStatement(Expression *identifier)
     : _identifier(identifier)
 {
     _function = new Function();
+    if(_identifier) _identifier->prepare();
+    _defaults.prepare();
 }
 
 FunctionStatement::~FunctionStatement()
@@ -56,6 +58,7 @@ void FunctionStatement::addArgument(String const &argName, Expression *defaultVa
     if(defaultValue)
     {
         _defaults.add(new ConstantExpression(new TextValue(argName)), defaultValue);
+        _defaults.prepare();
     }
 }
 
@@ -101,6 +104,8 @@ void FunctionStatement::operator << (Reader &from)
     delete _identifier;
     _identifier = 0;
     _identifier = Expression::constructFrom(from);
+    _identifier->prepare();
 
     from >> *_function >> _defaults;
+    _defaults.prepare();
 }
@@ -49,6 +49,7 @@ void IfStatement::newBranch()
 void IfStatement::setBranchCondition(Expression *condition)
 {
     _branches.back().condition = condition;
+    condition->prepare();
 }
 
 Compound &IfStatement::branchCompound()
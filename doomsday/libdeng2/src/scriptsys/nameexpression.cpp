@@ -30,17 +30,30 @@
 
 using namespace de;
 
-NameExpression::NameExpression()
+NameExpression::NameExpression() : _key(0)
 {}
 
 NameExpression::NameExpression(String const &identifier, Flags const &flags) 
-    : _identifier(identifier)
 {
+    setIdentifier(identifier);
     setFlags(flags);
 }
 
 NameExpression::~NameExpression()
-{}
+{
+    if(_key) Record::releaseKey(_identifier);
+}
+
+void NameExpression::setIdentifier(String const &identifier)
+{
+    if(_key) Record::releaseKey(_identifier);
+
+    _identifier = identifier;
+    _cache = LookupCache();
+
+    // Paths into subrecords are looked up by name.
+    _key = (identifier.contains('.')? 0 : Record::key(identifier));
+}
 
 Value *NameExpression::evaluate(Evaluator &evaluator) const
 {
@@ -55,27 +68,84 @@ Value *NameExpression::evaluate(Evaluator &evaluator) const
     Record *foundInNamespace = 0;
     Record *higherNamespace = 0;
     Variable *variable = 0;
-    
-    DENG2_FOR_EACH(Evaluator::Namespaces, i, spaces)
+
+    // The same expression may be evaluated in several threads at once. Only
+    // one of them gets to use the cache; the others just do the search.
+    bool const useCache = _cacheBusy.testAndSetAcquire(0, 1);
+
+    // Can we reuse the result of the previous search?
+    if(useCache && _cache.count)
     {
-        Record &ns = **i;
-        if(ns.hasMember(_identifier))
+        int pos = 0;
+        DENG2_FOR_EACH(Evaluator::Namespaces, i, spaces)
         {
-            // The name exists in this namespace.
-            variable = &ns[_identifier];
-            foundInNamespace = &ns;
-
-            // Also note the higher namespace (for export).
-            Evaluator::Namespaces::iterator next = i;
-            if(++next != spaces.end()) higherNamespace = *next;
-            break;
+            if(*i != _cache.spaces[pos] ||
+               (*i)->membershipStamp() != _cache.stamps[pos]) break;
+
+            if(++pos == _cache.count)
+            {
+                variable = _cache.variable;
+                foundInNamespace = *i;
+
+                Evaluator::Namespaces::iterator next = i;
+                if(++next != spaces.end()) higherNamespace = *next;
+                break;
+            }
         }
-        if(flags().testFlag(LocalOnly))
+    }
+
+    if(!variable)
+    {
+        if(useCache) _cache.count = 0;
+
+        int pos = 0;
+        DENG2_FOR_EACH(Evaluator::Namespaces, i, spaces)
         {
-            break;
+            Record &ns = **i;
+
+            if(useCache && pos < LookupCache::MAX_SPACES)
+            {
+                _cache.spaces[pos] = &ns;
+                _cache.stamps[pos] = ns.membershipStamp();
+            }
+            ++pos;
+
+            if(_key)
+            {
+                variable = ns.findMember(_key, _identifier);
+            }
+            else if(ns.hasMember(_identifier))
+            {
+                variable = &ns[_identifier];
+            }
+
+            if(variable)
+            {
+                // The name exists in this namespace.
+                foundInNamespace = &ns;
+
+                // Remember where it was found. Members of subrecords are
+                // not covered by the namespace's membership stamp.
+                if(useCache && _key && pos <= LookupCache::MAX_SPACES)
+                {
+                    _cache.count = pos;
+                    _cache.variable = variable;
+                }
+
+                // Also note the higher namespace (for export).
+                Evaluator::Namespaces::iterator next = i;
+                if(++next != spaces.end()) higherNamespace = *next;
+                break;
+            }
+            if(flags().testFlag(LocalOnly))
+            {
+                break;
+            }
         }
     }
 
+    if(useCache) _cacheBusy.fetchAndStoreRelease(0);
+
     if(flags().testFlag(ThrowawayIfInScope) && variable)
     {
         foundInNamespace = 0;
@@ -200,5 +270,7 @@ void NameExpression::operator << (Reader &from)
 
     Expression::operator << (from);
 
-    from >> _identifier;
+    String identifier;
+    from >> identifier;
+    setIdentifier(identifier);
 }
@@ -26,6 +26,7 @@
 #include "de/RefValue"
 #include "de/RecordValue"
 #include "de/NoneValue"
+#include "de/ExpressionSequence"
 #include "de/Writer"
 #include "de/Reader"
 #include "de/math.h"
@@ -82,6 +83,37 @@ void OperatorExpression::push(Evaluator &evaluator, Record *names) const
     }
 }
 
+void OperatorExpression::flatten(ExpressionSequence &seq, int scope) const
+{
+    if(_op == MEMBER)
+    {
+        // The right side is evaluated in the scope defined by the left side.
+        _leftOperand->flatten(seq, scope);
+        _rightOperand->flatten(seq, seq.addScope(this));
+    }
+    else
+    {
+        if(_leftOperand)
+        {
+            _leftOperand->flatten(seq, scope);
+        }
+        _rightOperand->flatten(seq);
+        seq.addEvaluate(this);
+    }
+}
+
+Record *OperatorExpression::memberScope(Value const &leftValue)
+{
+    RecordValue const *recValue = dynamic_cast<RecordValue const *>(&leftValue);
+    if(!recValue)
+    {
+        throw ScopeError("OperatorExpression::memberScope",
+            "Left side of " + operatorToText(MEMBER) + " must evaluate to a record [" +
+                         DENG2_TYPE_NAME(leftValue) + "]");
+    }
+    return recValue->record();
+}
+
 Value *OperatorExpression::newBooleanValue(bool isTrue)
 {
     return new NumberValue(isTrue? NumberValue::True : NumberValue::False,
@@ -242,17 +274,9 @@ Value *OperatorExpression::evaluate(Evaluator &evaluator) const
 
         case MEMBER: 
         {
-            RecordValue const *recValue = dynamic_cast<RecordValue const *>(leftValue);
-            if(!recValue)
-            {
-                throw ScopeError("OperatorExpression::evaluate",
-                    "Left side of " + operatorToText(_op) + " must evaluate to a record [" +
-                                 DENG2_TYPE_NAME(*leftValue) + "]");
-            }
-            
             // Now that we know what the scope is, push the rest of the expression
             // for evaluation (in this specific scope).
-            _rightOperand->push(evaluator, recValue->record());
+            _rightOperand->push(evaluator, memberScope(*leftValue));
             
             // Cleanup.
             delete leftValue;
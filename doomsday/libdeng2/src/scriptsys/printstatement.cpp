@@ -35,6 +35,7 @@ PrintStatement::PrintStatement(ArrayExpression *arguments) : _arg(arguments)
     {
         _arg = new ArrayExpression();
     }
+    _arg->prepare();
 }
 
 PrintStatement::~PrintStatement()
@@ -84,4 +85,5 @@ void PrintStatement::operator << (Reader &from)
         throw DeserializationError("PrintStatement::operator <<", "Invalid ID");
     }
     from >> *_arg;
+    _arg->prepare();
 }
@@ -32,6 +32,12 @@ WhileStatement::~WhileStatement()
     delete _loopCondition;
 }
 
+void WhileStatement::setCondition(Expression *condition)
+{
+    _loopCondition = condition;
+    _loopCondition->prepare();
+}
+
 void WhileStatement::execute(Context &context) const
 {
     Evaluator &eval = context.evaluator();
@@ -64,7 +70,7 @@ void WhileStatement::operator << (Reader &from)
     }
     delete _loopCondition;
     _loopCondition = 0;
-    _loopCondition = Expression::constructFrom(from);
+    setCondition(Expression::constructFrom(from));
     
     from >> _compound;
 }
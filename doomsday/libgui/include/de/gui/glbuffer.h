@@ -46,7 +46,9 @@ namespace internal
             Color,
             Normal,
             Tangent,
-            Bitangent
+            Bitangent,
+            TargetPosition, ///< Morph target of Position.
+            TargetNormal    ///< Morph target of Normal.
         };
 
         Semantic semantic;
@@ -166,6 +168,12 @@ public:
 
     void draw(duint first = 0, dint count = -1);
 
+    /**
+     * Returns the name of the GL vertex buffer object (zero if the buffer has
+     * not been allocated).
+     */
+    GLuint glName() const;
+
 protected:
     void setFormat(internal::AttribSpecs const &format);
 
@@ -90,7 +90,9 @@ extern PFNGLUNIFORM1FPROC                glUniform1f;
 extern PFNGLUNIFORM1IPROC                glUniform1i;
 extern PFNGLUNIFORM2FPROC                glUniform2f;
 extern PFNGLUNIFORM3FPROC                glUniform3f;
+extern PFNGLUNIFORM3FVPROC               glUniform3fv;
 extern PFNGLUNIFORM4FPROC                glUniform4f;
+extern PFNGLUNIFORM4FVPROC               glUniform4fv;
 extern PFNGLUNIFORMMATRIX3FVPROC         glUniformMatrix3fv;
 extern PFNGLUNIFORMMATRIX4FVPROC         glUniformMatrix4fv;
 extern PFNGLUSEPROGRAMPROC               glUseProgram;
@@ -267,6 +267,11 @@ void GLBuffer::draw(duint first, dint count)
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+GLuint GLBuffer::glName() const
+{
+    return d->name;
+}
+
 void GLBuffer::setFormat(AttribSpecs const &format)
 {
     d->specs = format;
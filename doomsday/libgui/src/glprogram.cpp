@@ -148,7 +148,9 @@ DENG2_OBSERVES(GLUniform, Deletion)
             { AttribSpec::Color,     "aColor"     },
             { AttribSpec::Normal,    "aNormal"    },
             { AttribSpec::Tangent,   "aTangent"   },
-            { AttribSpec::Bitangent, "aBitangent" }
+            { AttribSpec::Bitangent, "aBitangent" },
+            { AttribSpec::TargetPosition, "aTargetVertex" },
+            { AttribSpec::TargetNormal,   "aTargetNormal" }
         };
 
         for(uint i = 0; i < sizeof(names)/sizeof(names[0]); ++i)
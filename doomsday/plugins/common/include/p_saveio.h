@@ -65,14 +65,55 @@ const char* SV_ClientSavePath(void);
 
 /*
  * File management
+ *
+ * Files opened for writing are serialized into memory. When closed, the data is
+ * compressed and written to disk by a background thread, which also performs
+ * removals and copies queued after the write. The write is done to a temporary
+ * file that then replaces the original one.
+ *
+ * Save files are split into separately compressed chunks, with an index that
+ * allows reading e.g. only the session header. Files in the older LZSS format
+ * can still be read.
+ */
+
+/**
+ * Open a save file for reading or writing.
+ *
+ * @return  @c true if successful (when writing, the file can be created).
  */
-LZFILE* SV_OpenFile(Str const *filePath, char const *mode);
+boolean SV_OpenFile(Str const *filePath, char const *mode);
 void SV_CloseFile(void);
-LZFILE* SV_File(void);
+
 boolean SV_ExistingFile(Str const *filePath);
+
+/**
+ * Remove a save file. If writes to the file are still queued, the removal is
+ * queued after them.
+ *
+ * @return  Zero if the file was removed or the removal was queued.
+ */
 int SV_RemoveFile(Str const *filePath);
 void SV_CopyFile(Str const *srcPath, Str const *destPath);
 
+/**
+ * Read the uncompressed contents of a save file into a buffer allocated with
+ * Z_Malloc().
+ *
+ * @param filePath    Path of the file to read.
+ * @param buffer      The buffer is returned here.
+ * @param headerOnly  Only the session header is needed. The rest of the file
+ *                    is not read, if the file format allows it.
+ *
+ * @return  Size of the buffer in bytes; @c 0 on failure.
+ */
+size_t SV_ReadFile(Str const *filePath, byte **buffer, boolean headerOnly);
+
+/**
+ * Wait until all the queued file writes have been completed. Must be called
+ * before reading save files other than through SV_OpenFile() or SV_ReadFile().
+ */
+void SV_FinishWrites(void);
+
 #if __JHEXEN__
 saveptr_t* SV_HxSavePtr(void);
 #endif // __JHEXEN__
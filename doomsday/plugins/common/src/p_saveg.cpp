@@ -699,7 +699,7 @@ static bool recogniseNativeState(Str const *path, SaveInfo *info)
 #if __JHEXEN__
     /// @todo Do not buffer the whole file.
     byte *saveBuffer;
-    if(!M_ReadFile(Str_Text(path), (char**)&saveBuffer))
+    if(!SV_ReadFile(path, &saveBuffer, true /*header only*/))
         return false;
     // Set the save pointer.
     SV_HxSavePtr()->b = saveBuffer;
@@ -5097,7 +5097,7 @@ static bool openGameSaveFile(Str const *fileName, bool write)
 #if __JHEXEN__
     if(!write)
     {
-        bool result = M_ReadFile(Str_Text(fileName), (char **)&saveBuffer) > 0;
+        bool result = SV_ReadFile(fileName, &saveBuffer, false) > 0;
         // Set the save pointer.
         SV_HxSavePtr()->b = saveBuffer;
         return result;
@@ -5105,10 +5105,8 @@ static bool openGameSaveFile(Str const *fileName, bool write)
     else
 #endif
     {
-        SV_OpenFile(fileName, write? "wp" : "rp");
+        return SV_OpenFile(fileName, write? "wp" : "rp");
     }
-
-    return SV_File() != 0;
 }
 
 static int SV_LoadState(Str const *path, SaveInfo *saveInfo)
@@ -5531,7 +5529,7 @@ static void readMapState()
 #endif
 
     // Load the file
-    size_t bufferSize = M_ReadFile(Str_Text(path), (char**)&saveBuffer);
+    size_t bufferSize = SV_ReadFile(path, &saveBuffer, false);
     if(0 == bufferSize)
     {
         Con_Message("Warning: readMapState: Failed opening \"%s\" for reading.", Str_Text(path));
@@ -26,6 +26,10 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <de/concurrency.h>
+#include <de/memory.h>
+#include <zlib.h>
+
 #include "common.h"
 #include "dmu_lib.h"
 #include "p_mapsetup.h"
@@ -35,8 +39,106 @@
 #include "saveinfo.h"
 #include "api_materialarchive.h"
 
+/**
+ * Save files are written in a chunked format: the uncompressed data is split
+ * into chunks at segment boundaries (see SV_BeginSegment()) and at every
+ * CHUNK_SIZE bytes, and each chunk is compressed separately. An index of the
+ * chunks follows the file header, so parts of the file can be read without
+ * decompressing everything before them. All values are little-endian.
+ *
+ * <pre>
+ * uint32   CONTAINER_MAGIC
+ * uint32   CONTAINER_VERSION
+ * uint32   Number of chunks
+ * uint32   Total uncompressed size
+ * For each chunk:
+ *   int32  Segment identifier (HEADER_SEGMENT for the session header)
+ *   uint32 Compression method (CHUNK_STORED or CHUNK_DEFLATE)
+ *   uint32 Uncompressed size
+ *   uint32 Compressed size
+ * Compressed chunk data, in index order.
+ * </pre>
+ *
+ * Files in the older single-stream LZSS format can still be read.
+ */
+#define CONTAINER_MAGIC         0x43475344 // "DSGC"
+#define CONTAINER_VERSION       1
+#define CONTAINER_HEADER_SIZE   16
+#define CHUNK_INDEX_ENTRY_SIZE  16
+#define CHUNK_SIZE              0x10000
+#define HEADER_SEGMENT          0 ///< Data written before the first segment.
+#define WRITER_TIMEOUT          60000 ///< Milliseconds to wait for queued writes.
+
+enum {
+    CHUNK_STORED,
+    CHUNK_DEFLATE
+};
+
+/// Start of a segment in the uncompressed data.
+typedef struct {
+    int id;
+    size_t offset;
+} savesegment_t;
+
+typedef struct {
+    int segmentId;
+    uint method;
+    size_t size;
+    size_t packedSize;
+    size_t offset;  ///< Position in the uncompressed data.
+    long filePos;   ///< Position of the compressed data in the file.
+} savechunk_t;
+
+/// Reads a chunked save file on demand.
+typedef struct {
+    FILE *file;
+    savechunk_t *chunks;
+    int chunkCount;
+    size_t totalSize;
+    int current;    ///< Chunk in @var data, or -1.
+    byte *data;
+    size_t pos;     ///< Read position in the uncompressed data.
+} chunkreader_t;
+
+/**
+ * A file operation waiting for the background writer. Save states are first
+ * serialized into memory on the game thread; compressing and writing them to
+ * disk happens later in the writer thread, in the order the operations were
+ * queued.
+ */
+typedef struct pendingop_s {
+    struct pendingop_s *next;
+    ddstring_t path;
+    ddstring_t tempPath; ///< Data is written here and then renamed to @var path.
+    byte *data;          ///< @c NULL if the file at @var path is to be removed.
+    size_t size;
+    savesegment_t *segments;
+    int segmentCount;
+    char const *failure; ///< Set by the writer if the operation failed.
+} pendingop_t;
+
+/// Uncompressed contents of a save file being written.
+typedef struct {
+    byte *data;
+    size_t size;
+    size_t maxSize;
+    savesegment_t *segments;
+    int segmentCount;
+    int maxSegments;
+} savebuffer_t;
+
 static boolean inited;
 static LZFILE* savefile;
+static chunkreader_t *reader; ///< Chunked save file open for reading (if any).
+static pendingop_t *writeOp; ///< Save file currently open for writing (if any).
+static savebuffer_t writeBuffer;
+
+static mutex_t writeQueueMutex;
+static pendingop_t *writeQueueFirst, *writeQueueLast;
+static pendingop_t *failedOps; ///< Failed operations to be reported.
+static thread_t writerThread;
+static boolean writerBusy; ///< Writer thread is running (guarded by writeQueueMutex).
+static uint tempFileCounter;
 static ddstring_t savePath; // e.g., "savegame/"
 #if !__JHEXEN__
 static ddstring_t clientSavePath; // e.g., "savegame/client/"
@@ -80,12 +182,530 @@ static AutoStr* composeSaveDir(void)
     exit(1); // Unreachable.
 }
 
+static pendingop_t *newPendingOp(Str const *path)
+{
+    pendingop_t *op = (pendingop_t *) M_Calloc(sizeof(*op));
+    Str_Set(Str_InitStd(&op->path), Str_Text(path));
+    Str_InitStd(&op->tempPath);
+    return op;
+}
+
+static void deletePendingOp(pendingop_t *op)
+{
+    if(!op) return;
+    Str_Free(&op->path);
+    Str_Free(&op->tempPath);
+    M_Free(op->data);
+    M_Free(op->segments);
+    M_Free(op);
+}
+
+static void writeUInt32(FILE *file, uint32_t val)
+{
+    byte bytes[4];
+    bytes[0] = (byte) val;
+    bytes[1] = (byte) (val >> 8);
+    bytes[2] = (byte) (val >> 16);
+    bytes[3] = (byte) (val >> 24);
+    fwrite(bytes, 4, 1, file);
+}
+
+static uint32_t readUInt32(byte const *bytes)
+{
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+/**
+ * Split the data of @a op into chunks and compress them.
+ *
+ * @param packed  The compressed data of each chunk is returned here. Each
+ *                must be freed with M_Free().
+ *
+ * @return  Number of chunks.
+ */
+static int packChunks(pendingop_t const *op, savechunk_t **chunks, byte ***packed)
+{
+    int count = 0, maxCount = 0, i;
+
+    *chunks = 0;
+    *packed = 0;
+
+    for(i = 0; i < op->segmentCount; ++i)
+    {
+        size_t const end = (i + 1 < op->segmentCount? op->segments[i + 1].offset : op->size);
+        size_t offset;
+
+        for(offset = op->segments[i].offset; offset < end; offset += CHUNK_SIZE)
+        {
+            savechunk_t *chunk;
+            uLongf packedSize;
+            byte *out;
+
+            if(count == maxCount)
+            {
+                maxCount = MAX_OF(2 * maxCount, 16);
+                *chunks = (savechunk_t *) M_Realloc(*chunks, sizeof(**chunks) * maxCount);
+                *packed = (byte **) M_Realloc(*packed, sizeof(**packed) * maxCount);
+            }
+
+            chunk = &(*chunks)[count];
+            chunk->segmentId = op->segments[i].id;
+            chunk->offset    = offset;
+            chunk->size      = MIN_OF(end - offset, CHUNK_SIZE);
+
+            // Favor speed; the data compresses well regardless.
+            packedSize = compressBound(chunk->size);
+            out = (byte *) M_Malloc(packedSize);
+            if(compress2(out, &packedSize, op->data + offset, chunk->size, Z_BEST_SPEED) == Z_OK &&
+               packedSize < chunk->size)
+            {
+                chunk->method = CHUNK_DEFLATE;
+                chunk->packedSize = packedSize;
+            }
+            else
+            {
+                chunk->method = CHUNK_STORED;
+                chunk->packedSize = chunk->size;
+                memcpy(out, op->data + offset, chunk->size);
+            }
+            (*packed)[count++] = out;
+        }
+    }
+    return count;
+}
+
+static boolean writeChunkedFile(char const *path, pendingop_t const *op)
+{
+    savechunk_t *chunks;
+    byte **packed;
+    int const count = packChunks(op, &chunks, &packed);
+    boolean success = false;
+    FILE *file;
+    int i;
+
+    if((file = fopen(path, "wb")))
+    {
+        writeUInt32(file, CONTAINER_MAGIC);
+        writeUInt32(file, CONTAINER_VERSION);
+        writeUInt32(file, count);
+        writeUInt32(file, op->size);
+        for(i = 0; i < count; ++i)
+        {
+            writeUInt32(file, chunks[i].segmentId);
+            writeUInt32(file, chunks[i].method);
+            writeUInt32(file, chunks[i].size);
+            writeUInt32(file, chunks[i].packedSize);
+        }
+        for(i = 0; i < count; ++i)
+        {
+            fwrite(packed[i], 1, chunks[i].packedSize, file);
+        }
+        success = !ferror(file);
+        if(fclose(file)) success = false;
+    }
+
+    for(i = 0; i < count; ++i)
+    {
+        M_Free(packed[i]);
+    }
+    M_Free(packed);
+    M_Free(chunks);
+    return success;
+}
+
+static void closeChunkedFile(chunkreader_t *r)
+{
+    if(!r) return;
+    fclose(r->file);
+    M_Free(r->chunks);
+    M_Free(r->data);
+    M_Free(r);
+}
+
+/**
+ * Open a save file in the chunked format and read its index.
+ *
+ * @return  @c NULL if the file could not be opened, or is not a chunked file.
+ */
+static chunkreader_t *openChunkedFile(char const *path)
+{
+    byte header[CONTAINER_HEADER_SIZE];
+    byte entry[CHUNK_INDEX_ENTRY_SIZE];
+    chunkreader_t *r;
+    FILE *file;
+    size_t offset = 0;
+    long filePos;
+    int i;
+
+    if(!(file = fopen(path, "rb"))) return 0;
+
+    if(fread(header, CONTAINER_HEADER_SIZE, 1, file) != 1 ||
+       readUInt32(header) != CONTAINER_MAGIC)
+    {
+        // Perhaps an LZSS file.
+        fclose(file);
+        return 0;
+    }
+    if(readUInt32(header + 4) != CONTAINER_VERSION)
+    {
+        Con_Message("Warning: Save file \"%s\" has an unknown format version %u.",
+                    path, readUInt32(header + 4));
+        fclose(file);
+        return 0;
+    }
+
+    // Every chunk contains at least one byte.
+    if(readUInt32(header + 8) > readUInt32(header + 12))
+    {
+        Con_Message("Warning: Save file \"%s\" is corrupt.", path);
+        fclose(file);
+        return 0;
+    }
+
+    r = (chunkreader_t *) M_Calloc(sizeof(*r));
+    r->file       = file;
+    r->chunkCount = readUInt32(header + 8);
+    r->totalSize  = readUInt32(header + 12);
+    r->current    = -1;
+    r->chunks     = (savechunk_t *) M_Malloc(sizeof(*r->chunks) * MAX_OF(r->chunkCount, 1));
+
+    filePos = CONTAINER_HEADER_SIZE + CHUNK_INDEX_ENTRY_SIZE * r->chunkCount;
+    for(i = 0; i < r->chunkCount; ++i)
+    {
+        savechunk_t *chunk = &r->chunks[i];
+
+        if(fread(entry, CHUNK_INDEX_ENTRY_SIZE, 1, file) != 1)
+        {
+            Con_Message("Warning: Save file \"%s\" is truncated.", path);
+            closeChunkedFile(r);
+            return 0;
+        }
+        chunk->segmentId  = (int32_t) readUInt32(entry);
+        chunk->method     = readUInt32(entry + 4);
+        chunk->size       = readUInt32(entry + 8);
+        chunk->packedSize = readUInt32(entry + 12);
+        chunk->offset     = offset;
+        chunk->filePos    = filePos;
+
+        offset  += chunk->size;
+        filePos += chunk->packedSize;
+    }
+    if(offset != r->totalSize)
+    {
+        Con_Message("Warning: Save file \"%s\" is corrupt.", path);
+        closeChunkedFile(r);
+        return 0;
+    }
+    return r;
+}
+
+/**
+ * Decompress chunk @a index into the reader's buffer.
+ */
+static boolean loadChunk(chunkreader_t *r, int index)
+{
+    savechunk_t const *chunk = &r->chunks[index];
+    boolean success = false;
+    byte *packed;
+
+    if(chunk->size > CHUNK_SIZE || chunk->packedSize > compressBound(CHUNK_SIZE))
+        return false;
+
+    // Stored chunks are read directly into the (CHUNK_SIZE) buffer.
+    if(chunk->method == CHUNK_STORED)
+    {
+        if(chunk->packedSize != chunk->size) return false;
+    }
+    else if(chunk->method != CHUNK_DEFLATE)
+    {
+        return false; // Unknown compression method.
+    }
+
+    if(!r->data) r->data = (byte *) M_Malloc(CHUNK_SIZE);
+    r->current = -1;
+
+    packed = (chunk->method == CHUNK_STORED? r->data : (byte *) M_Malloc(MAX_OF(chunk->packedSize, 1)));
+    if(!fseek(r->file, chunk->filePos, SEEK_SET) &&
+       fread(packed, 1, chunk->packedSize, r->file) == chunk->packedSize)
+    {
+        if(chunk->method == CHUNK_STORED)
+        {
+            success = true;
+        }
+        else
+        {
+            uLongf size = chunk->size;
+            success = (uncompress(r->data, &size, packed, chunk->packedSize) == Z_OK &&
+                       size == chunk->size);
+        }
+    }
+    if(packed != r->data) M_Free(packed);
+
+    if(success) r->current = index;
+    return success;
+}
+
+/// @return  Index of the chunk containing @a offset in the uncompressed data, or -1.
+static int findChunk(chunkreader_t const *r, size_t offset)
+{
+    int low = 0, high = r->chunkCount - 1;
+    while(low <= high)
+    {
+        int const mid = (low + high) / 2;
+        savechunk_t const *chunk = &r->chunks[mid];
+        if(offset < chunk->offset)
+            high = mid - 1;
+        else if(offset >= chunk->offset + chunk->size)
+            low = mid + 1;
+        else
+            return mid;
+    }
+    return -1;
+}
+
+/**
+ * Read @a len bytes from the current position. Reading stops at the end of
+ * the data or at a chunk that cannot be decompressed.
+ *
+ * @return  Number of bytes actually read.
+ */
+static size_t readChunked(chunkreader_t *r, void *data, size_t len)
+{
+    byte *out = (byte *) data;
+    size_t done = 0;
+
+    while(done < len)
+    {
+        savechunk_t const *chunk = (r->current >= 0? &r->chunks[r->current] : 0);
+        size_t avail;
+
+        if(!chunk || r->pos < chunk->offset || r->pos >= chunk->offset + chunk->size)
+        {
+            int const index = findChunk(r, r->pos);
+            if(index < 0 || !loadChunk(r, index)) break;
+            chunk = &r->chunks[index];
+        }
+
+        avail = MIN_OF(chunk->offset + chunk->size - r->pos, len - done);
+        memcpy(out + done, r->data + (r->pos - chunk->offset), avail);
+        done   += avail;
+        r->pos += avail;
+    }
+    return done;
+}
+
+/**
+ * Perform a queued operation. Called in the writer thread, so failures are
+ * only recorded in @a op; they are reported later by the main thread.
+ */
+static void performPendingOp(pendingop_t *op)
+{
+    if(!op->data)
+    {
+        remove(Str_Text(&op->path));
+        return;
+    }
+
+    if(!writeChunkedFile(Str_Text(&op->tempPath), op))
+    {
+        op->failure = "Failed writing";
+        remove(Str_Text(&op->tempPath));
+        return;
+    }
+
+    // Replace the old file only once the new one is complete, so that an
+    // interrupted write never leaves behind a truncated save.
+    if(rename(Str_Text(&op->tempPath), Str_Text(&op->path)))
+    {
+        // Some platforms refuse to rename over an existing file.
+        remove(Str_Text(&op->path));
+        if(rename(Str_Text(&op->tempPath), Str_Text(&op->path)))
+        {
+            op->failure = "Failed replacing";
+            remove(Str_Text(&op->tempPath));
+        }
+    }
+}
+
+static int writerThreadWorker(void *parm)
+{
+    DENG_UNUSED(parm);
+
+    for(;;)
+    {
+        pendingop_t *op;
+
+        // The operation stays in the queue until it has been performed, so that
+        // SV_ExistingFile() sees it.
+        Sys_Lock(writeQueueMutex);
+        op = writeQueueFirst;
+        if(!op)
+        {
+            writerBusy = false;
+            Sys_Unlock(writeQueueMutex);
+            return 0;
+        }
+        Sys_Unlock(writeQueueMutex);
+
+        performPendingOp(op);
+
+        Sys_Lock(writeQueueMutex);
+        writeQueueFirst = op->next;
+        if(!writeQueueFirst) writeQueueLast = 0;
+        if(op->failure)
+        {
+            M_Free(op->data);
+            op->data = 0;
+            op->next = failedOps;
+            failedOps = op;
+            op = 0;
+        }
+        Sys_Unlock(writeQueueMutex);
+
+        deletePendingOp(op);
+    }
+}
+
+/**
+ * Print warnings about the operations the writer thread failed to perform.
+ * Called in the main thread.
+ */
+static void reportFailedOps(void)
+{
+    pendingop_t *failed, *next;
+
+    Sys_Lock(writeQueueMutex);
+    failed = failedOps;
+    failedOps = 0;
+    Sys_Unlock(writeQueueMutex);
+
+    for(; failed; failed = next)
+    {
+        next = failed->next;
+        Con_Message("Warning: %s \"%s\".", failed->failure, Str_Text(&failed->path));
+        deletePendingOp(failed);
+    }
+}
+
+/**
+ * Append @a op to the write queue and make sure the writer thread is running.
+ * Ownership of @a op is given to the queue.
+ */
+static void queuePendingOp(pendingop_t *op)
+{
+    boolean startWriter = false;
+
+    Sys_Lock(writeQueueMutex);
+    if(writeQueueLast)
+        writeQueueLast->next = op;
+    else
+        writeQueueFirst = op;
+    writeQueueLast = op;
+    if(!writerBusy)
+    {
+        writerBusy = startWriter = true;
+    }
+    Sys_Unlock(writeQueueMutex);
+
+    reportFailedOps();
+
+    if(startWriter)
+    {
+        // The previous writer has already exited.
+        if(writerThread) Sys_WaitThread(writerThread, 1000, NULL);
+        writerThread = Sys_StartThread(writerThreadWorker, NULL);
+    }
+}
+
+/**
+ * Find the last queued operation for @a path.
+ * @pre writeQueueMutex is locked.
+ */
+static pendingop_t *findPendingOp(Str const *path)
+{
+    pendingop_t *found = 0, *op;
+    for(op = writeQueueFirst; op; op = op->next)
+    {
+        if(!Str_Compare(&op->path, Str_Text(path)))
+            found = op;
+    }
+    return found;
+}
+
+void SV_FinishWrites(void)
+{
+    if(writerThread)
+    {
+        // Nothing more gets queued meanwhile, so the writer exits as soon as
+        // the queue is empty.
+        Sys_WaitThread(writerThread, WRITER_TIMEOUT, NULL);
+        writerThread = 0;
+    }
+    reportFailedOps();
+}
+
+static void writeToBuffer(void const *data, size_t len)
+{
+    if(!writeOp) return;
+
+    if(writeBuffer.size + len > writeBuffer.maxSize)
+    {
+        writeBuffer.maxSize = MAX_OF(writeBuffer.size + len, 2 * writeBuffer.maxSize);
+        writeBuffer.maxSize = MAX_OF(writeBuffer.maxSize, 0x10000);
+        writeBuffer.data = (byte *) M_Realloc(writeBuffer.data, writeBuffer.maxSize);
+    }
+    memcpy(writeBuffer.data + writeBuffer.size, data, len);
+    writeBuffer.size += len;
+}
+
+/**
+ * Mark the start of a new segment at the current position of the save file
+ * being written.
+ */
+static void addSegment(int segmentId)
+{
+    savesegment_t *last;
+
+    if(!writeOp) return;
+
+    last = (writeBuffer.segmentCount? &writeBuffer.segments[writeBuffer.segmentCount - 1] : 0);
+    if(last && last->offset == writeBuffer.size)
+    {
+        // The previous segment is empty.
+        last->id = segmentId;
+        return;
+    }
+
+    if(writeBuffer.segmentCount == writeBuffer.maxSegments)
+    {
+        writeBuffer.maxSegments = MAX_OF(2 * writeBuffer.maxSegments, 16);
+        writeBuffer.segments = (savesegment_t *) M_Realloc(writeBuffer.segments,
+            sizeof(*writeBuffer.segments) * writeBuffer.maxSegments);
+    }
+    last = &writeBuffer.segments[writeBuffer.segmentCount++];
+    last->id     = segmentId;
+    last->offset = writeBuffer.size;
+}
+
+/// Values are stored in little-endian byte order.
+static void writeLittleEndian(uint32_t val, int numBytes)
+{
+    byte bytes[4];
+    int i;
+    for(i = 0; i < numBytes; ++i)
+    {
+        bytes[i] = (byte) (val >> (8 * i));
+    }
+    writeToBuffer(bytes, numBytes);
+}
+
 void SV_InitIO(void)
 {
     Str_Init(&savePath);
 #if !__JHEXEN__
     Str_Init(&clientSavePath);
 #endif
+    writeQueueMutex = Sys_CreateMutex("SaveWriteQueue");
     inited = true;
     savefile = 0;
 }
@@ -95,6 +715,13 @@ void SV_ShutdownIO(void)
     if(!inited) return;
 
     SV_CloseFile();
+    SV_FinishWrites();
+
+    Sys_DestroyMutex(writeQueueMutex);
+    writeQueueMutex = 0;
+    M_Free(writeBuffer.data);
+    M_Free(writeBuffer.segments);
+    memset(&writeBuffer, 0, sizeof(writeBuffer));
 
     Str_Free(&savePath);
 #if !__JHEXEN__
@@ -142,20 +769,61 @@ void SV_ConfigureSavePaths(void)
     }
 }
 
-LZFILE *SV_File(void)
+boolean SV_OpenFile(Str const *filePath, char const *mode)
 {
-    return savefile;
-}
+    DENG_ASSERT(savefile == 0 && reader == 0 && writeOp == 0);
 
-LZFILE *SV_OpenFile(Str const *filePath, char const *mode)
-{
-    DENG_ASSERT(savefile == 0);
+    if(strchr(mode, 'w'))
+    {
+        FILE *probe;
+        pendingop_t *op = newPendingOp(filePath);
+        Str_Appendf(&op->tempPath, "%s.%u.tmp", Str_Text(filePath), tempFileCounter++);
+
+        // Fail now rather than in the writer if the file cannot be created.
+        if(!(probe = fopen(Str_Text(&op->tempPath), "wb")))
+        {
+            deletePendingOp(op);
+            return false;
+        }
+        fclose(probe);
+
+        writeOp = op;
+        writeBuffer.size = 0;
+        writeBuffer.segmentCount = 0;
+        addSegment(HEADER_SEGMENT);
+        return true;
+    }
+
+    SV_FinishWrites();
+    if((reader = openChunkedFile(Str_Text(filePath))) != 0)
+        return true;
+
+    // Perhaps the older format?
     savefile = lzOpen(Str_Text(filePath), (char *)mode);
-    return savefile;
+    return savefile != 0;
 }
 
 void SV_CloseFile(void)
 {
+    if(writeOp)
+    {
+        // Hand the snapshot over to the writer. The next file written gets
+        // a new buffer.
+        if(!writeBuffer.data)
+            writeBuffer.data = (byte *) M_Malloc(1);
+        writeOp->data         = writeBuffer.data;
+        writeOp->size         = writeBuffer.size;
+        writeOp->segments     = writeBuffer.segments;
+        writeOp->segmentCount = writeBuffer.segmentCount;
+        memset(&writeBuffer, 0, sizeof(writeBuffer));
+        queuePendingOp(writeOp);
+        writeOp = 0;
+    }
+    if(reader)
+    {
+        closeChunkedFile(reader);
+        reader = 0;
+    }
     if(savefile)
     {
         lzClose(savefile);
@@ -166,6 +834,21 @@ void SV_CloseFile(void)
 boolean SV_ExistingFile(Str const *filePath)
 {
     FILE *fp;
+
+    if(writerThread)
+    {
+        pendingop_t *op;
+        boolean pending, exists = false;
+
+        Sys_Lock(writeQueueMutex);
+        op = findPendingOp(filePath);
+        if((pending = (op != 0)))
+            exists = (op->data != 0);
+        Sys_Unlock(writeQueueMutex);
+
+        if(pending) return exists;
+    }
+
     if((fp = fopen(Str_Text(filePath), "rb")))
     {
         fclose(fp);
@@ -177,33 +860,123 @@ boolean SV_ExistingFile(Str const *filePath)
 int SV_RemoveFile(Str const *filePath)
 {
     if(!filePath) return 1;
+
+    if(writerThread)
+    {
+        boolean pending;
+
+        Sys_Lock(writeQueueMutex);
+        pending = (findPendingOp(filePath) != 0);
+        Sys_Unlock(writeQueueMutex);
+
+        if(pending)
+        {
+            // Must not be removed before the queued writes to it are done.
+            queuePendingOp(newPendingOp(filePath));
+            return 0;
+        }
+    }
     return remove(Str_Text(filePath));
 }
 
 void SV_CopyFile(Str const *srcPath, Str const *destPath)
 {
+    char buffer[0x4000];
     size_t length;
-    char *buffer;
-    LZFILE *outf;
+    FILE *inf, *outf;
 
     if(!srcPath || !destPath) return;
 
-    if(!SV_ExistingFile(srcPath)) return;
+    if(writerThread)
+    {
+        pendingop_t *op, *copy = 0;
+        boolean pending;
+
+        // Copy a queued snapshot without waiting for it to be written.
+        Sys_Lock(writeQueueMutex);
+        op = findPendingOp(srcPath);
+        if((pending = (op != 0)) && op->data)
+        {
+            copy = newPendingOp(destPath);
+            Str_Appendf(&copy->tempPath, "%s.%u.tmp", Str_Text(destPath), tempFileCounter++);
+            copy->data = (byte *) M_Malloc(MAX_OF(op->size, 1));
+            if(op->size)
+                memcpy(copy->data, op->data, op->size);
+            copy->size = op->size;
+            copy->segments = (savesegment_t *) M_Malloc(sizeof(*copy->segments) * op->segmentCount);
+            memcpy(copy->segments, op->segments, sizeof(*copy->segments) * op->segmentCount);
+            copy->segmentCount = op->segmentCount;
+        }
+        Sys_Unlock(writeQueueMutex);
+
+        if(pending)
+        {
+            if(copy) queuePendingOp(copy);
+            return;
+        }
+
+        SV_FinishWrites();
+    }
 
-    length = M_ReadFile(Str_Text(srcPath), &buffer);
-    if(length == 0)
+    // The file is copied as-is, whichever format it is in.
+    if(!(inf = fopen(Str_Text(srcPath), "rb"))) return;
+    if(!(outf = fopen(Str_Text(destPath), "wb")))
     {
-        Con_Message("Warning: SV_CopyFile: Failed opening \"%s\" for reading.", Str_Text(srcPath));
+        Con_Message("Warning: SV_CopyFile: Failed opening \"%s\" for writing.", Str_Text(destPath));
+        fclose(inf);
         return;
     }
+    while((length = fread(buffer, 1, sizeof(buffer), inf)) > 0)
+    {
+        fwrite(buffer, 1, length, outf);
+    }
+    fclose(outf);
+    fclose(inf);
+}
+
+size_t SV_ReadFile(Str const *filePath, byte **buffer, boolean headerOnly)
+{
+    chunkreader_t *r;
+    size_t size = 0;
+
+    DENG_ASSERT(filePath != 0 && buffer != 0);
+
+    SV_FinishWrites();
+
+    *buffer = 0;
+    if(!(r = openChunkedFile(Str_Text(filePath))))
+    {
+        // Perhaps the older format?
+        return M_ReadFile(Str_Text(filePath), (char **)buffer);
+    }
+
+    if(headerOnly)
+    {
+        int i;
+        for(i = 0; i < r->chunkCount && r->chunks[i].segmentId == HEADER_SEGMENT; ++i)
+        {
+            size += r->chunks[i].size;
+        }
+    }
+    else
+    {
+        size = r->totalSize;
+    }
 
-    outf = lzOpen((char*)Str_Text(destPath), "wp");
-    if(outf)
+    if(size)
     {
-        lzWrite(buffer, length, outf);
-        lzClose(outf);
+        *buffer = (byte *) Z_Malloc(size, PU_GAMESTATIC, 0);
+        if(readChunked(r, *buffer, size) < size)
+        {
+            Con_Message("Warning: SV_ReadFile: Failed reading \"%s\".", Str_Text(filePath));
+            Z_Free(*buffer);
+            *buffer = 0;
+            size = 0;
+        }
     }
-    Z_Free(buffer);
+
+    closeChunkedFile(r);
+    return size;
 }
 
 #ifdef __JHEXEN__
@@ -241,6 +1014,7 @@ void SV_AssertMapSegment(savestatesegment_t *retSegmentId)
 void SV_BeginSegment(int segType)
 {
     errorIfNotInited("SV_BeginSegment");
+    addSegment(segType);
 #if __JHEXEN__
     SV_WriteLong(segType);
 #endif
@@ -274,20 +1048,23 @@ void SV_Seek(uint offset)
 #if __JHEXEN__
     saveptr.b += offset;
 #else
-    lzSeek(savefile, offset);
+    if(reader)
+        reader->pos += offset;
+    else
+        lzSeek(savefile, offset);
 #endif
 }
 
 void SV_Write(const void* data, int len)
 {
     errorIfNotInited("SV_Write");
-    lzWrite((void*)data, len, savefile);
+    writeToBuffer(data, len);
 }
 
 void SV_WriteByte(byte val)
 {
     errorIfNotInited("SV_WriteByte");
-    lzPutC(val, savefile);
+    writeToBuffer(&val, 1);
 }
 
 #if __JHEXEN__
@@ -297,7 +1074,7 @@ void SV_WriteShort(short val)
 #endif
 {
     errorIfNotInited("SV_WriteShort");
-    lzPutW(val, savefile);
+    writeLittleEndian((uint16_t) val, 2);
 }
 
 #if __JHEXEN__
@@ -307,7 +1084,7 @@ void SV_WriteLong(long val)
 #endif
 {
     errorIfNotInited("SV_WriteLong");
-    lzPutL(val, savefile);
+    writeLittleEndian((uint32_t) val, 4);
 }
 
 void SV_WriteFloat(float val)
@@ -316,9 +1093,37 @@ void SV_WriteFloat(float val)
     assert(sizeof(val) == 4);
     errorIfNotInited("SV_WriteFloat");
     memcpy(&temp, &val, 4);
-    lzPutL(temp, savefile);
+    writeLittleEndian((uint32_t) temp, 4);
 }
 
+#if !__JHEXEN__
+/**
+ * Read from the open chunked save file. A save that cannot be read completely
+ * is corrupt.
+ */
+static void readFromReader(void *data, size_t len)
+{
+    if(readChunked(reader, data, len) < len)
+    {
+        Con_Error("Corrupt save game: Failed reading %lu bytes at offset %lu.",
+                  (unsigned long) len, (unsigned long) reader->pos);
+    }
+}
+
+static uint32_t readLittleEndian(int numBytes)
+{
+    byte bytes[4];
+    uint32_t val = 0;
+    int i;
+    readFromReader(bytes, numBytes);
+    for(i = 0; i < numBytes; ++i)
+    {
+        val |= (uint32_t) bytes[i] << (8 * i);
+    }
+    return val;
+}
+#endif
+
 void SV_Read(void *data, int len)
 {
     errorIfNotInited("SV_Read");
@@ -326,7 +1131,10 @@ void SV_Read(void *data, int len)
     memcpy(data, saveptr.b, len);
     saveptr.b += len;
 #else
-    lzRead(data, len, savefile);
+    if(reader)
+        readFromReader(data, len);
+    else
+        lzRead(data, len, savefile);
 #endif
 }
 
@@ -336,6 +1144,7 @@ byte SV_ReadByte(void)
 #if __JHEXEN__
     return (*saveptr.b++);
 #else
+    if(reader) return (byte) readLittleEndian(1);
     return lzGetC(savefile);
 #endif
 }
@@ -346,6 +1155,7 @@ short SV_ReadShort(void)
 #if __JHEXEN__
     return (SHORT(*saveptr.w++));
 #else
+    if(reader) return (short) readLittleEndian(2);
     return lzGetW(savefile);
 #endif
 }
@@ -356,6 +1166,7 @@ long SV_ReadLong(void)
 #if __JHEXEN__
     return (LONG(*saveptr.l++));
 #else
+    if(reader) return (int32_t) readLittleEndian(4);
     return lzGetL(savefile);
 #endif
 }
@@ -370,7 +1181,7 @@ float SV_ReadFloat(void)
 #if __JHEXEN__
     return (FLOAT(*saveptr.f++));
 #else
-    val = lzGetL(savefile);
+    val = (reader? (int32_t) readLittleEndian(4) : lzGetL(savefile));
     returnValue = 0;
     assert(sizeof(float) == 4);
     memcpy(&returnValue, &val, 4);
@@ -76,6 +76,12 @@ public:
     // Implements Transmitter.
     void send(de::IByteArray const &data);
 
+    /**
+     * Sends a message that has already been encoded (e.g., the same message
+     * is being broadcast to all users).
+     */
+    void send(de::EncodedMessage const &message);
+
 signals:
     void userDestroyed();
 
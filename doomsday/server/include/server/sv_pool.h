@@ -78,6 +78,20 @@ typedef struct delta_s {
     // the client.
     float           score;
 
+    // The score without the age factor, and the owner info generation it
+    // was calculated for (zero if it needs to be recalculated).
+    float           baseScore;
+    uint            ratedGeneration;
+
+    // Position in the pool's priority queue plus one. Zero if the delta is
+    // not in the queue.
+    int             queuePos;
+
+    // Links in the pool's rating list, and the system time when the score
+    // was last calculated.
+    struct delta_s* rateNext, *ratePrev;
+    uint            ratedTime;
+
     // Deltas can be either New or Unacked. New deltas haven't yet been sent.
     deltastate_t    state;
 
@@ -219,8 +233,18 @@ typedef struct ownerinfo_s {
     angle_t         angle; // Angle can change rapidly => not very important
     float           speed;
     uint            ackThreshold; // Expected ack time in milliseconds
+    uint            generation; // Incremented when the origin changes
 } ownerinfo_t;
 
+/**
+ * Counts of the work done on a pool, for monitoring.
+ */
+typedef struct poolcounters_s {
+    uint            rated; // Deltas whose base score was calculated
+    uint            merged; // New deltas merged with existing ones
+    uint            sent; // Deltas included in frames
+} poolcounters_t;
+
 /**
  * Each client has a delta pool.
  */
@@ -247,12 +271,21 @@ typedef struct pool_s {
     // not be sent.
     mislink_t       misHash[POOL_MISSILE_HASH_SIZE];
 
-    // The priority queue (a heap). Built when the pool contents are rated.
-    // Contains pointers to deltas in the hash. Becomes invalid when deltas
-    // are removed from the hash!
+    // The priority queue (a heap). Kept across frames; only the deltas that
+    // are rated are moved in it. Contains pointers to deltas in the hash.
+    // Deltas removed from the hash are also removed from the queue.
     int             queueSize;
     int             allocatedSize;
     delta_t**       queue;
+
+    // All deltas in the hash, ordered by the time they were last rated.
+    // Changed deltas are placed at the head so they get rated first.
+    delta_t*        rateFirst, *rateLast;
+
+    // Work done since the previous frame was sent, and during the
+    // period that ended with it.
+    poolcounters_t  counters;
+    poolcounters_t  lastCounters;
 } pool_t;
 
 void            Sv_InitPools(void);
@@ -266,7 +299,18 @@ boolean         Sv_IsFrameTarget(uint clientNumber);
 uint            Sv_GetTimeStamp(void);
 pool_t*         Sv_GetPool(uint clientNumber);
 void            Sv_RatePool(pool_t* pool);
+void            Sv_PoolDeltaChanged(pool_t* pool, delta_t* delta);
+
+/**
+ * Rates several pools concurrently (see Sv_RatePool()).
+ *
+ * @param pools  Pools to rate.
+ * @param count  Number of pools in the array.
+ */
+void            Sv_RatePools(pool_t** pools, int count);
+
 delta_t*        Sv_PoolQueueExtract(pool_t* pool);
+void            Sv_PoolQueueInsert(pool_t* pool, delta_t* delta);
 void            Sv_AckDeltaSet(uint clientNumber, int set, byte resent);
 uint            Sv_CountUnackedDeltas(uint clientNumber);
 
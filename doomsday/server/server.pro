@@ -201,6 +201,7 @@ DENG_HEADERS += \
     $$SRC/include/resource/colorpalette.h \
     $$SRC/include/resource/colorpalettes.h \
     $$SRC/include/resource/compositetexture.h \
+    $$SRC/include/resource/decompressedlumpcache.h \
     $$SRC/include/resource/font.h \
     $$SRC/include/resource/image.h \
     $$SRC/include/resource/lumpcache.h \
@@ -231,6 +232,7 @@ DENG_HEADERS += \
     $$SRC/include/uri.hh \
     $$SRC/include/world/dmuargs.h \
     $$SRC/include/world/blockmap.h \
+    $$SRC/include/world/bsp/bspcache.h \
     $$SRC/include/world/bsp/bsptreenode.h \
     $$SRC/include/world/bsp/convexsubspace.h \
     $$SRC/include/world/bsp/edgetip.h \
@@ -375,6 +377,7 @@ SOURCES += \
     $$SRC/src/resource/colorpalette.cpp \
     $$SRC/src/resource/colorpalettes.cpp \
     $$SRC/src/resource/compositetexture.cpp \
+    $$SRC/src/resource/decompressedlumpcache.cpp \
     $$SRC/src/resource/hq2x.cpp \
     $$SRC/src/resource/image.cpp \
     $$SRC/src/resource/material.cpp \
@@ -404,6 +407,7 @@ SOURCES += \
     $$SRC/src/world/api_map.cpp \
     $$SRC/src/world/api_mapedit.cpp \
     $$SRC/src/world/blockmap.cpp \
+    $$SRC/src/world/bsp/bspcache.cpp \
     $$SRC/src/world/bsp/convexsubspace.cpp \
     $$SRC/src/world/bsp/hplane.cpp \
     $$SRC/src/world/bsp/linesegment.cpp \
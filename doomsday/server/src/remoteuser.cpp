@@ -247,6 +247,14 @@ void RemoteUser::send(IByteArray const &data)
     }
 }
 
+void RemoteUser::send(EncodedMessage const &message)
+{
+    if(d->state != Disconnected && d->socket->isOpen())
+    {
+        d->socket->send(message);
+    }
+}
+
 void RemoteUser::handleIncomingPackets()
 {
     LOG_AS("RemoteUser");
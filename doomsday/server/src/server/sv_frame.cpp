@@ -85,6 +85,8 @@ static int lastTransmitTic = 0;
 void Sv_TransmitFrame(void)
 {
     int                 i, cTime, numInGame, pCount;
+    int                 recipients[DDMAXPLAYERS], numRecipients = 0;
+    pool_t*             recipientPools[DDMAXPLAYERS];
 
     // Obviously clients don't transmit anything.
     if(!allowFrames || isClient || Sys_IsShuttingDown())
@@ -153,7 +155,13 @@ void Sv_TransmitFrame(void)
             // decrease back to zero.
             //clients[i].updateCount--;
 
-            Sv_SendFrame(i);
+            // Does the send queue allow us to send this packet?
+            // Bandwidth rating is updated during the check.
+            if(Sv_CheckBandwidth(i))
+            {
+                recipientPools[numRecipients] = Sv_GetPool(i);
+                recipients[numRecipients++] = i;
+            }
         }
 #ifdef _DEBUG
         else
@@ -163,6 +171,15 @@ void Sv_TransmitFrame(void)
         }
 #endif
     }
+
+    // The priority queues of the clients need to be rebuilt before
+    // new frames can be sent.
+    Sv_RatePools(recipientPools, numRecipients);
+
+    for(i = 0; i < numRecipients; ++i)
+    {
+        Sv_SendFrame(recipients[i]);
+    }
 }
 
 /**
@@ -847,6 +864,8 @@ byte Sv_GetNewResendID(pool_t* pool)
 /**
  * Send a sv_frame packet to the specified player. The amount of data sent
  * depends on the player's bandwidth rating.
+ *
+ * @pre The player's pool has been rated (see Sv_RatePools()).
  */
 void Sv_SendFrame(int plrNum)
 {
@@ -859,19 +878,6 @@ void Sv_SendFrame(int plrNum)
     int                 endOffset = 0;
 #endif*/
 
-    // Does the send queue allow us to send this packet?
-    // Bandwidth rating is updated during the check.
-    if(!Sv_CheckBandwidth(plrNum))
-    {
-        // We cannot send anything at this time. This will only happen if
-        // the send queue has too many packets waiting to be sent.
-        return;
-    }
-
-    // The priority queue of the client needs to be rebuilt before
-    // a new frame can be sent.
-    Sv_RatePool(pool);
-
     // This will be a new set.
     pool->setDealer++;
 
@@ -890,9 +896,15 @@ void Sv_SendFrame(int plrNum)
     Writer_WriteFloat(msgWriter, gameTime);
 
     // Keep writing until the maximum size is reached.
-    while((delta = Sv_PoolQueueExtract(pool)) != NULL &&
-          (lastStart = Writer_Size(msgWriter)) < maxFrameSize)
+    while((delta = Sv_PoolQueueExtract(pool)) != NULL)
     {
+        if((lastStart = Writer_Size(msgWriter)) >= maxFrameSize)
+        {
+            // It will be sent in a later frame.
+            Sv_PoolQueueInsert(pool, delta);
+            break;
+        }
+
         oldResend = pool->resendDealer;
 
         // Is this going to be a resent?
@@ -922,6 +934,9 @@ void Sv_SendFrame(int plrNum)
             // Restore the resend dealer.
             if(oldResend)
                 pool->resendDealer = oldResend;
+
+            // It will be sent in a later frame.
+            Sv_PoolQueueInsert(pool, delta);
             break;
         }
 
@@ -946,6 +961,10 @@ if(delta->state == DELTA_UNACKED)
             delta->timeStamp = Sv_GetTimeStamp();
             delta->state = DELTA_UNACKED;
         }
+
+        // The delta is no longer queued; it will be queued again when it's
+        // time to resend it.
+        Sv_PoolDeltaChanged(pool, delta);
     }
 
     // Update the number of deltas included in the packet.
@@ -962,6 +981,11 @@ if(delta->state == DELTA_UNACKED)
 
     Net_SendBuffer(plrNum, 0);
 
+    // The counters cover the work done for this frame.
+    pool->counters.sent = deltaCount;
+    pool->lastCounters = pool->counters;
+    de::zap(pool->counters);
+
     // Once sent, the delta set can be discarded.
     Sv_AckDeltaSet(plrNum, pool->setDealer, 0);
 
@@ -24,6 +24,8 @@
 
 #include <math.h>
 #include <de/mathutil.h>
+#include <de/TaskPool>
+#include <QVector>
 
 #include "de_base.h"
 #include "de_console.h"
@@ -39,25 +41,231 @@ using namespace de;
 
 #define DEFAULT_DELTA_BASE_SCORE    10000
 
-#define REG_MOBJ_HASH_SIZE          1024
-#define REG_MOBJ_HASH_FUNCTION_MASK 0x3ff
+// Deltas grow more important with age, so unchanged deltas are rated again
+// after this many milliseconds.
+#define POOL_RATE_INTERVAL          100
 
 // Maximum difference in plane height where the absolute height doesn't
 // need to be sent.
 
 #define PLANE_SKIP_LIMIT            (40)
 
-typedef struct reg_mobj_s {
-    // Links to next and prev mobj in the register hash.
-    struct reg_mobj_s*  next, *prev;
-
-    // The tic when the mobj state was last sent.
-    dt_mobj_t           mo; // The state of the mobj.
-} reg_mobj_t;
-
-typedef struct mobjhash_s {
-    reg_mobj_t*         first, *last;
-} mobjhash_t;
+float Sv_GetMaxedMobjZ(const mobj_t* mo);
+
+/**
+ * State of mobjs stored column-wise in dense arrays indexed by mobj ID.
+ * Comparing two sets of mobj states is then a linear pass over each column,
+ * producing a mask of changed MDF_* flags for every ID.
+ */
+struct MobjColumns
+{
+    int size; ///< Number of slots (at least the highest used ID + 1).
+
+    QVector<byte>         present;
+    QVector<coord_t>      originX, originY, originZ;
+    QVector<coord_t>      floorZ, ceilingZ;
+    QVector<coord_t>      momX, momY, momZ;
+    QVector<angle_t>      angle;
+    QVector<int>          selector;
+    QVector<state_t *>    state;
+    QVector<coord_t>      radius, height;
+    QVector<int>          ddFlags, flags, flags2, flags3;
+    QVector<int>          health;
+    QVector<coord_t>      floorClip;
+    QVector<byte>         translucency;
+    QVector<short>        visTarget;
+    QVector<int>          type;
+    QVector<ddplayer_t *> dPlayer;
+    QVector<BspLeaf *>    bspLeaf;
+
+    MobjColumns() : size(0) {}
+
+    /**
+     * Makes room for at least @a minSize slots. New slots are empty.
+     */
+    void reserve(int minSize)
+    {
+        if(minSize <= size) return;
+
+        int const oldSize = size;
+        size = de::max(minSize, size + size / 2);
+
+        present.resize(size);
+        originX.resize(size); originY.resize(size); originZ.resize(size);
+        floorZ.resize(size); ceilingZ.resize(size);
+        momX.resize(size); momY.resize(size); momZ.resize(size);
+        angle.resize(size);
+        selector.resize(size);
+        state.resize(size);
+        radius.resize(size); height.resize(size);
+        ddFlags.resize(size); flags.resize(size); flags2.resize(size); flags3.resize(size);
+        health.resize(size);
+        floorClip.resize(size);
+        translucency.resize(size);
+        visTarget.resize(size);
+        type.resize(size);
+        dPlayer.resize(size);
+        bspLeaf.resize(size);
+
+        for(int i = oldSize; i < size; ++i)
+        {
+            remove(i);
+        }
+    }
+
+    bool has(thid_t id) const
+    {
+        return id < size && present[id];
+    }
+
+    /**
+     * Store the state of the mobj into its slot.
+     */
+    void store(mobj_t const *mo)
+    {
+        int const i = mo->thinker.id;
+        reserve(i + 1);
+
+        present[i]      = true;
+        originX[i]      = mo->origin[VX];
+        originY[i]      = mo->origin[VY];
+        originZ[i]      = Sv_GetMaxedMobjZ(mo);
+        floorZ[i]       = mo->floorZ;
+        ceilingZ[i]     = mo->ceilingZ;
+        momX[i]         = mo->mom[MX];
+        momY[i]         = mo->mom[MY];
+        momZ[i]         = mo->mom[MZ];
+        angle[i]        = mo->angle;
+        selector[i]     = mo->selector;
+        state[i]        = mo->state;
+        radius[i]       = mo->radius;
+        height[i]       = mo->height;
+        ddFlags[i]      = mo->ddFlags;
+        flags[i]        = mo->flags;
+        flags2[i]       = mo->flags2;
+        flags3[i]       = mo->flags3;
+        health[i]       = mo->health;
+        floorClip[i]    = mo->floorClip;
+        translucency[i] = mo->translucency;
+        visTarget[i]    = mo->visTarget;
+        type[i]         = mo->type;
+        dPlayer[i]      = mo->dPlayer;
+        bspLeaf[i]      = mo->bspLeaf;
+    }
+
+    /**
+     * Empties the slot. An empty slot is all zeroes, so comparing a mobj
+     * against it produces the same flags as comparing against a zeroed mobj.
+     */
+    void remove(int i)
+    {
+        present[i] = false;
+        originX[i] = originY[i] = originZ[i] = 0;
+        floorZ[i] = ceilingZ[i] = 0;
+        momX[i] = momY[i] = momZ[i] = 0;
+        angle[i] = 0;
+        selector[i] = 0;
+        state[i] = 0;
+        radius[i] = height[i] = 0;
+        ddFlags[i] = flags[i] = flags2[i] = flags3[i] = 0;
+        health[i] = 0;
+        floorClip[i] = 0;
+        translucency[i] = 0;
+        visTarget[i] = 0;
+        type[i] = 0;
+        dPlayer[i] = 0;
+        bspLeaf[i] = 0;
+    }
+
+    /**
+     * Reset the data of the registered mobj to reasonable defaults.
+     * In effect, forces a resend of the zeroed entries as deltas.
+     */
+    void reset(int i)
+    {
+        originX[i] = DDMINFLOAT;
+        originY[i] = DDMINFLOAT;
+        originZ[i] = -1000000;
+        angle[i] = 0;
+        type[i] = -1;
+        selector[i] = 0;
+        state[i] = 0;
+        radius[i] = -1;
+        height[i] = -1;
+        ddFlags[i] = 0;
+        flags[i] = 0;
+        flags2[i] = 0;
+        flags3[i] = 0;
+        health[i] = 0;
+        floorClip[i] = 0;
+        translucency[i] = 0;
+        visTarget[i] = 0;
+    }
+
+    /**
+     * Copies the registered state of a mobj into a dt_mobj_t.
+     */
+    void get(int i, dt_mobj_t *mo) const
+    {
+        de::zapPtr(mo);
+        mo->thinker.id   = i;
+        mo->type         = type[i];
+        mo->dPlayer      = dPlayer[i];
+        mo->bspLeaf      = bspLeaf[i];
+        mo->origin[VX]   = originX[i];
+        mo->origin[VY]   = originY[i];
+        mo->origin[VZ]   = originZ[i];
+        mo->floorZ       = floorZ[i];
+        mo->ceilingZ     = ceilingZ[i];
+        mo->mom[MX]      = momX[i];
+        mo->mom[MY]      = momY[i];
+        mo->mom[MZ]      = momZ[i];
+        mo->angle        = angle[i];
+        mo->selector     = selector[i];
+        mo->state        = state[i];
+        mo->radius       = radius[i];
+        mo->height       = height[i];
+        mo->ddFlags      = ddFlags[i];
+        mo->flags        = flags[i];
+        mo->flags2       = flags2[i];
+        mo->flags3       = flags3[i];
+        mo->health       = health[i];
+        mo->floorClip    = floorClip[i];
+        mo->translucency = translucency[i];
+        mo->visTarget    = visTarget[i];
+    }
+};
+
+/// Storage large enough for any type of delta.
+typedef union anydelta_u {
+    delta_t             delta;
+    mobjdelta_t         mobj;
+    playerdelta_t       player;
+    sectordelta_t       sector;
+    sidedelta_t         side;
+    polydelta_t         poly;
+    sounddelta_t        sound;
+} anydelta_t;
+
+/**
+ * Deltas produced by comparing the world against a register. The deltas are
+ * collected first and then added to each of the target pools separately, so
+ * that the pools can be updated concurrently.
+ */
+class DeltaBatch
+{
+public:
+    ~DeltaBatch();
+
+    /// Adds a copy of the delta to the batch.
+    void add(void const *deltaPtr);
+
+    int size() const { return _deltas.size(); }
+    delta_t *at(int index) const { return _deltas[index]; }
+
+private:
+    QVector<delta_t *> _deltas;
+};
 
 /**
  * One cregister_t holds the state of the entire world.
@@ -70,8 +278,8 @@ typedef struct cregister_s {
     // of the world.
     boolean             isInitial;
 
-    // The mobjs are stored in a hash for efficiency (ID is the key).
-    mobjhash_t          mobjs[REG_MOBJ_HASH_SIZE];
+    // The mobjs are stored column-wise (ID is the index).
+    MobjColumns*        mobjs;
 
     dt_player_t         ddPlayers[DDMAXPLAYERS];
     dt_sector_t*        sectors;
@@ -83,6 +291,9 @@ void            Sv_RegisterWorld(cregister_t* reg, boolean isInitial);
 void            Sv_NewDelta(void* deltaPtr, deltatype_t type, uint id);
 boolean         Sv_IsVoidDelta(const void* delta);
 void            Sv_PoolQueueClear(pool_t* pool);
+void            Sv_PoolQueueRemove(pool_t* pool, delta_t* delta);
+void            Sv_PoolQueueUpdate(pool_t* pool, delta_t* delta);
+boolean         Sv_RateDelta(void* deltaPtr, ownerinfo_t* info);
 void            Sv_GenerateNewDeltas(cregister_t* reg, int clientNumber,
                                      boolean doUpdate);
 
@@ -97,10 +308,6 @@ pool_t pools[DDMAXPLAYERS];
 
 static float deltaBaseScores[NUM_DELTA_TYPES];
 
-// Keep this zeroed out. Used if the register doesn't have data for
-// the mobj being compared.
-static dt_mobj_t dummyZeroMobj;
-
 /**
  * Called once for each map, from R_SetupMap(). Initialize the world
  * register and drain all pools.
@@ -146,6 +353,9 @@ void Sv_InitPools(void)
         pools[i].queueSize = 0;
         pools[i].allocatedSize = 0;
         pools[i].queue = NULL;
+        pools[i].rateFirst = pools[i].rateLast = NULL;
+        de::zap(pools[i].counters);
+        de::zap(pools[i].lastCounters);
 
         // This will be set to false when a frame is sent.
         pools[i].isFirst = true;
@@ -164,7 +374,11 @@ void Sv_InitPools(void)
  */
 void Sv_ShutdownPools(void)
 {
-    // Nothing to do.
+    delete worldRegister.mobjs;
+    worldRegister.mobjs = 0;
+
+    delete initialRegister.mobjs;
+    initialRegister.mobjs = 0;
 }
 
 /**
@@ -193,100 +407,6 @@ pool_t* Sv_GetPool(uint consoleNumber)
     return &pools[consoleNumber];
 }
 
-/**
- * The hash function for the register mobj hash.
- */
-uint Sv_RegisterHashFunction(thid_t id)
-{
-    return (uint) id & REG_MOBJ_HASH_FUNCTION_MASK;
-}
-
-/**
- * @return  Pointer to the register-mobj, if it already exists.
- */
-reg_mobj_t* Sv_RegisterFindMobj(cregister_t* reg, thid_t id)
-{
-    mobjhash_t*         hash = &reg->mobjs[Sv_RegisterHashFunction(id)];
-    reg_mobj_t*         iter;
-
-    // See if there already is a register-mobj for this id.
-    for(iter = hash->first; iter; iter = iter->next)
-    {
-        // Is this the one?
-        if(iter->mo.thinker.id == id)
-        {
-            return iter;
-        }
-    }
-
-    return NULL;
-}
-
-/**
- * Adds a new reg_mobj_t to the register's mobj hash.
- */
-reg_mobj_t* Sv_RegisterAddMobj(cregister_t* reg, thid_t id)
-{
-    mobjhash_t*         hash = &reg->mobjs[Sv_RegisterHashFunction(id)];
-    reg_mobj_t*         newRegMo;
-
-    // Try to find an existing register-mobj.
-    if((newRegMo = Sv_RegisterFindMobj(reg, id)) != NULL)
-    {
-        return newRegMo;
-    }
-
-    // Allocate the new register-mobj.
-    newRegMo = (reg_mobj_t *) Z_Calloc(sizeof(reg_mobj_t), PU_MAP, 0);
-
-    // Link it to the end of the hash list.
-    if(hash->last)
-    {
-        hash->last->next = newRegMo;
-        newRegMo->prev = hash->last;
-    }
-    hash->last = newRegMo;
-
-    if(!hash->first)
-    {
-        hash->first = newRegMo;
-    }
-
-    return newRegMo;
-}
-
-/**
- * Removes a reg_mobj_t from the register's mobj hash.
- */
-void Sv_RegisterRemoveMobj(cregister_t* reg, reg_mobj_t* regMo)
-{
-    mobjhash_t*         hash =
-        &reg->mobjs[Sv_RegisterHashFunction(regMo->mo.thinker.id)];
-
-    // Update the first and last links.
-    if(hash->last == regMo)
-    {
-        hash->last = regMo->prev;
-    }
-    if(hash->first == regMo)
-    {
-        hash->first = regMo->next;
-    }
-
-    // Link out of the list.
-    if(regMo->next)
-    {
-        regMo->next->prev = regMo->prev;
-    }
-    if(regMo->prev)
-    {
-        regMo->prev->next = regMo->next;
-    }
-
-    // Destroy the register-mobj.
-    Z_Free(regMo);
-}
-
 /**
  * @return              If the mobj is on the floor; @c MININT.
  *                      If the mobj is touching the ceiling; @c MAXINT.
@@ -344,28 +464,73 @@ void Sv_RegisterMobj(dt_mobj_t* reg, const mobj_t* mo)
 }
 
 /**
- * Reset the data of the registered mobj to reasonable defaults.
- * In effect, forces a resend of the zeroed entries as deltas.
+ * Current state of the world's mobjs, gathered before comparing it against
+ * a register.
+ */
+struct MobjSnapshot
+{
+    MobjColumns current;
+    QVector<mobj_t *> mobjs;    ///< Source of each slot, indexed by ID.
+    QVector<int> changes;       ///< Changed flags of each slot.
+};
+
+static MobjSnapshot mobjSnapshot;
+
+template <typename Type>
+static void Sv_MarkChanged(QVector<Type> const &registered, QVector<Type> const &current,
+                           int flag, int count, int *changes)
+{
+    Type const *r = registered.constData();
+    Type const *s = current.constData();
+
+    for(int i = 0; i < count; ++i)
+    {
+        changes[i] |= (r[i] != s[i])? flag : 0;
+    }
+}
+
+/**
+ * Compares all the slots of two mobj registers, column by column.
+ *
+ * @param reg      Registered (previous) state.
+ * @param cur      Current state.
+ * @param count    Number of slots to compare. Both must have at least this many.
+ * @param changes  The changed MDF_* flags of each slot are written here.
  */
-void Sv_RegisterResetMobj(dt_mobj_t* reg)
+static void Sv_CompareMobjColumns(MobjColumns const &reg, MobjColumns const &cur,
+                                  int count, int *changes)
 {
-    reg->origin[VX] = DDMINFLOAT;
-    reg->origin[VY] = DDMINFLOAT;
-    reg->origin[VZ] = -1000000;
-    reg->angle = 0;
-    reg->type = -1;
-    reg->selector = 0;
-    reg->state = 0;
-    reg->radius = -1;
-    reg->height = -1;
-    reg->ddFlags = 0;
-    reg->flags = 0;
-    reg->flags2 = 0;
-    reg->flags3 = 0;
-    reg->health = 0;
-    reg->floorClip = 0;
-    reg->translucency = 0;
-    reg->visTarget = 0;
+    int const *rdd = reg.ddFlags.constData();
+    int const *sdd = cur.ddFlags.constData();
+
+    memset(changes, 0, sizeof(*changes) * count);
+
+    Sv_MarkChanged(reg.originX,       cur.originX,       MDF_ORIGIN_X,       count, changes);
+    Sv_MarkChanged(reg.originY,       cur.originY,       MDF_ORIGIN_Y,       count, changes);
+    Sv_MarkChanged(reg.originZ,       cur.originZ,       MDF_ORIGIN_Z,       count, changes);
+    Sv_MarkChanged(reg.floorZ,        cur.floorZ,        MDF_ORIGIN_Z,       count, changes);
+    Sv_MarkChanged(reg.ceilingZ,      cur.ceilingZ,      MDF_ORIGIN_Z,       count, changes);
+    Sv_MarkChanged(reg.momX,          cur.momX,          MDF_MOM_X,          count, changes);
+    Sv_MarkChanged(reg.momY,          cur.momY,          MDF_MOM_Y,          count, changes);
+    Sv_MarkChanged(reg.momZ,          cur.momZ,          MDF_MOM_Z,          count, changes);
+    Sv_MarkChanged(reg.angle,         cur.angle,         MDF_ANGLE,          count, changes);
+    Sv_MarkChanged(reg.selector,      cur.selector,      MDF_SELECTOR,       count, changes);
+    Sv_MarkChanged(reg.translucency,  cur.translucency,  MDFC_TRANSLUCENCY,  count, changes);
+    Sv_MarkChanged(reg.visTarget,     cur.visTarget,     MDFC_FADETARGET,    count, changes);
+    Sv_MarkChanged(reg.type,          cur.type,          MDFC_TYPE,          count, changes);
+    Sv_MarkChanged(reg.radius,        cur.radius,        MDF_RADIUS,         count, changes);
+    Sv_MarkChanged(reg.height,        cur.height,        MDF_HEIGHT,         count, changes);
+    Sv_MarkChanged(reg.flags,         cur.flags,         MDF_FLAGS,          count, changes);
+    Sv_MarkChanged(reg.flags2,        cur.flags2,        MDF_FLAGS,          count, changes);
+    Sv_MarkChanged(reg.flags3,        cur.flags3,        MDF_FLAGS,          count, changes);
+    Sv_MarkChanged(reg.health,        cur.health,        MDF_HEALTH,         count, changes);
+    Sv_MarkChanged(reg.floorClip,     cur.floorClip,     MDF_FLOORCLIP,      count, changes);
+
+    // Only some of the Doomsday flags are sent.
+    for(int i = 0; i < count; ++i)
+    {
+        changes[i] |= ((rdd[i] ^ sdd[i]) & DDMF_PACK_MASK)? MDF_FLAGS : 0;
+    }
 }
 
 /**
@@ -493,95 +658,42 @@ void Sv_RegisterPoly(dt_poly_t *reg, uint number)
 }
 
 /**
- * @return  @c true if the result is not void.
+ * Determines the flags of a mobj delta, based on the changes found when the
+ * mobj columns were compared (see Sv_CompareMobjColumns()).
+ *
+ * @return  Delta flags, or zero if no delta should be generated.
  */
-boolean Sv_RegisterCompareMobj(cregister_t *reg, mobj_t const *s, mobjdelta_t *d)
+static int Sv_MobjDeltaFlags(MobjColumns const &reg, mobj_t const *s, int changes)
 {
-    int df;
-    reg_mobj_t *regMo = 0;
-    dt_mobj_t const *r = &dummyZeroMobj;
+    thid_t const id = s->thinker.id;
+    int df = changes;
 
-    if((regMo = Sv_RegisterFindMobj(reg, s->thinker.id)) != NULL)
-    {
-        // Use the registered data.
-        r = &regMo->mo;
-        df = 0;
-    }
-    else
+    if(!reg.has(id))
     {
         // This didn't exist in the register, so it's a new mobj.
-        df = MDFC_CREATE | MDF_EVERYTHING | MDFC_TYPE;
+        return df | MDFC_CREATE | MDF_EVERYTHING | MDFC_TYPE;
     }
 
-    if(r->origin[VX] != s->origin[VX])
-        df |= MDF_ORIGIN_X;
-    if(r->origin[VY] != s->origin[VY])
-        df |= MDF_ORIGIN_Y;
-    if(r->origin[VZ] != Sv_GetMaxedMobjZ(s) || r->floorZ != s->floorZ || r->ceilingZ != s->ceilingZ)
+    if((df & MDF_ORIGIN_Z) && s->origin[VZ] <= s->floorZ)
     {
-        df |= MDF_ORIGIN_Z;
-        if(!(df & MDFC_CREATE) && s->origin[VZ] <= s->floorZ)
-        {
-            // It is currently on the floor. The client will place it on its
-            // clientside floor and disregard the Z coordinate.
-            df |= MDFC_ON_FLOOR;
-        }
+        // It is currently on the floor. The client will place it on its
+        // clientside floor and disregard the Z coordinate.
+        df |= MDFC_ON_FLOOR;
     }
 
-    if(r->mom[MX] != s->mom[MX])
-        df |= MDF_MOM_X;
-    if(r->mom[MY] != s->mom[MY])
-        df |= MDF_MOM_Y;
-    if(r->mom[MZ] != s->mom[MZ])
-        df |= MDF_MOM_Z;
-
-    if(r->angle != s->angle)
-        df |= MDF_ANGLE;
-    if(r->selector != s->selector)
-        df |= MDF_SELECTOR;
-    if(r->translucency != s->translucency)
-        df |= MDFC_TRANSLUCENCY;
-    if(r->visTarget != s->visTarget)
-        df |= MDFC_FADETARGET;
-    if(r->type != s->type)
-        df |= MDFC_TYPE;
-
     // Mobj state sent periodically, if the sequence keeps changing.
-    if(regMo && !Def_SameStateSequence(s->state, r->state))
+    if(!Def_SameStateSequence(s->state, reg.state[id]))
     {
         df |= MDF_STATE;
 
         if(s->state == NULL)
         {
             // No valid comparison can be generated because the mobj is gone.
-            return false;
+            return 0;
         }
     }
 
-    if(r->radius != s->radius)
-        df |= MDF_RADIUS;
-    if(r->height != s->height)
-        df |= MDF_HEIGHT;
-    if((r->ddFlags & DDMF_PACK_MASK) != (s->ddFlags & DDMF_PACK_MASK) ||
-       r->flags != s->flags || r->flags2 != s->flags2 || r->flags3 != s->flags3)
-    {
-        df |= MDF_FLAGS;
-    }
-    if(r->health != s->health)
-        df |= MDF_HEALTH;
-    if(r->floorClip != s->floorClip)
-        df |= MDF_FLOORCLIP;
-
-    if(df)
-    {
-        // Init the delta with current data.
-        Sv_NewDelta(d, DT_MOBJ, s->thinker.id);
-        Sv_RegisterMobj(&d->mo, s);
-    }
-
-    d->delta.flags = df;
-
-    return !Sv_IsVoidDelta(d);
+    return df;
 }
 
 /**
@@ -943,9 +1055,13 @@ void Sv_RegisterWorld(cregister_t *reg, boolean isInitial)
 
     Map &map = App_World().map();
 
+    delete reg->mobjs;
     de::zapPtr(reg);
     reg->gametic = SECONDS_TO_TICKS(gameTime);
 
+    // Mobjs are registered when deltas are generated for them.
+    reg->mobjs = new MobjColumns;
+
     // Is this the initial state?
     reg->isInitial = isInitial;
 
@@ -986,7 +1102,10 @@ void Sv_UpdateOwnerInfo(pool_t *pool)
 {
     player_t *plr = &ddPlayers[pool->owner];
     ownerinfo_t *info = &pool->ownerInfo;
+    coord_t oldOrigin[3];
+    uint generation = info->generation;
 
+    V3d_Copy(oldOrigin, info->origin);
     de::zapPtr(info);
 
     // Pointer to the owner's pool.
@@ -1005,6 +1124,14 @@ void Sv_UpdateOwnerInfo(pool_t *pool)
     // ack time of the client. If an unacked delta is not acked within
     // the threshold, it'll be re-included in the ratings.
     info->ackThreshold = 0; //Net_GetAckThreshold(pool->owner);
+
+    // Scores calculated from the old origin are no longer valid.
+    if(!generation || oldOrigin[VX] != info->origin[VX] ||
+       oldOrigin[VY] != info->origin[VY] || oldOrigin[VZ] != info->origin[VZ])
+    {
+        generation++;
+    }
+    info->generation = generation;
 }
 
 /**
@@ -1105,12 +1232,11 @@ boolean Sv_IsSameDelta(void const *delta1, void const *delta2)
 }
 
 /**
- * Makes a copy of the delta.
+ * @return  Size of the delta in bytes.
  */
-void* Sv_CopyDelta(void* deltaPtr)
+static size_t Sv_DeltaSize(void const *deltaPtr)
 {
-    void*               newDelta;
-    delta_t*            delta = (delta_t *) deltaPtr;
+    delta_t const *     delta = (delta_t const *) deltaPtr;
     size_t              size =
         ( delta->type == DT_MOBJ ?         sizeof(mobjdelta_t)
         : delta->type == DT_PLAYER ?       sizeof(playerdelta_t)
@@ -1127,10 +1253,19 @@ void* Sv_CopyDelta(void* deltaPtr)
 
     if(size == 0)
     {
-        Con_Error("Sv_CopyDelta: Unknown delta type %i.\n", delta->type);
+        Con_Error("Sv_DeltaSize: Unknown delta type %i.\n", delta->type);
     }
+    return size;
+}
+
+/**
+ * Makes a copy of the delta.
+ */
+void* Sv_CopyDelta(void* deltaPtr)
+{
+    size_t              size = Sv_DeltaSize(deltaPtr);
+    void*               newDelta = Z_Malloc(size, PU_MAP, 0);
 
-    newDelta = Z_Malloc(size, PU_MAP, 0);
     memcpy(newDelta, deltaPtr, size);
     return newDelta;
 }
@@ -1624,6 +1759,52 @@ deltalink_t* Sv_PoolHash(pool_t* pool, int id)
     return &pool->hash[(uint) id & POOL_HASH_FUNCTION_MASK];
 }
 
+/**
+ * Links the delta out of the pool's rating list.
+ */
+static void Sv_RateListRemove(pool_t* pool, delta_t* delta)
+{
+    if(delta->rateNext)
+        delta->rateNext->ratePrev = delta->ratePrev;
+    else
+        pool->rateLast = delta->ratePrev;
+
+    if(delta->ratePrev)
+        delta->ratePrev->rateNext = delta->rateNext;
+    else
+        pool->rateFirst = delta->rateNext;
+
+    delta->rateNext = delta->ratePrev = NULL;
+}
+
+/**
+ * Links the delta to the head of the pool's rating list.
+ */
+static void Sv_RateListPrepend(pool_t* pool, delta_t* delta)
+{
+    delta->ratePrev = NULL;
+    delta->rateNext = pool->rateFirst;
+    if(pool->rateFirst)
+        pool->rateFirst->ratePrev = delta;
+    else
+        pool->rateLast = delta;
+    pool->rateFirst = delta;
+}
+
+/**
+ * Links the delta to the tail of the pool's rating list.
+ */
+static void Sv_RateListAppend(pool_t* pool, delta_t* delta)
+{
+    delta->rateNext = NULL;
+    delta->ratePrev = pool->rateLast;
+    if(pool->rateLast)
+        pool->rateLast->rateNext = delta;
+    else
+        pool->rateFirst = delta;
+    pool->rateLast = delta;
+}
+
 /**
  * The delta is removed from the pool's delta hash.
  */
@@ -1632,6 +1813,12 @@ void Sv_RemoveDelta(pool_t* pool, void* deltaPtr)
     delta_t*            delta = (delta_t *) deltaPtr;
     deltalink_t*        hash = Sv_PoolHash(pool, delta->id);
 
+    if(delta->queuePos)
+    {
+        Sv_PoolQueueRemove(pool, delta);
+    }
+    Sv_RateListRemove(pool, delta);
+
     // Update first and last links.
     if(hash->last == delta)
     {
@@ -1657,6 +1844,26 @@ void Sv_RemoveDelta(pool_t* pool, void* deltaPtr)
     Z_Free(delta);
 }
 
+/**
+ * Called when a delta is added to the pool, or its contents or state have
+ * changed. The score of the delta will be recalculated the next time the
+ * pool is rated.
+ */
+void Sv_PoolDeltaChanged(pool_t* pool, delta_t* delta)
+{
+    delta->ratedGeneration = 0;
+    delta->ratedTime = Sv_GetTimeStamp() - POOL_RATE_INTERVAL;
+
+    if(pool->rateFirst != delta)
+    {
+        if(delta->ratePrev || delta->rateNext)
+        {
+            Sv_RateListRemove(pool, delta);
+        }
+        Sv_RateListPrepend(pool, delta);
+    }
+}
+
 /**
  * Draining the pool means emptying it of all contents. (Doh?)
  */
@@ -1676,6 +1883,7 @@ void Sv_DrainPool(uint clientNumber)
     pool->resendDealer = 0;
 
     Sv_PoolQueueClear(pool);
+    pool->rateFirst = pool->rateLast = NULL;
 
     // Free all deltas stored in the hash.
     for(i = 0; i < POOL_HASH_SIZE; ++i)
@@ -1700,6 +1908,8 @@ void Sv_DrainPool(uint clientNumber)
     // Clear all the chains.
     de::zap(pool->hash);
     de::zap(pool->misHash);
+    de::zap(pool->counters);
+    de::zap(pool->lastCounters);
 }
 
 /**
@@ -1825,14 +2035,16 @@ int Sv_ExcludeDelta(pool_t* pool, const void* deltaPtr)
  * Deltas are unique only in the NEW state. There may be multiple UNACKED
  * deltas for the same entity.
  *
- * The contents of the delta must not be modified.
+ * The contents of the delta are not modified, so the same delta can be added
+ * to several pools concurrently.
  */
 void Sv_AddDelta(pool_t* pool, void* deltaPtr)
 {
     delta_t*            iter, *next = NULL, *existingNew = NULL;
     delta_t*            delta = (delta_t *) deltaPtr;
     deltalink_t*        hash = Sv_PoolHash(pool, delta->id);
-    int                 flags, originalFlags;
+    anydelta_t          excluded;
+    int                 flags;
 
     // Sometimes we can exclude a part of the data, if the client has no
     // use for it.
@@ -1844,9 +2056,13 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
         return;
     }
 
-    // Temporarily use the excluded flags.
-    originalFlags = delta->flags;
-    delta->flags = flags;
+    if(flags != delta->flags)
+    {
+        // The excluded flags only apply to this pool, so use a private copy.
+        memcpy(&excluded, delta, Sv_DeltaSize(delta));
+        excluded.delta.flags = flags;
+        delta = &excluded.delta;
+    }
 
     // While subtracting from old deltas, we'll look for a pointer to
     // an existing NEW delta.
@@ -1877,6 +2093,8 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
                     Sv_RemoveDelta(pool, iter);
                     continue;
                 }
+
+                Sv_PoolDeltaChanged(pool, iter);
             }
         }
     }
@@ -1884,12 +2102,18 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
     if(existingNew)
     {
         // Merge the new delta with the older NEW delta.
+        pool->counters.merged++;
+
         if(!Sv_MergeDelta(existingNew, delta))
         {
             // The deltas negated each other (Null -> Create).
             // The existing delta must be removed.
             Sv_RemoveDelta(pool, existingNew);
         }
+        else
+        {
+            Sv_PoolDeltaChanged(pool, existingNew);
+        }
     }
     else
     {
@@ -1908,12 +2132,9 @@ void Sv_AddDelta(pool_t* pool, void* deltaPtr)
         {
             hash->first = iter;
         }
-    }
 
-    // This delta may yet be added to other pools. They should use the
-    // original flags, not the ones we might've used (hackish: copying the
-    // whole delta is not really an option, though).
-    delta->flags = originalFlags;
+        Sv_PoolDeltaChanged(pool, iter);
+    }
 }
 
 /**
@@ -1960,11 +2181,10 @@ void Sv_PoolMobjRemoved(pool_t* pool, thid_t id)
 void Sv_MobjRemoved(thid_t id)
 {
     uint                i;
-    reg_mobj_t*         mo = Sv_RegisterFindMobj(&worldRegister, id);
 
-    if(mo)
+    if(worldRegister.mobjs && worldRegister.mobjs->has(id))
     {
-        Sv_RegisterRemoveMobj(&worldRegister, mo);
+        worldRegister.mobjs->remove(id);
 
         // We must remove all NEW deltas for this mobj from the pools.
         // One possibility: there are mobj deltas waiting in the pool,
@@ -2048,84 +2268,90 @@ int Sv_GetTargetPools(pool_t** targets, int clientsMask)
     return numTargets;
 }
 
+DeltaBatch::~DeltaBatch()
+{
+    for(int i = 0; i < _deltas.size(); ++i)
+    {
+        Z_Free(_deltas[i]);
+    }
+}
+
+void DeltaBatch::add(void const *deltaPtr)
+{
+    _deltas.append((delta_t *) Sv_CopyDelta(const_cast<void *>(deltaPtr)));
+}
+
+/**
+ * Adds a batch of deltas to one of the target pools. A pool is only accessed
+ * by one thread at a time, and the deltas are only read.
+ */
+struct PoolDeltaAdder
+{
+    pool_t **targets;
+    DeltaBatch const *batch;
+
+    PoolDeltaAdder(pool_t **targets, DeltaBatch const &batch)
+        : targets(targets), batch(&batch) {}
+
+    void operator () (int index) const
+    {
+        for(int i = 0; i < batch->size(); ++i)
+        {
+            Sv_AddDelta(targets[index], batch->at(i));
+        }
+    }
+};
+
 /**
  * Null deltas are generated for mobjs that have been destroyed.
  * The register's mobj hash is scanned to see which mobjs no longer exist.
  *
  * When updating, the destroyed mobjs are removed from the register.
  */
-void Sv_NewNullDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
+void Sv_NewNullDeltas(cregister_t *reg, boolean doUpdate, DeltaBatch &batch)
 {
-    int i;
-    mobjhash_t *hash;
-    reg_mobj_t *obj, *next = 0;
+    MobjColumns &mobjs = *reg->mobjs;
     mobjdelta_t null;
 
-    for(i = 0, hash = reg->mobjs; i < REG_MOBJ_HASH_SIZE; ++i, hash++)
+    for(int id = 0; id < mobjs.size; ++id)
     {
-        for(obj = hash->first; obj; obj = next)
-        {
-            // This reg_mobj_t might be removed.
-            next = obj->next;
+        if(!mobjs.present[id]) continue;
 
-            /// @todo Do not assume mobj is from the CURRENT map.
-            if(!App_World().map().thinkers().isUsedMobjId(obj->mo.thinker.id))
-            {
-                // This object no longer exists!
-                Sv_NewDelta(&null, DT_MOBJ, obj->mo.thinker.id);
-                null.delta.flags = MDFC_NULL;
-
-                // We need all the data for positioning.
-                memcpy(&null.mo, &obj->mo, sizeof(dt_mobj_t));
+        /// @todo Do not assume mobj is from the CURRENT map.
+        if(!App_World().map().thinkers().isUsedMobjId(id))
+        {
+            // This object no longer exists!
+            Sv_NewDelta(&null, DT_MOBJ, id);
 
-                Sv_AddDeltaToPools(&null, targets);
+            // We need all the data for positioning.
+            mobjs.get(id, &null.mo);
+            null.delta.flags = MDFC_NULL;
 
-                /*#ifdef _DEBUG
-                   Con_Printf("New null: %i, %s\n", obj->mo.thinker.id,
-                   defs.states[obj->mo.state - states].id);
-                   #endif */
+            batch.add(&null);
 
-                if(doUpdate)
-                {
-                    // Keep the register up to date.
-                    Sv_RegisterRemoveMobj(reg, obj);
-                }
+            if(doUpdate)
+            {
+                // Keep the register up to date.
+                mobjs.remove(id);
             }
         }
     }
 }
 
-typedef struct {
-    cregister_t*        reg;
-    boolean             doUpdate;
-    pool_t**            targets;
-} newmobjdeltaparams_t;
-
-static int newMobjDelta(thinker_t* th, void* context)
+static int gatherMobj(thinker_t *th, void *context)
 {
-    newmobjdeltaparams_t* params = (newmobjdeltaparams_t*) context;
-    mobj_t*             mo = (mobj_t *) th;
+    MobjSnapshot *snapshot = (MobjSnapshot *) context;
+    mobj_t *mo = (mobj_t *) th;
 
     // Some objects should not be processed.
     if(!Sv_IsMobjIgnored(mo))
     {
-        mobjdelta_t         delta;
-
-        // Compare to produce a delta.
-        if(Sv_RegisterCompareMobj(params->reg, mo, &delta))
+        snapshot->current.store(mo);
+        if(snapshot->mobjs.size() < snapshot->current.size)
         {
-            Sv_AddDeltaToPools(&delta, params->targets);
-
-            if(params->doUpdate)
-            {
-                reg_mobj_t*         obj;
-
-                // This'll add a new register-mobj if it doesn't
-                // already exist.
-                obj = Sv_RegisterAddMobj(params->reg, mo->thinker.id);
-                Sv_RegisterMobj(&obj->mo, mo);
-            }
+            snapshot->mobjs.resize(snapshot->current.size);
         }
+        snapshot->mobjs[mo->thinker.id] = mo;
     }
 
     return false; // Continue iteration.
@@ -2133,23 +2359,58 @@ static int newMobjDelta(thinker_t* th, void* context)
 
 /**
  * Mobj deltas are generated for all mobjs that have changed.
+ *
+ * The current state of the mobjs is first gathered into columns like the
+ * ones in the register, and the two are compared one column at a time.
  */
-void Sv_NewMobjDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
+void Sv_NewMobjDeltas(cregister_t *reg, boolean doUpdate, DeltaBatch &batch)
 {
-    newmobjdeltaparams_t parm;
+    MobjSnapshot &snap = mobjSnapshot;
+    MobjColumns &mobjs = *reg->mobjs;
 
-    parm.reg = reg;
-    parm.doUpdate = doUpdate;
-    parm.targets = targets;
+    // Gather the current state. The snapshot's slots are reused.
+    snap.mobjs.fill(0, snap.current.size);
+    snap.current.present.fill(false);
 
     App_World().map().thinkers().iterate(reinterpret_cast<thinkfunc_t>(gx.MobjThinker),
-                                         0x1 /*mobjs are public*/, newMobjDelta, &parm);
+                                         0x1 /*mobjs are public*/, gatherMobj, &snap);
+
+    // Only the slots up to the last gathered mobj need to be compared.
+    int count = snap.current.size;
+    while(count > 0 && !snap.mobjs[count - 1]) { count--; }
+
+    mobjs.reserve(count);
+    snap.changes.resize(count);
+    Sv_CompareMobjColumns(mobjs, snap.current, count, snap.changes.data());
+
+    mobjdelta_t delta;
+    for(int id = 0; id < count; ++id)
+    {
+        mobj_t const *mo = snap.mobjs[id];
+        if(!mo) continue;
+
+        int const df = Sv_MobjDeltaFlags(mobjs, mo, snap.changes[id]);
+        if(!df) continue;
+
+        // Init the delta with current data.
+        Sv_NewDelta(&delta, DT_MOBJ, id);
+        Sv_RegisterMobj(&delta.mo, mo);
+        delta.delta.flags = df;
+
+        batch.add(&delta);
+
+        if(doUpdate)
+        {
+            // This'll add a new register-mobj if it doesn't already exist.
+            mobjs.store(mo);
+        }
+    }
 }
 
 /**
  * Player deltas are generated for changed player data.
  */
-void Sv_NewPlayerDeltas(cregister_t* reg, boolean doUpdate, pool_t** targets)
+void Sv_NewPlayerDeltas(cregister_t* reg, boolean doUpdate, DeltaBatch &batch)
 {
     playerdelta_t player;
     uint i;
@@ -2167,15 +2428,15 @@ void Sv_NewPlayerDeltas(cregister_t* reg, boolean doUpdate, pool_t** targets)
             // flags).
             if(doUpdate && (player.delta.flags & PDF_MOBJ))
             {
-                reg_mobj_t* registered = Sv_RegisterFindMobj(reg, reg->ddPlayers[i].mobj);
+                thid_t const registered = reg->ddPlayers[i].mobj;
 
-                if(registered)
+                if(reg->mobjs->has(registered))
                 {
-                    Sv_RegisterResetMobj(&registered->mo);
+                    reg->mobjs->reset(registered);
                 }
             }
 
-            Sv_AddDeltaToPools(&player, targets);
+            batch.add(&player);
         }
 
         if(doUpdate)
@@ -2183,10 +2444,10 @@ void Sv_NewPlayerDeltas(cregister_t* reg, boolean doUpdate, pool_t** targets)
             Sv_RegisterPlayer(&reg->ddPlayers[i], i);
         }
 
+#if 0
         // What about forced deltas?
         if(Sv_IsPoolTargeted(&pools[i], targets))
         {
-#if 0
             if(ddPlayers[i].flags & DDPF_FIXANGLES)
             {
                 Sv_NewDelta(&player, DT_PLAYER, i);
@@ -2222,15 +2483,15 @@ void Sv_NewPlayerDeltas(cregister_t* reg, boolean doUpdate, pool_t** targets)
                 // Doing this once is enough.
                 ddPlayers[i].flags &= ~(DDPF_FIXORIGIN | DDPF_FIXMOM);
             }
-#endif
         }
+#endif
     }
 }
 
 /**
  * Sector deltas are generated for changed sectors.
  */
-void Sv_NewSectorDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
+void Sv_NewSectorDeltas(cregister_t *reg, boolean doUpdate, DeltaBatch &batch)
 {
     sectordelta_t delta;
 
@@ -2238,7 +2499,7 @@ void Sv_NewSectorDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
     {
         if(Sv_RegisterCompareSector(reg, i, &delta, doUpdate))
         {
-            Sv_AddDeltaToPools(&delta, targets);
+            batch.add(&delta);
         }
     }
 }
@@ -2248,7 +2509,7 @@ void Sv_NewSectorDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
  * Changes in sides (textures) are so rare that all sides need not be
  * checked on every tic.
  */
-void Sv_NewSideDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
+void Sv_NewSideDeltas(cregister_t *reg, boolean doUpdate, DeltaBatch &batch)
 {
     static uint numShifts = 2, shift = 0;
 
@@ -2275,7 +2536,7 @@ void Sv_NewSideDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
     {
         if(Sv_RegisterCompareSide(reg, i, &delta, doUpdate))
         {
-            Sv_AddDeltaToPools(&delta, targets);
+            batch.add(&delta);
         }
     }
 }
@@ -2283,7 +2544,7 @@ void Sv_NewSideDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
 /**
  * Poly deltas are generated for changed polyobjs.
  */
-void Sv_NewPolyDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
+void Sv_NewPolyDeltas(cregister_t *reg, boolean doUpdate, DeltaBatch &batch)
 {
     polydelta_t delta;
 
@@ -2294,7 +2555,7 @@ void Sv_NewPolyDeltas(cregister_t *reg, boolean doUpdate, pool_t **targets)
 #ifdef DENG_DEBUG
             VERBOSE( Con_Message("Sv_NewPolyDeltas: Change in %i", i) );
 #endif
-            Sv_AddDeltaToPools(&delta, targets);
+            batch.add(&delta);
         }
 
         if(doUpdate)
@@ -2429,9 +2690,11 @@ boolean Sv_IsFrameTarget(uint plrNum)
 void Sv_GenerateNewDeltas(cregister_t* reg, int clientNumber, boolean doUpdate)
 {
     pool_t* targets[DDMAXPLAYERS + 1], **pool;
+    DeltaBatch batch;
+    int numTargets;
 
     // Determine the target pools.
-    Sv_GetTargetPools(targets, (clientNumber < 0 ? 0xff : (1 << clientNumber)));
+    numTargets = Sv_GetTargetPools(targets, (clientNumber < 0 ? 0xff : (1 << clientNumber)));
 
     // Update the info of the pool owners.
     for(pool = targets; *pool; pool++)
@@ -2440,28 +2703,32 @@ void Sv_GenerateNewDeltas(cregister_t* reg, int clientNumber, boolean doUpdate)
     }
 
     // Generate null deltas (removed mobjs).
-    Sv_NewNullDeltas(reg, doUpdate, targets);
+    Sv_NewNullDeltas(reg, doUpdate, batch);
 
     // Generate mobj deltas.
-    Sv_NewMobjDeltas(reg, doUpdate, targets);
+    Sv_NewMobjDeltas(reg, doUpdate, batch);
 
     // Generate player deltas.
-    Sv_NewPlayerDeltas(reg, doUpdate, targets);
+    Sv_NewPlayerDeltas(reg, doUpdate, batch);
 
     // Generate sector deltas.
-    Sv_NewSectorDeltas(reg, doUpdate, targets);
+    Sv_NewSectorDeltas(reg, doUpdate, batch);
 
     // Generate side deltas.
-    Sv_NewSideDeltas(reg, doUpdate, targets);
+    Sv_NewSideDeltas(reg, doUpdate, batch);
 
     // Generate poly deltas.
-    Sv_NewPolyDeltas(reg, doUpdate, targets);
+    Sv_NewPolyDeltas(reg, doUpdate, batch);
 
     if(doUpdate)
     {
         // The register has now been updated to the current time.
         reg->gametic = SECONDS_TO_TICKS(gameTime);
     }
+
+    // The world only needs to be compared once; the rest of the work is
+    // specific to each pool.
+    TaskPool::parallelFor(0, numTargets, PoolDeltaAdder(targets, batch));
 }
 
 /**
@@ -2478,28 +2745,94 @@ void Sv_GenerateFrameDeltas(void)
  */
 void Sv_PoolQueueClear(pool_t* pool)
 {
+    int                 i;
+
+    for(i = 0; i < pool->queueSize; ++i)
+    {
+        pool->queue[i]->queuePos = 0;
+    }
     pool->queueSize = 0;
 }
 
 /**
- * Exchanges two elements in the queue.
+ * Places the delta in the queue at the given index.
+ */
+static void Sv_PoolQueueSet(pool_t* pool, int index, delta_t* delta)
+{
+    pool->queue[index] = delta;
+    delta->queuePos = index + 1;
+}
+
+/**
+ * Moves a queued delta towards the top of the heap until the correct place
+ * is found.
  */
-void Sv_PoolQueueExchange(pool_t* pool, int index1, int index2)
+static void Sv_PoolQueueRise(pool_t* pool, int i)
 {
-    delta_t *temp = pool->queue[index1];
+    delta_t*            delta = pool->queue[i];
+    int                 parent;
+
+    while(i > 0)
+    {
+        parent = HEAP_PARENT(i);
+
+        // Is it good now?
+        if(pool->queue[parent]->score >= delta->score)
+            break;
 
-    pool->queue[index1] = pool->queue[index2];
-    pool->queue[index2] = temp;
+        // Move the parent down.
+        Sv_PoolQueueSet(pool, i, pool->queue[parent]);
+        i = parent;
+    }
+
+    Sv_PoolQueueSet(pool, i, delta);
 }
 
 /**
- * Adds the delta to the priority queue. More memory is allocated for the
- * queue if necessary.
+ * Moves a queued delta towards the bottom of the heap until the correct
+ * place is found. This is O(log n).
  */
-void Sv_PoolQueueAdd(pool_t* pool, delta_t* delta)
+static void Sv_PoolQueueSink(pool_t* pool, int i)
 {
-    int                 i, parent;
+    delta_t*            delta = pool->queue[i];
+    int                 left, right, big;
+
+    for(;;)
+    {
+        left = HEAP_LEFT(i);
+        right = HEAP_RIGHT(i);
+        big = i;
+
+        // Which child is more important?
+        if(left < pool->queueSize &&
+           pool->queue[left]->score > delta->score)
+        {
+            big = left;
+        }
+        if(right < pool->queueSize &&
+           pool->queue[right]->score > (big == i? delta->score : pool->queue[big]->score))
+        {
+            big = right;
+        }
 
+        // Can we stop now?
+        if(big == i)
+            break;
+
+        // Move the child up and continue.
+        Sv_PoolQueueSet(pool, i, pool->queue[big]);
+        i = big;
+    }
+
+    Sv_PoolQueueSet(pool, i, delta);
+}
+
+/**
+ * Appends the delta to the end of the queue array without maintaining the
+ * heap order. More memory is allocated for the queue if necessary.
+ */
+static void Sv_PoolQueueAppend(pool_t* pool, delta_t* delta)
+{
     // Do we need more memory?
     if(pool->allocatedSize == pool->queueSize)
     {
@@ -2529,24 +2862,57 @@ void Sv_PoolQueueAdd(pool_t* pool, delta_t* delta)
         pool->queue = newQueue;
     }
 
-    // Add the new delta to the end of the queue array.
-    i = pool->queueSize;
-    pool->queue[i] = delta;
-    ++pool->queueSize;
+    Sv_PoolQueueSet(pool, pool->queueSize++, delta);
+}
 
-    // Rise in the heap until the correct place is found.
-    while(i > 0)
+/**
+ * Adds a delta to the queue. This is O(log n).
+ */
+void Sv_PoolQueueInsert(pool_t* pool, delta_t* delta)
+{
+    DENG_ASSERT(!delta->queuePos);
+
+    Sv_PoolQueueAppend(pool, delta);
+    Sv_PoolQueueRise(pool, pool->queueSize - 1);
+}
+
+/**
+ * Moves a queued delta to the correct place after its score has changed
+ * (in either direction).
+ */
+void Sv_PoolQueueUpdate(pool_t* pool, delta_t* delta)
+{
+    int                 i = delta->queuePos - 1;
+
+    DENG_ASSERT(i >= 0 && i < pool->queueSize && pool->queue[i] == delta);
+
+    if(i > 0 && pool->queue[HEAP_PARENT(i)]->score < delta->score)
     {
-        parent = HEAP_PARENT(i);
+        Sv_PoolQueueRise(pool, i);
+    }
+    else
+    {
+        Sv_PoolQueueSink(pool, i);
+    }
+}
 
-        // Is it good now?
-        if(pool->queue[parent]->score >= delta->score)
-            break;
+/**
+ * Removes a delta from the queue.
+ */
+void Sv_PoolQueueRemove(pool_t* pool, delta_t* delta)
+{
+    int                 i = delta->queuePos - 1;
+    delta_t*            last;
 
-        // Exchange with the parent.
-        Sv_PoolQueueExchange(pool, parent, i);
+    DENG_ASSERT(i >= 0 && i < pool->queueSize && pool->queue[i] == delta);
 
-        i = parent;
+    delta->queuePos = 0;
+    last = pool->queue[--pool->queueSize];
+    if(last != delta)
+    {
+        // The last one fills the gap.
+        Sv_PoolQueueSet(pool, i, last);
+        Sv_PoolQueueUpdate(pool, last);
     }
 }
 
@@ -2558,8 +2924,6 @@ void Sv_PoolQueueAdd(pool_t* pool, delta_t* delta)
 delta_t* Sv_PoolQueueExtract(pool_t* pool)
 {
     delta_t*            max;
-    int                 i, left, right, big;
-    boolean             isDone;
 
     if(!pool->queueSize)
     {
@@ -2569,45 +2933,7 @@ delta_t* Sv_PoolQueueExtract(pool_t* pool)
 
     // This is what we'll return.
     max = pool->queue[0];
-
-    // Remove the first element from the queue.
-    pool->queue[0] = pool->queue[--pool->queueSize];
-
-    // Heapify the heap. This is O(log n).
-    i = 0;
-    isDone = false;
-    while(!isDone)
-    {
-        left = HEAP_LEFT(i);
-        right = HEAP_RIGHT(i);
-        big = i;
-
-        // Which child is more important?
-        if(left < pool->queueSize &&
-           pool->queue[left]->score > pool->queue[i]->score)
-        {
-            big = left;
-        }
-        if(right < pool->queueSize &&
-           pool->queue[right]->score > pool->queue[big]->score)
-        {
-            big = right;
-        }
-
-        // Can we stop now?
-        if(big != i)
-        {
-            // Exchange and continue.
-            Sv_PoolQueueExchange(pool, i, big);
-            i = big;
-        }
-        else
-        {
-            // Heapifying is complete.
-            isDone = true;
-        }
-    }
-
+    Sv_PoolQueueRemove(pool, max);
     return max;
 }
 
@@ -2661,28 +2987,25 @@ Con_Printf("POSTPONE: Stop %i\n", delta->id);
 }
 
 /**
- * Calculate a priority score for the delta. A higher score indicates
- * greater importance.
- *
- * @return              @c true iff the delta should be included in the
- *                      queue.
+ * Determines if the delta's distance to the pool owner depends on the current
+ * state of the world rather than just the contents of the delta.
  */
-boolean Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
+static boolean Sv_IsMovingDelta(delta_t const* delta)
+{
+    return (delta->type == DT_PLAYER || delta->type == DT_SECTOR ||
+            delta->type == DT_POLY || delta->type == DT_MOBJ_SOUND ||
+            delta->type == DT_SECTOR_SOUND || delta->type == DT_POLY_SOUND);
+}
+
+/**
+ * Calculate the part of the priority score that does not depend on the age
+ * of the delta.
+ */
+static float Sv_DeltaBaseScore(delta_t const* delta, ownerinfo_t const* info)
 {
     float score, size;
     coord_t distance;
-    delta_t *delta = (delta_t *) deltaPtr;
     int df = delta->flags;
-    uint age = Sv_DeltaAge(delta);
-
-    // The importance doubles normally in 1 second.
-    float ageScoreDouble = 1.0f;
-
-    if(Sv_IsPostponedDelta(delta, info))
-    {
-        // This delta will not be considered at this time.
-        return false;
-    }
 
     // Calculate the distance to the delta's origin.
     // If no distance can be determined, it's 1.0.
@@ -2694,22 +3017,12 @@ boolean Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
     // What is the base score?
     score = deltaBaseScores[delta->type] / distance;
 
-    // It's very important to send sound deltas in time.
-    if(Sv_IsSoundDelta(delta))
-    {
-        // Score doubles very quickly.
-        ageScoreDouble = 1;
-    }
-
-    // Deltas become more important with age (milliseconds).
-    score *= 1 + age / (ageScoreDouble * 1000.0f);
-
     /// @todo Consider viewpoint speed and angle.
 
     // Priority bonuses based on the contents of the delta.
     if(delta->type == DT_MOBJ)
     {
-        const mobj_t* mo = &((mobjdelta_t *) delta)->mo;
+        const mobj_t* mo = &((mobjdelta_t const *) delta)->mo;
 
         // Seeing new mobjs is interesting.
         if(df & MDFC_CREATE)
@@ -2762,6 +3075,52 @@ boolean Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
             score *= 1.2f;
     }
 
+    return score;
+}
+
+/**
+ * Calculate a priority score for the delta. A higher score indicates
+ * greater importance.
+ *
+ * The base score is only recalculated if the delta or the pool owner's
+ * origin has changed since it was last calculated, or if the delta's origin
+ * may have moved.
+ *
+ * @return              @c true iff the delta should be included in the
+ *                      queue.
+ */
+boolean Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
+{
+    float score;
+    delta_t *delta = (delta_t *) deltaPtr;
+    uint age = Sv_DeltaAge(delta);
+
+    // The importance doubles normally in 1 second.
+    float ageScoreDouble = 1.0f;
+
+    if(Sv_IsPostponedDelta(delta, info))
+    {
+        // This delta will not be considered at this time.
+        return false;
+    }
+
+    if(delta->ratedGeneration != info->generation || Sv_IsMovingDelta(delta))
+    {
+        delta->baseScore = Sv_DeltaBaseScore(delta, info);
+        delta->ratedGeneration = info->generation;
+        info->pool->counters.rated++;
+    }
+
+    // It's very important to send sound deltas in time.
+    if(Sv_IsSoundDelta(delta))
+    {
+        // Score doubles very quickly.
+        ageScoreDouble = 1;
+    }
+
+    // Deltas become more important with age (milliseconds).
+    score = delta->baseScore * (1 + age / (ageScoreDouble * 1000.0f));
+
     // This is the final score. Only positive scores are accepted in
     // the frame (deltas with nonpositive scores as ignored).
     delta->score = score;
@@ -2769,9 +3128,10 @@ boolean Sv_RateDelta(void* deltaPtr, ownerinfo_t* info)
 }
 
 /**
- * Calculate a priority score for each delta and build the priority queue.
- * The most important deltas will be included in a frame packet.
- * A pool is rated after new deltas have been generated.
+ * Calculate priority scores for the deltas that have been added or changed,
+ * or were last rated over POOL_RATE_INTERVAL ago, and move them to their
+ * places in the priority queue. The most important deltas will be included
+ * in a frame packet. A pool is rated after new deltas have been generated.
  */
 void Sv_RatePool(pool_t* pool)
 {
@@ -2779,8 +3139,8 @@ void Sv_RatePool(pool_t* pool)
     player_t*           plr = &ddPlayers[pool->owner];
     //client_t*           client = &clients[pool->owner];
 #endif
+    uint const          now = Sv_GetTimeStamp();
     delta_t*            delta;
-    int                 i;
 
 #ifdef _DEBUG
     if(!plr->shared.mo)
@@ -2789,23 +3149,48 @@ void Sv_RatePool(pool_t* pool)
     }
 #endif
 
-    // Clear the queue.
-    Sv_PoolQueueClear(pool);
-
-    // We will rate all the deltas in the pool. After each delta
-    // has been rated, it's added to the priority queue.
-    for(i = 0; i < POOL_HASH_SIZE; ++i)
+    // The changed deltas are at the head of the rating list, followed by
+    // the ones rated longest ago. Rated deltas are moved to the tail.
+    while((delta = pool->rateFirst) != NULL &&
+          now - delta->ratedTime >= POOL_RATE_INTERVAL)
     {
-        for(delta = pool->hash[i].first; delta; delta = delta->next)
+        if(Sv_RateDelta(delta, &pool->ownerInfo))
         {
-            if(Sv_RateDelta(delta, &pool->ownerInfo))
-            {
-                Sv_PoolQueueAdd(pool, delta);
-            }
+            if(delta->queuePos)
+                Sv_PoolQueueUpdate(pool, delta);
+            else
+                Sv_PoolQueueInsert(pool, delta);
         }
+        else if(delta->queuePos)
+        {
+            // Postponed or worthless for now.
+            Sv_PoolQueueRemove(pool, delta);
+        }
+
+        delta->ratedTime = now;
+        Sv_RateListRemove(pool, delta);
+        Sv_RateListAppend(pool, delta);
     }
 }
 
+struct PoolRater
+{
+    pool_t **pools;
+
+    PoolRater(pool_t **pools) : pools(pools) {}
+
+    void operator () (int index) const
+    {
+        Sv_RatePool(pools[index]);
+    }
+};
+
+void Sv_RatePools(pool_t **pools, int count)
+{
+    // Each pool is rated independently of the others.
+    TaskPool::parallelFor(0, count, PoolRater(pools));
+}
+
 /**
  * Do special things that need to be done when the delta has been acked.
  */
@@ -62,6 +62,45 @@ int main(int argc, char **argv)
         
         Reader(b) >> rec2;        
         LOG_MSG("After being deserialized:\n") << rec2;
+
+        // Member lookup by key.
+        Record::Key const helloKey = Record::key("hello");
+        Record::Key const upperKey = Record::key("Hello");
+        Record::Key const absentKey = Record::key("absent");
+        DENG2_ASSERT(helloKey != 0);
+        DENG2_ASSERT(Record::key("hello") == helloKey);
+        Record::releaseKey("hello");
+        DENG2_ASSERT(upperKey != helloKey); // Names are case sensitive.
+        DENG2_ASSERT(rec.findMember(helloKey, "hello") == &rec["hello"]);
+        DENG2_ASSERT(rec.findMember(helloKey, "hello") == &rec["hello"]); // Indexed.
+        DENG2_ASSERT(rec2.findMember(helloKey, "hello") == &rec2["hello"]);
+        DENG2_ASSERT(!rec.findMember(absentKey, "absent"));
+        DENG2_ASSERT(!rec.findMember(upperKey, "Hello"));
+
+        // The membership stamp changes when members are added or removed.
+        duint32 const stamp = rec.membershipStamp();
+        DENG2_ASSERT(rec2.membershipStamp() != stamp);
+        rec.add(new Variable("absent", new NumberValue(3)));
+        duint32 const addedStamp = rec.membershipStamp();
+        DENG2_ASSERT(addedStamp != stamp);
+        DENG2_ASSERT(rec.findMember(absentKey, "absent") == &rec["absent"]);
+
+        // Released keys are not reused for other names.
+        Record::releaseKey("absent");
+        Record::Key const otherKey = Record::key("other");
+        DENG2_ASSERT(otherKey != absentKey);
+        DENG2_ASSERT(!rec.findMember(otherKey, "other"));
+        Record::releaseKey("other");
+
+        delete rec.remove(rec["hello"]);
+        DENG2_ASSERT(rec.membershipStamp() != addedStamp);
+        DENG2_ASSERT(rec.membershipStamp() != stamp);
+        DENG2_ASSERT(!rec.findMember(helloKey, "hello"));
+        DENG2_ASSERT(!rec.hasMember("hello"));
+
+        Record::releaseKey("Hello");
+        Record::releaseKey("hello");
+        LOG_MSG("After removing \"hello\":\n") << rec;
     }
     catch(Error const &err)
     {
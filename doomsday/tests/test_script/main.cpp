@@ -22,6 +22,8 @@
 #include <de/Script>
 #include <de/FS>
 #include <de/Process>
+#include <de/Record>
+#include <de/NumberValue>
 #include <QDebug>
 
 using namespace de;
@@ -42,6 +44,33 @@ int main(int argc, char **argv)
 
         LOG_MSG("------------------------------------------------------------------------------");
         LOG_MSG("Final result value is: ") << proc.context().evaluator().result().asText();
+
+        // Repeated name lookups are cached until the namespace's membership changes.
+        Script lookup("b = a");
+        Process lookupProc;
+        Record &ns = lookupProc.globals();
+        ns.addNumber("a", 1);
+        for(int i = 0; i < 2; ++i)
+        {
+            lookupProc.run(lookup);
+            lookupProc.execute();
+            DENG2_ASSERT(ns["b"].value().asNumber() == 1);
+        }
+
+        // Re-adding the member must not leave the old variable in the cache.
+        delete ns.remove(ns["a"]);
+        ns.addNumber("a", 2);
+        lookupProc.run(lookup);
+        lookupProc.execute();
+        DENG2_ASSERT(ns["b"].value().asNumber() == 2);
+
+        // After removal the name is no longer found and the assignment fails.
+        delete ns.remove(ns["a"]);
+        ns["b"].set(NumberValue(0));
+        lookupProc.run(lookup);
+        lookupProc.execute();
+        DENG2_ASSERT(ns["b"].value().asNumber() == 0);
+        LOG_MSG("Name lookup cache invalidation is OK.");
     }
     catch(Error const &err)
     {
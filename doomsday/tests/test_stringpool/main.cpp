@@ -101,6 +101,25 @@ int main(int, char **)
 
         p.clear();
         DENG2_ASSERT(p.empty());
+
+        // Case sensitivity.
+        StringPool cs(Qt::CaseSensitive);
+        StringPool::Id const lower = cs.intern("a");
+        StringPool::Id const upper = cs.intern("A");
+        DENG2_ASSERT(lower != upper);
+        DENG2_ASSERT(cs.size() == 2);
+        DENG2_ASSERT(cs.intern("a") == lower);
+        DENG2_ASSERT(!cs.string(upper).compare("A"));
+        DENG2_ASSERT(!cs.isInterned("b"));
+        cs.remove("A");
+        DENG2_ASSERT(cs.isInterned("a") == lower);
+        DENG2_ASSERT(!cs.isInterned("A"));
+
+        // The default is still case insensitive.
+        StringPool ci;
+        DENG2_ASSERT(ci.intern("a") == ci.intern("A"));
+        DENG2_ASSERT(ci.size() == 1);
+        qDebug() << "Case-sensitive ids:" << lower << upper;
     }
     catch(Error const &err)
     {
@@ -0,0 +1,103 @@
+/*
+ * The Doomsday Engine Project
+ *
+ * Copyright (c) 2013 Jaakko Keränen <jaakko.keranen@iki.fi>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <de/Error>
+#include <de/Task>
+#include <de/TaskPool>
+#include <QAtomicInt>
+#include <QVector>
+#include <QDebug>
+
+using namespace de;
+
+static QAtomicInt counter;
+
+class CountTask : public Task
+{
+public:
+    CountTask(int depth = 0) : _depth(depth) {}
+
+    void runTask()
+    {
+        counter.ref();
+
+        // Tasks started from a task go to the worker's own deque.
+        if(_depth > 0)
+        {
+            TaskPool nested;
+            for(int i = 0; i < 4; ++i)
+            {
+                nested.start(new CountTask(_depth - 1), TaskPool::MediumPriority);
+            }
+            nested.waitForDone();
+        }
+    }
+
+private:
+    int _depth;
+};
+
+struct Square
+{
+    QVector<int> *results;
+    Square(QVector<int> &r) : results(&r) {}
+    void operator () (int i) const { (*results)[i] = i * i; }
+};
+
+int main(int, char **)
+{
+    try
+    {
+        TaskPool pool;
+        for(int i = 0; i < 100; ++i)
+        {
+            pool.start(new CountTask, TaskPool::Priority(i % 3));
+        }
+        pool.waitForDone();
+        qDebug() << "Flat tasks run:" << counter.fetchAndAddRelaxed(0);
+        DENG2_ASSERT(counter.fetchAndAddRelaxed(0) == 100);
+        DENG2_ASSERT(pool.isDone());
+
+        // 1 + 4 + 16 + 64 tasks.
+        counter.fetchAndStoreRelaxed(0);
+        pool.start(new CountTask(3), TaskPool::HighPriority);
+        pool.waitForDone();
+        qDebug() << "Nested tasks run:" << counter.fetchAndAddRelaxed(0);
+        DENG2_ASSERT(counter.fetchAndAddRelaxed(0) == 85);
+
+        QVector<int> results(10000);
+        TaskPool::parallelFor(0, results.size(), Square(results), 64);
+        for(int i = 0; i < results.size(); ++i)
+        {
+            DENG2_ASSERT(results[i] == i * i);
+        }
+        qDebug() << "parallelFor last result:" << results.last();
+
+        TaskPool::Counters const c = TaskPool::counters();
+        qDebug() << "Workers:" << c.workerCount << "Queued:" << c.queuedTasks
+                 << "Run:" << c.tasksRun << "Stolen:" << c.tasksStolen;
+    }
+    catch(Error const &err)
+    {
+        qWarning() << err.asText() << "\n";
+    }
+
+    qDebug() << "Exiting main()...\n";
+    return 0;
+}
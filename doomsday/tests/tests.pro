@@ -15,5 +15,6 @@ deng_tests: SUBDIRS += \
     test_script \
     test_string \
     test_stringpool \
+    test_taskpool \
     test_vectors
     #basiclink